@@ -0,0 +1,190 @@
+#ifndef __BENCH_COMMON_HXX__
+#define __BENCH_COMMON_HXX__
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+
+#ifndef DATA_STRUCT_BENCH_MAX_SIZE
+#define DATA_STRUCT_BENCH_MAX_SIZE 1000000
+#endif
+
+
+// Namespace containing the pieces shared by every benchmark of the suite
+namespace bench
+{
+    /**
+    * @brief Element of a fixed size, ordered by its leading key.
+    * @details The padding makes the element size a benchmark dimension: it changes how
+    *          many nodes fit in a cache line and how much every copy costs.
+    * @tparam Size The size of the element in bytes.
+    */
+    template <std::size_t Size>
+    struct payload final
+    {
+        static_assert(Size >= sizeof(std::uint64_t), "payload must be able to hold its key");
+
+        constexpr payload() noexcept = default;
+
+        constexpr payload(std::uint64_t key) noexcept : m_key{key} {}
+
+        friend constexpr auto operator<=>(const payload &lhs, const payload &rhs) noexcept
+        {
+            return (lhs.m_key <=> rhs.m_key);
+        }
+
+        friend constexpr auto operator==(const payload &lhs, const payload &rhs) noexcept -> bool
+        {
+            return (lhs.m_key == rhs.m_key);
+        }
+
+        std::uint64_t m_key{};
+        std::array<std::byte, Size - sizeof(std::uint64_t)> m_padding{};
+    };
+
+    /**
+    * @brief Distribution the benchmarked keys are drawn from.
+    */
+    enum class distribution
+    {
+        random,  // Uniform 64-bit keys
+        sorted,  // 0, 1, 2, ... : the worst case for an unbalanced tree
+        zipfian  // Skewed towards a few hot keys, with many duplicates
+    };
+
+    [[nodiscard]] constexpr auto to_string(distribution dist) noexcept -> std::string_view
+    {
+        switch (dist)
+        {
+        case distribution::random:
+            return "random";
+        case distribution::sorted:
+            return "sorted";
+        case distribution::zipfian:
+            return "zipfian";
+        }
+        return "unknown";
+    }
+
+    /**
+    * @brief Zipfian generator over the ranks [0, count).
+    * @details The rejection-free method of Gray et al. ("Quickly generating billion-record
+    *          synthetic databases"), as used by YCSB: O(count) setup, O(1) per draw.
+    */
+    class zipfian_generator final
+    {
+    public:
+        explicit zipfian_generator(std::uint64_t count, double theta = 0.99) noexcept
+            : m_count{count}, m_theta{theta}
+        {
+            for (std::uint64_t rank = 1UL; rank <= count; ++rank)
+                this->m_zeta_n += 1.0 / std::pow(static_cast<double>(rank), theta);
+
+            const double zeta_2 = 1.0 + (1.0 / std::pow(2.0, theta));
+
+            this->m_alpha = 1.0 / (1.0 - theta);
+            this->m_eta = (1.0 - std::pow(2.0 / static_cast<double>(count), 1.0 - theta)) /
+                          (1.0 - (zeta_2 / this->m_zeta_n));
+        }
+
+        template <class Engine>
+        [[nodiscard]] auto operator()(Engine &engine) noexcept -> std::uint64_t
+        {
+            const double u = std::uniform_real_distribution<double>{0.0, 1.0}(engine);
+            const double uz = u * this->m_zeta_n;
+
+            if (uz < 1.0)
+                return 0UL;
+
+            if (uz < 1.0 + std::pow(0.5, this->m_theta))
+                return 1UL;
+
+            const auto rank = static_cast<std::uint64_t>(
+                static_cast<double>(this->m_count) * std::pow((this->m_eta * u) - this->m_eta + 1.0, this->m_alpha));
+
+            return std::min(rank, this->m_count - 1UL);
+        }
+
+    private:
+        std::uint64_t m_count;
+        double m_theta;
+        double m_zeta_n{0.0};
+        double m_alpha{0.0};
+        double m_eta{0.0};
+    };
+
+    /**
+    * @brief Draws `count` keys from a distribution.
+    * @details Zipfian ranks are scrambled by an odd multiplier, so the hot keys are spread
+    *          over the key space instead of all being the smallest ones.
+    */
+    [[nodiscard]] inline auto make_keys(distribution dist, std::size_t count, std::uint64_t seed = 42UL)
+        -> std::vector<std::uint64_t>
+    {
+        std::vector<std::uint64_t> keys(count);
+        std::mt19937_64 engine{seed};
+
+        switch (dist)
+        {
+        case distribution::random:
+            std::ranges::generate(keys, engine);
+            break;
+        case distribution::sorted:
+            for (std::size_t index = 0UL; index < count; ++index)
+                keys[index] = index;
+            break;
+        case distribution::zipfian:
+        {
+            zipfian_generator zipf{count};
+
+            for (auto &key : keys)
+                key = zipf(engine) * 0x9E3779B97F4A7C15UL;
+            break;
+        }
+        }
+        return keys;
+    }
+
+    /**
+    * @brief Returns the keys in a random order, e.g. to look up or remove what was inserted.
+    */
+    [[nodiscard]] inline auto shuffled(std::vector<std::uint64_t> keys, std::uint64_t seed = 7UL)
+        -> std::vector<std::uint64_t>
+    {
+        std::ranges::shuffle(keys, std::mt19937_64{seed});
+
+        return keys;
+    }
+
+    /**
+    * @brief Applies the container sizes of the suite: powers of ten from 1K to 100M,
+    *        capped by DATA_STRUCT_BENCH_MAX_SIZE.
+    */
+    inline void apply_sizes(benchmark::internal::Benchmark *bm)
+    {
+        for (std::int64_t size = 1'000; size <= 100'000'000; size *= 10)
+        {
+            if (size <= DATA_STRUCT_BENCH_MAX_SIZE)
+                bm->Arg(size);
+        }
+        bm->Unit(benchmark::kMicrosecond);
+    }
+
+    // Register the sequence container benchmarks (sequence_bench.cpp)
+    void register_sequence_benchmarks();
+
+    // Register the search tree benchmarks (tree_bench.cpp)
+    void register_tree_benchmarks();
+}
+
+#endif
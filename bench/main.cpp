@@ -0,0 +1,19 @@
+#include "bench_common.h"
+
+
+// Entry point of data_struct_bench: registers every suite, then hands over to Google Benchmark
+int main(int argc, char **argv)
+{
+    bench::register_sequence_benchmarks();
+    bench::register_tree_benchmarks();
+
+    benchmark::Initialize(&argc, argv);
+
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
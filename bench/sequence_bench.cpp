@@ -0,0 +1,189 @@
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <optional>
+#include <queue>
+#include <stack>
+#include <string>
+
+#include "bench_common.h"
+
+#include "forward_list.h"
+#include "list.h"
+#include "queue.h"
+#include "stack.h"
+
+
+namespace bench
+{
+namespace
+{
+    // Adapters giving every container of a family the same push/pop vocabulary
+
+    // LIFO: stack and std::stack
+    struct lifo_ops final
+    {
+        static void push(auto &container, const auto &value) { container.push(value); }
+        static void pop(auto &container) { container.pop(); }
+    };
+
+    // FIFO: queue (push_back/pop_front) and std::queue (push/pop)
+    struct fifo_ops final
+    {
+        template <class Type>
+        static void push(::queue<Type> &container, const Type &value) { container.push_back(value); }
+
+        template <class Type>
+        static void pop(::queue<Type> &container) { container.pop_front(); }
+
+        template <class Type>
+        static void push(std::queue<Type> &container, const Type &value) { container.push(value); }
+
+        template <class Type>
+        static void pop(std::queue<Type> &container) { container.pop(); }
+    };
+
+    // Doubly linked lists: appended at the back, consumed from the front
+    struct list_ops final
+    {
+        static void push(auto &container, const auto &value) { container.push_back(value); }
+        static void pop(auto &container) { container.pop_front(); }
+    };
+
+    // Singly linked lists: everything happens at the front
+    struct forward_list_ops final
+    {
+        static void push(auto &container, const auto &value) { container.push_front(value); }
+        static void pop(auto &container) { container.pop_front(); }
+    };
+
+    /**
+    * @brief Pushes `size` elements into an empty container; teardown is not timed.
+    */
+    template <class Container, class Ops>
+    void push_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Container::value_type;
+
+        const auto size = static_cast<std::size_t>(state.range(0));
+        const value_type value{size};
+
+        for (auto _ : state)
+        {
+            std::optional<Container> container{std::in_place};
+
+            for (std::size_t index = 0UL; index < size; ++index)
+                Ops::push(*container, value);
+
+            benchmark::DoNotOptimize(*container);
+
+            state.PauseTiming();
+            container.reset();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Pops `size` elements until the container is empty; filling it is not timed.
+    */
+    template <class Container, class Ops>
+    void pop_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Container::value_type;
+
+        const auto size = static_cast<std::size_t>(state.range(0));
+        const value_type value{size};
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            Container container;
+
+            for (std::size_t index = 0UL; index < size; ++index)
+                Ops::push(container, value);
+            state.ResumeTiming();
+
+            for (std::size_t index = 0UL; index < size; ++index)
+                Ops::pop(container);
+
+            benchmark::DoNotOptimize(container);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Reads every element of a filled container, in iteration order.
+    */
+    template <class Container, class Ops>
+    void iterate_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Container::value_type;
+
+        const auto size = static_cast<std::size_t>(state.range(0));
+
+        Container container;
+
+        for (std::size_t index = 0UL; index < size; ++index)
+            Ops::push(container, value_type{index});
+
+        for (auto _ : state)
+        {
+            std::uint64_t sum = 0UL;
+
+            for (const auto &element : container)
+                sum += element.m_key;
+
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Registers push/pop (and iterate when `Iterable`) for one container type.
+    */
+    template <class Container, class Ops, bool Iterable>
+    void register_container(const std::string &name)
+    {
+        bench::apply_sizes(benchmark::RegisterBenchmark((name + "/push").c_str(), push_benchmark<Container, Ops>));
+        bench::apply_sizes(benchmark::RegisterBenchmark((name + "/pop").c_str(), pop_benchmark<Container, Ops>));
+
+        if constexpr (Iterable)
+        {
+            bench::apply_sizes(benchmark::RegisterBenchmark((name + "/iterate").c_str(), iterate_benchmark<Container, Ops>));
+        }
+    }
+
+    /**
+    * @brief Registers every sequence container, next to its std:: baseline, for one element size.
+    * @details stack and queue are adaptors without iterators (like their std:: counterparts),
+    *          so only the lists are iterated.
+    */
+    template <std::size_t Size>
+    void register_element_size()
+    {
+        using element = payload<Size>;
+
+        const auto suffix = "<" + std::to_string(Size) + "B>";
+
+        register_container<::stack<element>, lifo_ops, false>("stack" + suffix);
+        register_container<std::stack<element>, lifo_ops, false>("std::stack" + suffix);
+
+        register_container<::queue<element>, fifo_ops, false>("queue" + suffix);
+        register_container<std::queue<element>, fifo_ops, false>("std::queue" + suffix);
+
+        register_container<::list<element>, list_ops, true>("list" + suffix);
+        register_container<std::list<element>, list_ops, true>("std::list" + suffix);
+
+        register_container<::forward_list<element>, forward_list_ops, true>("forward_list" + suffix);
+        register_container<std::forward_list<element>, forward_list_ops, true>("std::forward_list" + suffix);
+    }
+}
+
+    void register_sequence_benchmarks()
+    {
+        register_element_size<8UL>();
+        register_element_size<64UL>();
+        register_element_size<256UL>();
+    }
+}
@@ -0,0 +1,362 @@
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+
+#include "bs_tree.h"
+#include "bs_tree_view.h"
+#include "concurrent_bs_tree.h"
+
+
+namespace bench
+{
+namespace
+{
+    // The trees under test; duplicates are kept, so std::multiset is the baseline
+    template <class Type>
+    using avl_tree = binary_search_tree<Type, std::allocator<Type>, avl_policy>;
+
+    template <class Type>
+    using plain_tree = binary_search_tree<Type, std::allocator<Type>, unbalanced_policy>;
+
+    // The usual way to share a tree between threads: readers still write the lock's cache line
+    template <class Type>
+    struct locked_tree final
+    {
+        using value_type = Type;
+
+        void insert(const Type &key)
+        {
+            std::unique_lock lock{this->m_lock};
+            this->m_tree.insert(key);
+        }
+
+        void remove(const Type &key)
+        {
+            std::unique_lock lock{this->m_lock};
+            this->m_tree.remove(key);
+        }
+
+        auto search(const Type &key) const -> bool
+        {
+            std::shared_lock lock{this->m_lock};
+            return this->m_tree.search(key).has_value();
+        }
+
+        mutable std::shared_mutex m_lock;
+        avl_tree<Type> m_tree;
+    };
+
+    template <class Type>
+    using concurrent_tree = concurrent_binary_search_tree<Type>;
+
+    // Adapters giving the trees and std::multiset the same insert/search/remove vocabulary
+
+    template <class Tree, class Type>
+    auto search(const Tree &tree, const Type &key) -> bool { return tree.search(key).has_value(); }
+
+    template <class Type>
+    auto search(const std::multiset<Type> &tree, const Type &key) -> bool { return tree.contains(key); }
+
+    template <class Type>
+    auto search(const locked_tree<Type> &tree, const Type &key) -> bool { return tree.search(key); }
+
+    template <class Type>
+    auto search(const concurrent_tree<Type> &tree, const Type &key) -> bool { return tree.contains(key); }
+
+    template <class Tree, class Type>
+    void remove(Tree &tree, const Type &key) { tree.remove(key); }
+
+    template <class Type>
+    void remove(std::multiset<Type> &tree, const Type &key)
+    {
+        if (auto position = tree.find(key); position != tree.end())
+            tree.erase(position);
+    }
+
+    /**
+    * @brief Inserts `size` keys drawn from `Dist` into an empty tree; teardown is not timed.
+    */
+    template <class Tree, distribution Dist>
+    void insert_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Tree::value_type;
+
+        const auto keys = bench::make_keys(Dist, static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            std::optional<Tree> tree{std::in_place};
+
+            for (const auto key : keys)
+                tree->insert(value_type{key});
+
+            benchmark::DoNotOptimize(*tree);
+
+            state.PauseTiming();
+            tree.reset();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Looks every inserted key up, in random order.
+    */
+    template <class Tree, distribution Dist>
+    void search_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Tree::value_type;
+
+        const auto keys = bench::make_keys(Dist, static_cast<std::size_t>(state.range(0)));
+        const auto lookups = bench::shuffled(keys);
+
+        Tree tree;
+
+        for (const auto key : keys)
+            tree.insert(value_type{key});
+
+        for (auto _ : state)
+        {
+            std::size_t found = 0UL;
+
+            for (const auto key : lookups)
+                found += search(tree, value_type{key});
+
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Looks every inserted key up, in random order, through the batched search,
+    *        which interleaves several descents to overlap their cache misses.
+    */
+    template <class Tree, distribution Dist>
+    void search_batch_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Tree::value_type;
+
+        const auto keys = bench::make_keys(Dist, static_cast<std::size_t>(state.range(0)));
+        const auto shuffled = bench::shuffled(keys);
+        const std::vector<value_type> lookups(shuffled.begin(), shuffled.end());
+
+        std::vector<std::optional<std::reference_wrapper<const value_type>>> results(lookups.size());
+
+        Tree tree;
+
+        for (const auto key : keys)
+            tree.insert(value_type{key});
+
+        const auto &view = tree;
+
+        for (auto _ : state)
+        {
+            view.search(lookups, results.begin());
+
+            std::size_t found = 0UL;
+
+            for (const auto &result : results)
+                found += result.has_value();
+
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Looks every inserted key up, in random order, in a binary_search_tree_view over
+    *        the tree's archive: the level-order layout a mapped index is searched through.
+    */
+    template <class Tree, distribution Dist>
+    void view_search_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Tree::value_type;
+
+        const auto keys = bench::make_keys(Dist, static_cast<std::size_t>(state.range(0)));
+        const auto lookups = bench::shuffled(keys);
+
+        Tree tree;
+
+        for (const auto key : keys)
+            tree.insert(value_type{key});
+
+        std::ostringstream os{std::ios::binary};
+        serialize(tree, os);
+
+        // An aligned copy of the archive, as a mapping would provide
+        const auto archive = os.str();
+        std::vector<std::uint64_t> storage((archive.size() + 7UL) / 8UL);
+        std::memcpy(storage.data(), archive.data(), archive.size());
+
+        const auto view = *binary_search_tree_view<value_type>::from_archive(
+            std::as_bytes(std::span{storage}).first(archive.size()));
+
+        for (auto _ : state)
+        {
+            std::size_t found = 0UL;
+
+            for (const auto key : lookups)
+                found += view.contains(value_type{key});
+
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Removes every inserted key, in random order, until the tree is empty;
+    *        copying the filled tree beforehand is not timed.
+    */
+    template <class Tree, distribution Dist>
+    void remove_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Tree::value_type;
+
+        const auto keys = bench::make_keys(Dist, static_cast<std::size_t>(state.range(0)));
+        const auto removals = bench::shuffled(keys);
+
+        Tree filled;
+
+        for (const auto key : keys)
+            filled.insert(value_type{key});
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            Tree tree{filled};
+            state.ResumeTiming();
+
+            for (const auto key : removals)
+                remove(tree, value_type{key});
+
+            benchmark::DoNotOptimize(tree);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /**
+    * @brief Shared lookups with one update per 100 of them, from every benchmark thread.
+    * @details Thread 0 builds the shared tree before the timed loop (threads meet at its
+    *          start), then also removes and reinserts a key every 100 lookups.
+    */
+    template <class Tree>
+    void read_mostly_benchmark(benchmark::State &state)
+    {
+        using value_type = typename Tree::value_type;
+
+        static std::optional<Tree> shared;
+
+        const bool writer = (state.thread_index() == 0);
+        const auto keys = bench::make_keys(distribution::random, static_cast<std::size_t>(state.range(0)));
+        const auto lookups = bench::shuffled(keys, 7UL + static_cast<std::uint64_t>(state.thread_index()));
+
+        if (writer)
+        {
+            shared.emplace();
+
+            for (const auto key : keys)
+                shared->insert(value_type{key});
+        }
+
+        for (auto _ : state)
+        {
+            std::size_t found = 0UL;
+
+            for (std::size_t index = 0UL; index != lookups.size(); ++index)
+            {
+                found += search(*shared, value_type{lookups[index]});
+
+                if (writer && (index % 100UL) == 0UL)
+                {
+                    shared->remove(value_type{lookups[index]});
+                    shared->insert(value_type{lookups[index]});
+                }
+            }
+
+            benchmark::DoNotOptimize(found);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+
+        if (writer)
+            shared.reset();
+    }
+
+    template <class Tree>
+    void register_read_mostly(const std::string &name)
+    {
+        bench::apply_sizes(benchmark::RegisterBenchmark(("read_mostly/" + name).c_str(), read_mostly_benchmark<Tree>)
+                               ->ThreadRange(1, 8)
+                               ->UseRealTime());
+    }
+
+    /**
+    * @brief Registers insert/search/remove for one tree type and key distribution.
+    */
+    template <class Tree, distribution Dist>
+    void register_tree(const std::string &name)
+    {
+        const auto prefix = name + "/" + std::string{to_string(Dist)};
+
+        bench::apply_sizes(benchmark::RegisterBenchmark((prefix + "/insert").c_str(), insert_benchmark<Tree, Dist>));
+        bench::apply_sizes(benchmark::RegisterBenchmark((prefix + "/search").c_str(), search_benchmark<Tree, Dist>));
+
+        if constexpr (not std::same_as<Tree, std::multiset<typename Tree::value_type>>)
+        {
+            bench::apply_sizes(
+                benchmark::RegisterBenchmark((prefix + "/search_batch").c_str(), search_batch_benchmark<Tree, Dist>));
+            bench::apply_sizes(
+                benchmark::RegisterBenchmark((prefix + "/view_search").c_str(), view_search_benchmark<Tree, Dist>));
+        }
+        bench::apply_sizes(benchmark::RegisterBenchmark((prefix + "/remove").c_str(), remove_benchmark<Tree, Dist>));
+    }
+
+    /**
+    * @brief Registers every tree for one element size and key distribution.
+    * @details The unbalanced tree only gets random keys: sorted keys and the duplicate runs
+    *          of a zipfian draw degenerate it into a list, which would take hours at 1M.
+    */
+    template <std::size_t Size, distribution Dist>
+    void register_distribution()
+    {
+        using element = payload<Size>;
+
+        const auto suffix = "<" + std::to_string(Size) + "B>";
+
+        register_tree<avl_tree<element>, Dist>("avl_tree" + suffix);
+        register_tree<std::multiset<element>, Dist>("std::multiset" + suffix);
+
+        if constexpr (Dist == distribution::random)
+        {
+            register_tree<plain_tree<element>, Dist>("binary_search_tree" + suffix);
+        }
+    }
+
+    template <std::size_t Size>
+    void register_element_size()
+    {
+        register_distribution<Size, distribution::random>();
+        register_distribution<Size, distribution::sorted>();
+        register_distribution<Size, distribution::zipfian>();
+    }
+}
+
+    void register_tree_benchmarks()
+    {
+        register_element_size<8UL>();
+        register_element_size<64UL>();
+        register_element_size<256UL>();
+
+        register_read_mostly<locked_tree<payload<8UL>>>("shared_mutex<avl_tree><8B>");
+        register_read_mostly<concurrent_tree<payload<8UL>>>("concurrent_binary_search_tree<8B>");
+    }
+}
@@ -0,0 +1,216 @@
+#ifndef __ARENA_HXX__
+#define __ARENA_HXX__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+
+/**
+* @brief A monotonic memory region that only ever grows until it is released as a whole.
+* @details Allocation is a pointer bump inside the current chunk; individual deallocation
+*          is not supported. release() returns every chunk in O(chunks), which is how
+*          containers backed by an arena_allocator are torn down without walking their nodes.
+*/
+struct monotonic_arena final
+{
+private:
+    // Forward declaration of the chunk header
+    struct Chunk;
+
+public:
+    using size_type = std::size_t;
+
+public:
+    /**
+    * @brief Constructs an empty arena.
+    * @param chunk_size The size in bytes of the first chunk; later chunks grow geometrically.
+    */
+    explicit monotonic_arena(size_type chunk_size = 64UL * 1024UL) noexcept
+        : m_next_size{std::max(chunk_size, sizeof(std::max_align_t))}
+    {
+    }
+
+    monotonic_arena(const monotonic_arena &) = delete;
+    monotonic_arena &operator=(const monotonic_arena &) = delete;
+
+    /**
+    * @brief Destructor. Releases every chunk.
+    */
+    ~monotonic_arena() { this->release(); }
+
+public:
+    /**
+    * @brief Allocates `bytes` bytes aligned to `align`.
+    * @param bytes The number of bytes requested.
+    * @param align The requested alignment, a power of two.
+    * @return Pointer to uninitialized storage owned by the arena.
+    */
+    [[nodiscard]] auto allocate(size_type bytes, size_type align) -> void *
+    {
+        auto address = this->__M_align(this->m_cursor, align);
+
+        // Aligning can step past m_end when the chunk is nearly full, so test that first
+        if ((this->m_cursor == nullptr) || (address > this->m_end) ||
+            (bytes > static_cast<size_type>(this->m_end - address)))
+        {
+            this->__M_grow(bytes + align);
+            address = this->__M_align(this->m_cursor, align);
+        }
+
+        this->m_cursor = address + bytes;
+        return address;
+    }
+
+    /**
+    * @brief Returns every chunk to the system in O(chunks).
+    * @details All memory handed out by the arena becomes invalid.
+    */
+    void release() noexcept
+    {
+        while (auto chunk = this->m_chunks)
+        {
+            this->m_chunks = chunk->m_next;
+            ::operator delete(chunk, sizeof(Chunk) + chunk->m_size);
+        }
+
+        this->m_cursor = nullptr;
+        this->m_end    = nullptr;
+    }
+
+    /**
+    * @brief Returns the number of bytes reserved from the system.
+    * @return The summed capacity of all chunks.
+    */
+    [[nodiscard]] auto capacity() const noexcept -> size_type
+    {
+        size_type total = 0UL;
+
+        for (auto chunk = this->m_chunks; chunk != nullptr; chunk = chunk->m_next)
+        {
+            total = total + chunk->m_size;
+        }
+        return total;
+    }
+
+private:
+    /**
+    * @brief Rounds `pointer` up to the next multiple of `align`.
+    */
+    [[nodiscard]] static auto __M_align(std::byte *pointer, size_type align) noexcept -> std::byte *
+    {
+        auto value = reinterpret_cast<std::uintptr_t>(pointer);
+        return pointer + (((value + align - 1UL) & ~(align - 1UL)) - value);
+    }
+
+    /**
+    * @brief Allocates a chunk large enough for at least `bytes` bytes.
+    * @param bytes The minimum usable size of the new chunk.
+    */
+    void __M_grow(size_type bytes)
+    {
+        auto size   = std::max(bytes, this->m_next_size);
+        auto memory = ::operator new(sizeof(Chunk) + size);
+        auto chunk  = ::new (memory) Chunk{this->m_chunks, size};
+
+        this->m_chunks    = chunk;
+        this->m_cursor    = reinterpret_cast<std::byte *>(chunk + 1);
+        this->m_end       = this->m_cursor + size;
+        this->m_next_size = std::min(this->m_next_size * 2UL, size_type{64UL * 1024UL * 1024UL});
+    }
+
+private:
+    // Chunk header, followed in memory by m_size usable bytes
+    struct alignas(std::max_align_t) Chunk
+    {
+        Chunk *m_next;
+        size_type m_size;
+    };
+
+private:
+    Chunk *m_chunks{nullptr};     // Most recently allocated chunk
+    std::byte *m_cursor{nullptr}; // Bump pointer inside the newest chunk
+    std::byte *m_end{nullptr};    // End of the newest chunk
+    size_type m_next_size;        // Size of the next chunk to be allocated
+};
+
+
+
+/**
+* @brief Allocator drawing from a monotonic_arena. deallocate() is a no-op.
+* @details Marked `is_monotonic`, which lets the containers skip the per-node walk in
+*          clear() and their destructors when the element type is trivially destructible.
+* @tparam Type The type of objects allocated.
+*/
+template <class Type>
+struct arena_allocator
+{
+public:
+    using value_type      = Type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using is_monotonic = std::true_type;
+
+public:
+    /**
+    * @brief Constructs an allocator drawing from `arena`.
+    * @param arena The arena that owns all memory handed out.
+    */
+    constexpr arena_allocator(monotonic_arena &arena) noexcept
+        : m_arena{std::addressof(arena)}
+    {
+    }
+
+    /**
+    * @brief Converting constructor used for rebinding.
+    * @param other The allocator whose arena is shared.
+    */
+    template <class UType>
+    constexpr arena_allocator(const arena_allocator<UType> &other) noexcept
+        : m_arena{other.arena()}
+    {
+    }
+
+public:
+    /**
+    * @brief Allocates storage for `count` objects from the arena.
+    * @param count The number of objects.
+    * @return Pointer to uninitialized storage.
+    */
+    [[nodiscard]] auto allocate(size_type count) -> Type *
+    {
+        return static_cast<Type *>(this->m_arena->allocate(count * sizeof(Type), alignof(Type)));
+    }
+
+    /**
+    * @brief No-op: memory is reclaimed when the arena is released.
+    */
+    constexpr void deallocate(Type *, size_type) noexcept {}
+
+    /**
+    * @brief Returns the arena this allocator draws from.
+    */
+    [[nodiscard]] constexpr auto arena() const noexcept -> monotonic_arena * { return this->m_arena; }
+
+public:
+    /**
+    * @brief Two arena allocators are equal when they draw from the same arena.
+    */
+    template <class UType>
+    friend constexpr auto operator==(const arena_allocator &lhs,
+                                     const arena_allocator<UType> &rhs) noexcept -> bool
+    {
+        return (lhs.arena() == rhs.arena());
+    }
+
+private:
+    monotonic_arena *m_arena; // The arena owning all allocations
+};
+
+#endif
@@ -0,0 +1,964 @@
+#ifndef __BTREE_HXX__
+#define __BTREE_HXX__
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+#include "details.h"
+
+
+
+/**
+* @brief An ordered set stored in a B-tree whose nodes hold many keys each.
+* @details Every node packs up to `max_keys` keys into contiguous, cache-line aligned
+*          storage, so a lookup touches one node (a few adjacent cache lines) per level
+*          instead of one cache miss per key as in binary_search_tree. Only internal nodes
+*          carry child pointers: leaves, the vast majority of nodes, are just their keys.
+*          Keys are unique: inserting a key that is already present leaves the tree unchanged.
+* @tparam Type The type of keys stored in the tree.
+* @tparam Allocator The allocator used for the nodes, rebound to the node types.
+* @tparam NodeBytes The target size in bytes of a leaf, rounded up to whole cache lines.
+*/
+template <typename Type, typename Allocator = std::allocator<Type>, std::size_t NodeBytes = 4UL * 64UL>
+    requires std::conjunction<
+        std::bool_constant<std::totally_ordered<Type>>,
+        std::bool_constant<std::default_initializable<Type>>,
+        std::bool_constant<std::movable<Type>>
+    >::value
+struct b_tree final
+{
+private:
+    // Nested Node struct: the keys of a node, all a leaf holds
+    struct Node;
+
+    // Nested Internal struct: a Node followed by its children
+    struct Internal;
+
+private:
+    // Type aliases for allocator and allocator traits, for leaves and internal nodes
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+    using internal_allocator_t = typename traits::template rebind_alloc<Internal>;
+    using internal_traits      = std::allocator_traits<internal_allocator_t>;
+
+public:
+    // Public typedefs for types used in the tree
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using reference       = Type &;
+    using const_reference = const Type &;
+
+    using pointer       = Type *;
+    using const_pointer = const Type *;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    // Size of a leaf: NodeBytes rounded up to whole cache lines
+    static constexpr size_type node_bytes =
+        (NodeBytes + details::cache_line_size - 1UL) / details::cache_line_size * details::cache_line_size;
+
+    // Offset of the keys within a node, past the key count and the leaf flag
+    static constexpr size_type header_bytes = (sizeof(size_type) + sizeof(bool) + alignof(Type) - 1UL)
+                                              / alignof(Type) * alignof(Type);
+
+public:
+    // Maximum number of keys per node: as many as fill a leaf, kept odd so that a full
+    // node splits evenly
+    static constexpr size_type max_keys = ((node_bytes - header_bytes) / sizeof(Type) > 3UL)
+                                              ? ((((node_bytes - header_bytes) / sizeof(Type)) - 1UL) | 1UL)
+                                              : 3UL;
+
+    // Minimum degree: every node but the root holds at least min_degree - 1 keys
+    static constexpr size_type min_degree = (max_keys + 1UL) / 2UL;
+
+public:
+    /**
+    * @brief Default constructor.
+    */
+    constexpr b_tree() noexcept = default;
+
+    /**
+    * @brief Constructs an empty tree using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr b_tree(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
+    /**
+    * @brief Copy constructor.
+    * @param outer The tree to copy from.
+    */
+    constexpr b_tree(const b_tree &outer)
+        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
+    {
+        this->m_root = this->__M_clone(outer.m_root);
+        this->m_size = outer.m_size;
+    }
+
+    /**
+    * @brief Move constructor.
+    * @param outer The tree to move from.
+    */
+    constexpr b_tree(b_tree &&outer) noexcept
+        : m_alloc{std::move(outer.m_alloc)}
+    {
+        this->m_root = std::exchange(outer.m_root, nullptr);
+        this->m_size = std::exchange(outer.m_size, 0UL);
+    }
+
+    /**
+    * @brief Constructor from iterators.
+    * @tparam Iterator The iterator type.
+    * @tparam Sentinel The sentinel type.
+    * @param first The beginning iterator.
+    * @param last The ending sentinel.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<Iterator>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator>>
+        >::value
+    constexpr b_tree(Iterator first, Sentinel last, const Allocator &alloc = Allocator())
+        requires(std::constructible_from<Type, std::iter_reference_t<Iterator>>)
+        : b_tree(alloc)
+    {
+        for (; first != last; first = std::ranges::next(first))
+        {
+            this->insert(*first);
+        }
+    }
+
+    /**
+    * @brief Constructor from ranges.
+    * @tparam range_t The range type.
+    * @param range The range to construct the tree from.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename range_t> requires std::ranges::range<range_t>
+    constexpr b_tree(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
+        requires(std::constructible_from<Type, std::ranges::range_reference_t<range_t>>)
+        : b_tree(std::ranges::begin(range), std::ranges::end(range), alloc)
+    {
+    }
+
+    /**
+    * @brief Constructor from initializer list.
+    * @param list The initializer list to construct the tree from.
+    * @param alloc The allocator used for all node allocations.
+    */
+    constexpr b_tree(std::initializer_list<Type> list, const Allocator &alloc = Allocator())
+        : b_tree(std::ranges::begin(list), std::ranges::end(list), alloc)
+    {
+    }
+
+public:
+    /**
+    * @brief Copy assignment operator.
+    * @param rhs The tree to copy from.
+    * @return b_tree& Reference to the modified tree.
+    */
+    constexpr auto operator=(const b_tree &rhs) -> b_tree &
+    {
+        if (this == std::addressof(rhs))
+        {
+            return *this;
+        }
+
+        this->clear();
+
+        if constexpr (typename traits::propagate_on_container_copy_assignment{})
+        {
+            this->m_alloc = rhs.m_alloc;
+        }
+
+        this->m_root = this->__M_clone(rhs.m_root);
+        this->m_size = rhs.m_size;
+
+        return *this;
+    }
+
+    /**
+    * @brief Move assignment operator.
+    * @details Nodes are stolen when the allocators allow it; otherwise the keys are moved
+    *          into nodes from this tree's allocator and `rhs` is cleared.
+    * @param rhs The tree to move from.
+    * @return b_tree& Reference to the modified tree.
+    */
+    constexpr auto operator=(b_tree &&rhs)
+            noexcept(std::disjunction<typename traits::propagate_on_container_move_assignment,
+                                        typename traits::is_always_equal>{})
+        -> b_tree &
+    {
+        if (this == std::addressof(rhs))
+        {
+            return *this;
+        }
+
+        this->clear();
+
+        if constexpr (typename traits::propagate_on_container_move_assignment{})
+        {
+            this->m_alloc = std::move(rhs.m_alloc);
+        }
+        else if constexpr (not typename traits::is_always_equal{})
+        {
+            if (this->m_alloc != rhs.m_alloc)
+            {
+                this->m_root = this->template __M_clone<true>(rhs.m_root);
+                this->m_size = rhs.m_size;
+                rhs.clear();
+                return *this;
+            }
+        }
+
+        this->m_root = std::exchange(rhs.m_root, nullptr);
+        this->m_size = std::exchange(rhs.m_size, 0UL);
+
+        return *this;
+    }
+
+public:
+    // Insertion and emplacement functions
+
+    /**
+    * @brief Insert a key into the tree.
+    * @param data The key to insert.
+    * @return bool True if the key was inserted, false if it was already present.
+    */
+    template <class UType>
+    constexpr auto insert(UType &&data) -> bool
+        requires std::constructible_from<Type, UType>
+    {
+        return this->__M_insert(Type(std::forward<UType>(data)));
+    }
+
+    /**
+    * @brief Construct a key in place and insert it into the tree.
+    * @param args The arguments for constructing the key.
+    * @return bool True if the key was inserted, false if it was already present.
+    */
+    template <class... ARGS>
+    constexpr auto emplace(ARGS &&...args) -> bool
+        requires std::constructible_from<Type, ARGS...>
+    {
+        return this->__M_insert(Type(std::forward<ARGS>(args)...));
+    }
+
+public:
+    // Lookup functions
+
+    /**
+    * @brief Search for a key in the tree.
+    * @param key The key to search for.
+    * @return An optional reference to the stored key, if found.
+    */
+    [[nodiscard]] constexpr auto search(Type const &key) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        auto node = this->m_root;
+
+        while (node != nullptr)
+        {
+            auto index = __M_lower_bound(node, key);
+
+            if ((index < node->m_count) && not(key < node->m_keys[index]))
+            {
+                return std::optional{std::cref(node->m_keys[index])};
+            }
+
+            node = node->m_leaf ? nullptr : __M_children(node)[index];
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+    * @brief Visit, in ascending order, every key in the half-open interval [lo, hi).
+    * @details Only the nodes overlapping the interval are touched, and keys of a node
+    *          are read sequentially, which makes range scans cache friendly.
+    * @param lo The inclusive lower bound.
+    * @param hi The exclusive upper bound.
+    * @param visitor Callable invoked with each key as `const Type &`.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    constexpr void scan(Type const &lo, Type const &hi, Visitor &&visitor) const
+    {
+        if (this->m_root != nullptr)
+        {
+            __M_scan(this->m_root, lo, hi, visitor);
+        }
+    }
+
+    /**
+    * @brief Visit every key in ascending order.
+    * @param visitor Callable invoked with each key as `const Type &`.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    constexpr void for_each(Visitor &&visitor) const
+    {
+        if (this->m_root != nullptr)
+        {
+            __M_visit(this->m_root, visitor);
+        }
+    }
+
+public:
+    // Removal and clearing functions
+
+    /**
+    * @brief Remove a key from the tree.
+    * @param key The key to remove.
+    * @return bool True if the key was present.
+    */
+    constexpr auto remove(Type const &key) -> bool
+    {
+        if (this->m_root == nullptr)
+        {
+            return false;
+        }
+
+        auto removed = this->__M_remove(this->m_root, key);
+
+        if (this->m_root->m_count == 0UL)
+        {
+            auto target = this->m_root;
+
+            this->m_root = target->m_leaf ? nullptr : __M_children(target)[0];
+            this->__M_destroy_node(target);
+        }
+
+        if (removed)
+        {
+            this->m_size = this->m_size - 1UL;
+        }
+
+        return removed;
+    }
+
+    /**
+    * @brief Clear the tree.
+    */
+    constexpr void clear()
+    {
+        if constexpr (not details::trivially_releasable<allocator_t, Type>)
+        {
+            this->__M_destroy(this->m_root);
+        }
+
+        this->m_root = nullptr;
+        this->m_size = 0UL;
+    }
+
+public:
+    // Utility functions
+
+    // Check if the tree is empty
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool
+    {
+        return (this->m_root == nullptr);
+    }
+
+    // Get the size of the tree
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type
+    {
+        return this->m_size;
+    }
+
+    // Get a copy of the allocator, rebound back to the value type
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+    // Get the maximum value in the tree
+    [[nodiscard]] constexpr auto max() const noexcept -> std::optional<Type>
+    {
+        if (auto node = this->m_root)
+        {
+            while (not node->m_leaf)
+            {
+                node = __M_children(node)[node->m_count];
+            }
+
+            return std::optional{node->m_keys[node->m_count - 1UL]};
+        }
+
+        return std::nullopt;
+    }
+
+    // Get the minimum value in the tree
+    [[nodiscard]] constexpr auto min() const noexcept -> std::optional<Type>
+    {
+        if (auto node = this->m_root)
+        {
+            while (not node->m_leaf)
+            {
+                node = __M_children(node)[0];
+            }
+
+            return std::optional{node->m_keys[0]};
+        }
+
+        return std::nullopt;
+    }
+
+public:
+    /**
+    * @brief Swaps the contents of two trees.
+    * @param lhs The first tree.
+    * @param rhs The second tree.
+    */
+    friend constexpr void swap(b_tree &lhs, b_tree &rhs)
+            noexcept(std::disjunction<typename traits::propagate_on_container_swap,
+                                        typename traits::is_always_equal>{})
+    {
+        if constexpr (typename traits::propagate_on_container_swap{})
+        {
+            std::swap(lhs.m_alloc, rhs.m_alloc);
+        }
+        std::swap(lhs.m_root, rhs.m_root);
+        std::swap(lhs.m_size, rhs.m_size);
+    }
+
+public:
+    /**
+    * @brief Destructor. Clears the tree.
+    */
+    constexpr ~b_tree() { this->clear(); }
+
+private:
+    // Private member functions
+
+    /**
+    * @brief The children of an internal node.
+    */
+    [[nodiscard]] static constexpr auto __M_children(Node *node) noexcept -> Node **
+    {
+        return static_cast<Internal *>(node)->m_children;
+    }
+
+    [[nodiscard]] static constexpr auto __M_children(const Node *node) noexcept -> Node *const *
+    {
+        return static_cast<const Internal *>(node)->m_children;
+    }
+
+    /**
+    * @brief Index of the first key of `node` that is not less than `key`.
+    */
+    [[nodiscard]] static constexpr auto __M_lower_bound(const Node *node, const Type &key) noexcept -> size_type
+    {
+        auto first = node->m_keys;
+        return static_cast<size_type>(std::lower_bound(first, first + node->m_count, key) - first);
+    }
+
+    /**
+    * @brief Allocate an empty node, a bare Node for a leaf and an Internal otherwise.
+    * @param leaf Whether the node is a leaf.
+    */
+    constexpr auto __M_create_node(bool leaf) -> Node *
+    {
+        if (leaf)
+        {
+            return __M_allocate_construct<traits>(this->m_alloc);
+        }
+
+        internal_allocator_t alloc(this->m_alloc);
+
+        Node *node = __M_allocate_construct<internal_traits>(alloc);
+
+        node->m_leaf = false;
+        return node;
+    }
+
+    template <class Traits, class Alloc>
+    static constexpr auto __M_allocate_construct(Alloc &alloc) -> typename Traits::value_type *
+    {
+        auto node = Traits::allocate(alloc, 1UL);
+
+        try {
+            Traits::construct(alloc, std::to_address(node));
+        }
+        catch (...) {
+            Traits::deallocate(alloc, std::to_address(node), 1UL);
+            throw;
+        }
+
+        return std::to_address(node);
+    }
+
+    /**
+    * @brief Destroy and deallocate a single node, leaving its children alone.
+    */
+    constexpr void __M_destroy_node(Node *node) noexcept
+    {
+        if (node->m_leaf)
+        {
+            traits::destroy(this->m_alloc, node);
+            traits::deallocate(this->m_alloc, node, 1UL);
+            return;
+        }
+
+        internal_allocator_t alloc(this->m_alloc);
+
+        auto internal = static_cast<Internal *>(node);
+
+        internal_traits::destroy(alloc, internal);
+        internal_traits::deallocate(alloc, internal, 1UL);
+    }
+
+    /**
+    * @brief Destroy a whole subtree. The recursion depth is the tree height, O(log n).
+    */
+    constexpr void __M_destroy(Node *node) noexcept
+    {
+        if (node == nullptr)
+            return;
+
+        if (not node->m_leaf)
+        {
+            for (size_type index = 0UL; index <= node->m_count; ++index)
+            {
+                this->__M_destroy(__M_children(node)[index]);
+            }
+        }
+
+        this->__M_destroy_node(node);
+    }
+
+    /**
+    * @brief Deep copy of a subtree.
+    * @details Children are attached as soon as they are built, so a throwing copy
+    *          leaves a well-formed partial subtree that is destroyed before rethrowing.
+    * @tparam Move Whether the keys are moved out of `source` rather than copied.
+    */
+    template <bool Move = false>
+    constexpr auto __M_clone(std::conditional_t<Move, Node, const Node> *source) -> Node *
+    {
+        if (source == nullptr)
+            return nullptr;
+
+        auto node = this->__M_create_node(source->m_leaf);
+
+        try {
+            if constexpr (Move)
+                std::move(source->m_keys, source->m_keys + source->m_count, node->m_keys);
+            else
+                std::copy(source->m_keys, source->m_keys + source->m_count, node->m_keys);
+
+            node->m_count = source->m_count;
+
+            if (not source->m_leaf)
+            {
+                for (size_type index = 0UL; index <= source->m_count; ++index)
+                {
+                    __M_children(node)[index] = this->template __M_clone<Move>(__M_children(source)[index]);
+                }
+            }
+        }
+        catch (...) {
+            this->__M_destroy(node);
+            throw;
+        }
+
+        return node;
+    }
+
+    /**
+    * @brief Top-down insertion that splits full nodes on the way down.
+    * @param data The key to insert.
+    * @return bool True if the key was inserted.
+    */
+    constexpr auto __M_insert(Type &&data) -> bool
+    {
+        if (this->m_root == nullptr)
+        {
+            this->m_root = this->__M_create_node(true);
+        }
+
+        if (this->m_root->m_count == max_keys)
+        {
+            auto root = this->__M_create_node(false);
+
+            __M_children(root)[0] = this->m_root;
+            this->m_root = root;
+
+            this->__M_split_child(root, 0UL);
+        }
+
+        auto node = this->m_root;
+
+        while (true)
+        {
+            auto index = __M_lower_bound(node, data);
+
+            if ((index < node->m_count) && not(data < node->m_keys[index]))
+            {
+                return false;
+            }
+
+            if (node->m_leaf)
+            {
+                std::move_backward(node->m_keys + index, node->m_keys + node->m_count,
+                                   node->m_keys + node->m_count + 1UL);
+
+                node->m_keys[index] = std::move(data);
+                node->m_count = node->m_count + 1UL;
+
+                this->m_size = this->m_size + 1UL;
+                return true;
+            }
+
+            if (__M_children(node)[index]->m_count == max_keys)
+            {
+                this->__M_split_child(node, index);
+
+                if (not(data < node->m_keys[index]) && not(node->m_keys[index] < data))
+                {
+                    return false;
+                }
+
+                if (node->m_keys[index] < data)
+                {
+                    index = index + 1UL;
+                }
+            }
+
+            node = __M_children(node)[index];
+        }
+    }
+
+    /**
+    * @brief Split the full child `index` of `parent` around its median key.
+    * @param parent A non-full internal node.
+    * @param index The position of the full child.
+    */
+    constexpr void __M_split_child(Node *parent, size_type index)
+    {
+        auto child = __M_children(parent)[index];
+        auto sibling = this->__M_create_node(child->m_leaf);
+
+        std::move(child->m_keys + min_degree, child->m_keys + max_keys, sibling->m_keys);
+
+        if (not child->m_leaf)
+        {
+            std::copy(__M_children(child) + min_degree, __M_children(child) + max_keys + 1UL,
+                      __M_children(sibling));
+        }
+
+        sibling->m_count = min_degree - 1UL;
+        child->m_count = min_degree - 1UL;
+
+        std::copy_backward(__M_children(parent) + index + 1UL, __M_children(parent) + parent->m_count + 1UL,
+                           __M_children(parent) + parent->m_count + 2UL);
+        std::move_backward(parent->m_keys + index, parent->m_keys + parent->m_count,
+                           parent->m_keys + parent->m_count + 1UL);
+
+        __M_children(parent)[index + 1UL] = sibling;
+        parent->m_keys[index] = std::move(child->m_keys[min_degree - 1UL]);
+        parent->m_count = parent->m_count + 1UL;
+    }
+
+    /**
+    * @brief Remove `key` from the subtree rooted at `node`, which holds at least
+    *        min_degree keys unless it is the root.
+    * @return bool True if the key was found.
+    */
+    constexpr auto __M_remove(Node *node, const Type &key) -> bool
+    {
+        while (true)
+        {
+            auto index = __M_lower_bound(node, key);
+
+            if ((index < node->m_count) && not(key < node->m_keys[index]))
+            {
+                if (node->m_leaf)
+                {
+                    std::move(node->m_keys + index + 1UL, node->m_keys + node->m_count, node->m_keys + index);
+                    node->m_count = node->m_count - 1UL;
+                    return true;
+                }
+
+                auto left = __M_children(node)[index];
+                auto right = __M_children(node)[index + 1UL];
+
+                if (left->m_count >= min_degree)
+                {
+                    node->m_keys[index] = this->__M_pop_max(left);
+                    return true;
+                }
+
+                if (right->m_count >= min_degree)
+                {
+                    node->m_keys[index] = this->__M_pop_min(right);
+                    return true;
+                }
+
+                this->__M_merge(node, index);
+                node = left;
+                continue;
+            }
+
+            if (node->m_leaf)
+            {
+                return false;
+            }
+
+            if (__M_children(node)[index]->m_count < min_degree)
+            {
+                index = this->__M_fill(node, index);
+            }
+
+            node = __M_children(node)[index];
+        }
+    }
+
+    /**
+    * @brief Extract the largest key of a subtree holding at least min_degree keys.
+    */
+    constexpr auto __M_pop_max(Node *node) -> Type
+    {
+        while (not node->m_leaf)
+        {
+            auto index = node->m_count;
+
+            if (__M_children(node)[index]->m_count < min_degree)
+            {
+                index = this->__M_fill(node, index);
+            }
+
+            node = __M_children(node)[index];
+        }
+
+        node->m_count = node->m_count - 1UL;
+        return std::move(node->m_keys[node->m_count]);
+    }
+
+    /**
+    * @brief Extract the smallest key of a subtree holding at least min_degree keys.
+    */
+    constexpr auto __M_pop_min(Node *node) -> Type
+    {
+        while (not node->m_leaf)
+        {
+            if (__M_children(node)[0]->m_count < min_degree)
+            {
+                this->__M_fill(node, 0UL);
+            }
+
+            node = __M_children(node)[0];
+        }
+
+        auto key = std::move(node->m_keys[0]);
+
+        std::move(node->m_keys + 1UL, node->m_keys + node->m_count, node->m_keys);
+        node->m_count = node->m_count - 1UL;
+
+        return key;
+    }
+
+    /**
+    * @brief Give child `index` of `parent` at least min_degree keys by borrowing
+    *        from a sibling or merging with one.
+    * @return size_type The position of the refilled child, which moves left on a merge
+    *         with the left sibling.
+    */
+    constexpr auto __M_fill(Node *parent, size_type index) -> size_type
+    {
+        auto child = __M_children(parent)[index];
+
+        if ((index > 0UL) && (__M_children(parent)[index - 1UL]->m_count >= min_degree))
+        {
+            auto left = __M_children(parent)[index - 1UL];
+
+            std::move_backward(child->m_keys, child->m_keys + child->m_count,
+                               child->m_keys + child->m_count + 1UL);
+
+            if (not child->m_leaf)
+            {
+                std::copy_backward(__M_children(child), __M_children(child) + child->m_count + 1UL,
+                                   __M_children(child) + child->m_count + 2UL);
+                __M_children(child)[0] = __M_children(left)[left->m_count];
+            }
+
+            child->m_keys[0] = std::move(parent->m_keys[index - 1UL]);
+            parent->m_keys[index - 1UL] = std::move(left->m_keys[left->m_count - 1UL]);
+
+            left->m_count = left->m_count - 1UL;
+            child->m_count = child->m_count + 1UL;
+
+            return index;
+        }
+
+        if ((index < parent->m_count) && (__M_children(parent)[index + 1UL]->m_count >= min_degree))
+        {
+            auto right = __M_children(parent)[index + 1UL];
+
+            child->m_keys[child->m_count] = std::move(parent->m_keys[index]);
+            parent->m_keys[index] = std::move(right->m_keys[0]);
+
+            if (not child->m_leaf)
+            {
+                __M_children(child)[child->m_count + 1UL] = __M_children(right)[0];
+                std::copy(__M_children(right) + 1UL, __M_children(right) + right->m_count + 1UL, __M_children(right));
+            }
+
+            std::move(right->m_keys + 1UL, right->m_keys + right->m_count, right->m_keys);
+
+            right->m_count = right->m_count - 1UL;
+            child->m_count = child->m_count + 1UL;
+
+            return index;
+        }
+
+        if (index < parent->m_count)
+        {
+            this->__M_merge(parent, index);
+            return index;
+        }
+
+        this->__M_merge(parent, index - 1UL);
+        return index - 1UL;
+    }
+
+    /**
+    * @brief Merge child `index + 1` and the separating key into child `index`.
+    */
+    constexpr void __M_merge(Node *parent, size_type index) noexcept
+    {
+        auto left = __M_children(parent)[index];
+        auto right = __M_children(parent)[index + 1UL];
+
+        left->m_keys[left->m_count] = std::move(parent->m_keys[index]);
+
+        std::move(right->m_keys, right->m_keys + right->m_count, left->m_keys + left->m_count + 1UL);
+
+        if (not left->m_leaf)
+        {
+            std::copy(__M_children(right), __M_children(right) + right->m_count + 1UL,
+                      __M_children(left) + left->m_count + 1UL);
+        }
+
+        left->m_count = left->m_count + right->m_count + 1UL;
+
+        std::move(parent->m_keys + index + 1UL, parent->m_keys + parent->m_count, parent->m_keys + index);
+        std::copy(__M_children(parent) + index + 2UL, __M_children(parent) + parent->m_count + 1UL,
+                  __M_children(parent) + index + 1UL);
+
+        parent->m_count = parent->m_count - 1UL;
+
+        this->__M_destroy_node(right);
+    }
+
+    /**
+    * @brief In-order visit of the keys of a subtree that lie in [lo, hi).
+    * @return bool False once a key not less than `hi` has been reached.
+    */
+    template <class Visitor>
+    static constexpr auto __M_scan(const Node *node, const Type &lo, const Type &hi, Visitor &visitor) -> bool
+    {
+        for (auto index = __M_lower_bound(node, lo); index < node->m_count; ++index)
+        {
+            if (not node->m_leaf && not __M_scan(__M_children(node)[index], lo, hi, visitor))
+            {
+                return false;
+            }
+
+            if (not(node->m_keys[index] < hi))
+            {
+                return false;
+            }
+
+            std::invoke(visitor, std::as_const(node->m_keys[index]));
+        }
+
+        return node->m_leaf || __M_scan(__M_children(node)[node->m_count], lo, hi, visitor);
+    }
+
+    template <class Visitor>
+    static constexpr void __M_visit(const Node *node, Visitor &visitor)
+    {
+        for (size_type index = 0UL; index < node->m_count; ++index)
+        {
+            if (not node->m_leaf)
+            {
+                __M_visit(__M_children(node)[index], visitor);
+            }
+
+            std::invoke(visitor, std::as_const(node->m_keys[index]));
+        }
+
+        if (not node->m_leaf)
+        {
+            __M_visit(__M_children(node)[node->m_count], visitor);
+        }
+    }
+
+private:
+    // Private data members
+    Node *m_root{nullptr};
+    size_type m_size{0UL};
+    [[no_unique_address]] allocator_t m_alloc{};
+};
+
+
+// Deduction guides
+
+/**
+* @brief Deduction guide for b_tree from range.
+* @tparam range_t Type of the range.
+*/
+template <class Range_t>
+b_tree(details::from_range_t, Range_t &&) -> b_tree<std::ranges::range_value_t<Range_t>>;
+
+/**
+* @brief Deduction guide for b_tree from iterators and sentinels.
+* @tparam Iterator Type of the iterator.
+* @tparam Sentinel Type of the sentinel.
+*/
+template <class Iterator, class Sentinel>
+b_tree(Iterator, Sentinel) -> b_tree<std::iter_value_t<Iterator>>;
+
+
+
+// Node struct holding up to max_keys sorted keys: the whole of a leaf, and the head of an
+// internal node. Aligned so that a node starts a cache line and a leaf fills whole lines.
+template <typename Type, typename Allocator, std::size_t NodeBytes>
+    requires std::conjunction<
+        std::bool_constant<std::totally_ordered<Type>>,
+        std::bool_constant<std::default_initializable<Type>>,
+        std::bool_constant<std::movable<Type>>
+    >::value
+struct alignas(details::cache_line_size) b_tree<Type, Allocator, NodeBytes>::Node
+{
+    size_type m_count{0UL};                   // Number of keys in use
+    bool m_leaf{true};                        // Whether the node has no children
+    Type m_keys[max_keys]{};                  // Sorted keys, contiguous for sequential scans
+};
+
+// Internal node: the keys followed by max_keys + 1 children
+template <typename Type, typename Allocator, std::size_t NodeBytes>
+    requires std::conjunction<
+        std::bool_constant<std::totally_ordered<Type>>,
+        std::bool_constant<std::default_initializable<Type>>,
+        std::bool_constant<std::movable<Type>>
+    >::value
+struct b_tree<Type, Allocator, NodeBytes>::Internal final : Node
+{
+    Node *m_children[max_keys + 1UL]{};       // Children
+};
+
+#endif
@@ -3,42 +3,133 @@
 
 
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <ranges>
+#include <span>
+#include <thread>
 #include <utility>
 
+#include "container_stats.h"
+#include "details.h"
+#include "node_handle.h"
 
-// Namespace containing helper concepts
-namespace details
+
+// Balancing policies for binary_search_tree
+
+// Plain binary search tree: insertion order decides the shape
+struct unbalanced_policy final
 {
-    /**
-    * @brief Concept to check if a type is not the same as or derived from another type.
-    * @tparam T The type to be checked.
-    * @tparam U The type to compare against.
-    */
-    template <class T, class U>
-    concept non_self = std::conjunction<
-        std::negation<std::bool_constant<std::same_as<std::decay_t<T>, U>>>,
-        std::negation<std::bool_constant<std::derived_from<std::decay_t<T>, U>>>>::value;
-}
+};
+
+// AVL tree: subtree heights differ by at most one, giving O(log n) worst-case operations
+struct avl_policy final
+{
+};
+
+
+// Augmentation policies for binary_search_tree
+
+// Plain nodes: nothing is cached beyond what the balancing policy needs
+struct no_augmentation final
+{
+};
+
+// Order statistics: every node caches the size of its subtree, enabling rank(), select()
+// and count_range() in O(height) at the cost of one counter per node
+struct order_statistics final
+{
+};
+
+
+// Tag selecting the constructors that build a balanced tree from already sorted input
+struct sorted_range_t final
+{
+    explicit sorted_range_t() = default;
+};
+
+inline constexpr sorted_range_t sorted_range{};
+
+
+// Tag selecting the parallel bulk operations of binary_search_tree
+// The work is forked at the top levels of the tree onto up to `m_threads` threads
+// (0 picks std::thread::hardware_concurrency()). The allocator must then accept
+// concurrent allocate/deallocate calls, as std::allocator does.
+struct parallel_t final
+{
+    explicit constexpr parallel_t(unsigned threads = 0U) noexcept
+        : m_threads{threads}
+    {
+    }
+
+    unsigned m_threads;
+};
+
+inline constexpr parallel_t parallel{};
+
+
+// Key/value map built on binary_search_tree, see bst_map.h
+template <typename Key, typename Value, typename Allocator, typename Balance, typename Compare>
+    requires std::strict_weak_order<Compare &, const Key &, const Key &>
+struct bst_map;
 
 
 // Templated binary search tree class
-template <typename Type> requires std::totally_ordered<Type>
+// Allocator is rebound to the node type, so any standard-conforming allocator
+// (std::pmr::polymorphic_allocator, arenas, pools) can back the nodes.
+// Balance selects the balancing policy (unbalanced_policy or avl_policy).
+// Compare orders the elements; a transparent comparator (one declaring is_transparent,
+// such as std::less<>) also enables lookups by any key type it can compare.
+// Augment selects what the nodes cache for queries (no_augmentation or order_statistics).
+// Stats selects whether the tree counts its work for stats() (no_stats or operation_stats).
+template <typename Type, typename Allocator = std::allocator<Type>, typename Balance = unbalanced_policy,
+          typename Compare = std::less<Type>, typename Augment = no_augmentation, typename Stats = no_stats>
+    requires std::strict_weak_order<Compare &, const Type &, const Type &>
 struct binary_search_tree final
 {
 private:
     // Nested Node struct representing a node in the tree
     struct Node;
 
+    // Nested in-order iterator over the tree's nodes
+    struct Iterator;
+
+    // The map drives the single-descent find-or-emplace below
+    template <typename K, typename V, typename A, typename B, typename C>
+        requires std::strict_weak_order<C &, const K &, const K &>
+    friend struct bst_map;
+
+private:
+    // Whether nodes carry a height and the tree is rebalanced after every update
+    static constexpr bool is_balanced = std::same_as<Balance, avl_policy>;
+
+    // Lookups the batched search keeps in flight at once
+    static constexpr std::size_t search_lanes = 8UL;
+
+    // Whether nodes carry the size of their subtree
+    static constexpr bool is_ranked = std::same_as<Augment, order_statistics>;
+
+    // Height stored in each node, compiled out for the unbalanced policy
+    using height_t = std::conditional_t<is_balanced, std::int8_t, details::empty_type>;
+
+    // Subtree size stored in each node, compiled out without order statistics
+    using count_t = std::conditional_t<is_ranked, std::size_t, details::empty_type>;
+
 private:
     // Type aliases for allocator and allocator traits
-    using allocator_t = std::allocator<Node>;
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
     using traits      = std::allocator_traits<allocator_t>;
 
 public:
     // Public typedefs for types used in the tree
-    using value_type = Type;
+    using value_type     = Type;
+    using allocator_type = Allocator;
 
     using reference       = Type &;
     using const_reference = const Type &;
@@ -49,19 +140,52 @@ public:
     using size_type       = std::size_t;
     using difference_type = std::ptrdiff_t;
 
+    using balance_policy = Balance;
+
+    using key_compare   = Compare;
+    using value_compare = Compare;
+
+    // Elements are keys, so both iterators are constant iterators, as for std::set
+    using iterator       = Iterator;
+    using const_iterator = Iterator;
+
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Owning handle to an extracted node
+    using node_type = node_handle<binary_search_tree, Node>;
+
 public:
     /**
     * @brief Default constructor.
     */
     constexpr binary_search_tree() noexcept = default;
 
+    /**
+    * @brief Constructs an empty tree using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr binary_search_tree(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
+    /**
+    * @brief Constructs an empty tree ordered by `comp`.
+    * @param comp The comparator ordering the elements.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr binary_search_tree(const Compare &comp, const Allocator &alloc = Allocator())
+        : m_alloc{alloc}, m_comp{comp}
+    {
+    }
+
     /**
     * @brief Copy constructor.
     * @param outer The binary search tree to copy from.
     */
     constexpr binary_search_tree(const binary_search_tree &outer)
-        noexcept(std::is_nothrow_copy_constructible<allocator_t>{})
-        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
+        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}, m_comp{outer.m_comp}
     {
         this->m_root = this->__M_clone(outer.m_root);
         this->m_size = outer.m_size;
@@ -72,8 +196,9 @@ public:
     * @param outer The binary search tree to move from.
     */
     constexpr binary_search_tree(binary_search_tree &&outer)
-        noexcept(std::is_nothrow_move_constructible<allocator_t>{})
-        : m_alloc{std::move(outer.m_alloc)}
+        noexcept(std::conjunction<std::is_nothrow_move_constructible<allocator_t>,
+                                  std::is_nothrow_move_constructible<Compare>>{})
+        : m_alloc{std::move(outer.m_alloc)}, m_comp{std::move(outer.m_comp)}
     {
         this->m_root = std::exchange(outer.m_root, nullptr);
         this->m_size = std::exchange(outer.m_size, 0UL);
@@ -85,15 +210,16 @@ public:
     * @tparam Sentinel The sentinel type.
     * @param first The beginning iterator.
     * @param last The ending sentinel.
+    * @param alloc The allocator used for all node allocations.
     */
     template <typename Iterator, typename Sentinel>
         requires std::conjunction<
             std::bool_constant<std::input_iterator<Iterator>>,
             std::bool_constant<std::sentinel_for<Sentinel, Iterator>>
         >::value
-    constexpr binary_search_tree(Iterator first, Sentinel last)
+    constexpr binary_search_tree(Iterator first, Sentinel last, const Allocator &alloc = Allocator())
         requires(std::constructible_from<Type, std::iter_value_t<Iterator>>)
-        : binary_search_tree{}
+        : binary_search_tree(alloc)
     {
         this->__M_range_init(first, last);
     }
@@ -102,22 +228,105 @@ public:
     * @brief Constructor from ranges.
     * @tparam range_t The range type.
     * @param range The range to construct the tree from.
+    * @param alloc The allocator used for all node allocations.
     */
-    template <typename range_t> requires std::ranges:ranges<range_t>
-    constexpr binary_search_tree(std::from_range_t, range_t &&range)
+    template <typename range_t> requires std::ranges::range<range_t>
+    constexpr binary_search_tree(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
         requires(std::conjunction<
                  std::bool_constant<details::non_self<range_t, binary_search_tree>>,
                  std::bool_constant<std::constructible_from<Type, std::ranges::range_value_t<range_t>>>>::value)
-        : binary_search_tree{std::ranges::begin(range), std::ranges::end(range)}
+        : binary_search_tree(std::ranges::begin(range), std::ranges::end(range), alloc)
+    {
+    }
+
+    /**
+    * @brief Bulk-load constructor from a sorted range of iterators.
+    * @details Builds a perfectly balanced tree in O(n) without a single comparison.
+    *          With a monotonic allocator all nodes come from one batch allocation.
+    * @tparam Iterator The iterator type.
+    * @tparam Sentinel The sentinel type.
+    * @param tag Tag asserting that [first, last) is sorted in ascending order.
+    * @param first The beginning iterator.
+    * @param last The ending sentinel.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::forward_iterator<Iterator>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator>>
+        >::value
+    constexpr binary_search_tree(sorted_range_t, Iterator first, Sentinel last, const Allocator &alloc = Allocator())
+        requires(std::constructible_from<Type, std::iter_reference_t<Iterator>>)
+        : binary_search_tree(alloc)
+    {
+        this->__M_sorted_init(first, static_cast<size_type>(std::ranges::distance(first, last)));
+    }
+
+    /**
+    * @brief Bulk-load constructor from a sorted range.
+    * @tparam range_t The range type.
+    * @param tag Tag asserting that `range` is sorted in ascending order.
+    * @param range The range to construct the tree from.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename range_t> requires std::ranges::forward_range<range_t>
+    constexpr binary_search_tree(sorted_range_t tag, range_t &&range, const Allocator &alloc = Allocator())
+        requires(std::constructible_from<Type, std::ranges::range_reference_t<range_t>>)
+        : binary_search_tree(tag, std::ranges::begin(range), std::ranges::end(range), alloc)
+    {
+    }
+
+    /**
+    * @brief Parallel bulk-load constructor from a sorted random-access range.
+    * @details Builds the same perfectly balanced tree as the sorted_range constructor,
+    *          creating the independent left and right subtrees on separate threads.
+    * @param policy The parallelism to use.
+    * @param tag Tag asserting that [first, last) is sorted in ascending order.
+    * @param first The beginning iterator.
+    * @param last The ending sentinel.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::random_access_iterator<Iterator>>,
+            std::bool_constant<std::sized_sentinel_for<Sentinel, Iterator>>
+        >::value
+    binary_search_tree(parallel_t policy, [[maybe_unused]] sorted_range_t tag, Iterator first, Sentinel last,
+                       const Allocator &alloc = Allocator())
+        requires(std::constructible_from<Type, std::iter_reference_t<Iterator>>)
+        : binary_search_tree(alloc)
+    {
+        auto count = static_cast<size_type>(last - first);
+
+        this->m_root = this->__M_build_parallel(first, count, __M_fork_depth(policy));
+        this->m_size = count;
+    }
+
+    /**
+    * @brief Parallel bulk-load constructor from a sorted random-access range.
+    * @param policy The parallelism to use.
+    * @param tag Tag asserting that `range` is sorted in ascending order.
+    * @param range The range to construct the tree from.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename range_t>
+        requires std::conjunction<
+            std::bool_constant<std::ranges::random_access_range<range_t>>,
+            std::bool_constant<std::ranges::sized_range<range_t>>
+        >::value
+    binary_search_tree(parallel_t policy, sorted_range_t tag, range_t &&range, const Allocator &alloc = Allocator())
+        requires(std::constructible_from<Type, std::ranges::range_reference_t<range_t>>)
+        : binary_search_tree(policy, tag, std::ranges::begin(range), std::ranges::end(range), alloc)
     {
     }
 
     /**
     * @brief Constructor from initializer list.
     * @param list The initializer list to construct the tree from.
+    * @param alloc The allocator used for all node allocations.
     */
-    constexpr binary_search_tree(std::initializer_list<Type> list)
-        : binary_search_tree{std::ranges::begin(list), std::ranges::end(list)}
+    constexpr binary_search_tree(std::initializer_list<Type> list, const Allocator &alloc = Allocator())
+        : binary_search_tree(std::ranges::begin(list), std::ranges::end(list), alloc)
     {
     }
 
@@ -172,7 +381,7 @@ public:
     // Insertion and emplacement functions
 
     // Insert a value into the tree
-    template <std::totally_ordered_with<Type> UType>
+    template <class UType>
     constexpr void insert(UType &&data)
         requires std::constructible_from<Type, UType>
     {
@@ -188,160 +397,150 @@ public:
             this->__M_create_node(std::in_place, std::forward_as_tuple(args...)));
     }
 
-public:
-    // Search function
-
-    // Search for a value in the tree
-    [[nodiscard]] constexpr auto search(Type const &key) noexcept
-        -> std::optional<std::reference_wrapper<Type>>
-    {
-        return __M_search<Type>(this->m_root, key);
-    }
-
-    // Const version of search function
-    [[nodiscard]] constexpr auto search(Type const &key) const noexcept
-        -> std::optional<const std::reference_wrapper<Type>>
+    /**
+    * @brief Links an extracted node back in, without allocating.
+    * @param handle The handle to take the node from; left empty.
+    * @return iterator The inserted element, or end() if the handle was empty.
+    */
+    constexpr auto insert(node_type &&handle) noexcept -> iterator
     {
-        return __M_search<Type>(this->m_root, key);
-    }
+        if (handle.empty())
+            return this->end();
 
-public:
-    // Removal and clearing functions
+        assert(handle.__M_compatible(this->m_alloc));
 
-    // Remove a value from the tree
-    constexpr void remove(Type const &key)
-    {
-        if (auto current = this->m_root)
-        {
-            while (current != nullptr)
-            {
-                if (key < current->m_data)
-                {
-                    current = current->m_left;
-                }
-                else if (key > current->m_data)
-                {
-                    current = current->m_right;
-                }
-                else
-                {
-                    break;
-                }
-            }
+        auto node = handle.__M_release();
 
-            if (current == nullptr)
-            {
-                return;
-            }
+        node->m_height = height_t{};
+        this->__M_insert(node);
+        this->m_stats.relinked();
 
-            auto parent = current->m_parent;
+        return iterator{node, this};
+    }
 
-            if ((current->m_left == nullptr) && (current->m_right != nullptr))
-            {
-                if (parent->m_left == current)
-                {
-                    parent->m_left = nullptr;
-                }
-                else
-                {
-                    parent->m_right = nullptr;
-                }
+public:
+    // Node extraction
+    // Unlinks a node without destroying it, so the element can be modified or
+    // moved to another tree and linked back in with insert(node_type&&).
 
-                traits::destroy(this->m_alloc, std::to_address(current));
-                traits::deallocate(this->m_alloc, std::to_address(current), 1UL);
+    /**
+    * @brief Unlinks the element at `position`.
+    * @param position A dereferenceable iterator into this tree.
+    * @return node_type The handle owning the node.
+    */
+    [[nodiscard]] constexpr auto extract(const_iterator position) noexcept -> node_type
+    {
+        auto node = const_cast<Node *>(position.m_cursor);
 
-                this->m_size = this->m_size - 1UL;
+        this->__M_unlink(node);
+        this->m_stats.relinked();
 
-                return;
-            }
+        return node_type{node, std::addressof(node->m_data), this->m_alloc};
+    }
 
-            if ((current->m_left != nullptr) || (current->m_right != nullptr))
-            {
-                if (current->m_left != nullptr)
-                {
-                    parent->m_left = current->m_left;
-                    current->m_left->m_parent = parent;
-                }
-                else
-                {
-                    parent->m_right = current->m_right;
-                    parent->m_right->m_parent = parent;
-                }
+    /**
+    * @brief Unlinks one element equivalent to `key`.
+    * @param key The key to search for.
+    * @return node_type The handle owning the node, empty if no element matched.
+    */
+    [[nodiscard]] constexpr auto extract(const Type &key) noexcept -> node_type { return this->__M_extract(key); }
 
-                traits::destroy(this->m_alloc, std::to_address(current));
-                traits::deallocate(this->m_alloc, std::to_address(current), 1UL);
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto extract(const Key &key) noexcept -> node_type
+    {
+        return this->__M_extract(key);
+    }
 
-                this->m_size = this->m_size - 1UL;
+public:
+    // Search function
 
-                return;
-            }
+    // Search for a value in the tree
+    [[nodiscard]] constexpr auto search(Type const &key) noexcept
+        -> std::optional<std::reference_wrapper<Type>>
+    {
+        return this->__M_search<std::reference_wrapper<Type>>(this->m_root, key);
+    }
 
-            if ((current->m_left != nullptr) && (current->m_right != nullptr))
-            {
-                auto temp = current->m_right;
-                parent = nullptr;
+    // Const version of search function
+    [[nodiscard]] constexpr auto search(Type const &key) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_search<std::reference_wrapper<const Type>>(static_cast<const Node *>(this->m_root), key);
+    }
 
-                while (temp->m_left != nullptr)
-                {
-                    parent = temp;
-                    temp = temp->m_left;
-                }
+    // Search by any key the transparent comparator can compare with Type
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto search(const Key &key) noexcept
+        -> std::optional<std::reference_wrapper<Type>>
+    {
+        return this->__M_search<std::reference_wrapper<Type>>(this->m_root, key);
+    }
 
-                if (parent != nullptr)
-                {
-                    parent->m_left = temp->m_right;
-                }
-                else
-                {
-                    current->m_right = temp->m_right;
+    // Const version of the heterogeneous search
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto search(const Key &key) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_search<std::reference_wrapper<const Type>>(static_cast<const Node *>(this->m_root), key);
+    }
 
-                    if (temp->m_right != nullptr)
-                    {
-                        temp->m_right->m_parent = current;
-                    }
-                    else
-                    {
-                        temp->m_parent = current;
-                    }
-                }
+    /**
+    * @brief Search for several keys at once, writing one result per key to `out`, in order.
+    * @details Up to search_lanes lookups descend in lockstep, one level per round, and each
+    *          one prefetches the node it moves to. By the time a lookup is stepped again its
+    *          node has arrived, so on trees larger than the cache the misses of several
+    *          lookups overlap instead of queueing up behind each other.
+    * @param keys The keys to search for.
+    * @param out Receives an std::optional<std::reference_wrapper<Type>> per key.
+    * @return _iterator The output iterator past the last result.
+    */
+    template <typename _iterator>
+        requires std::output_iterator<_iterator, std::optional<std::reference_wrapper<Type>>>
+    constexpr auto search(std::span<const Type> keys, _iterator out) -> _iterator
+    {
+        return this->__M_search_batch<std::reference_wrapper<Type>>(this->m_root, keys, std::move(out));
+    }
 
-                current->m_data = temp->m_data;
+    // Const version of the batched search
+    template <typename _iterator>
+        requires std::output_iterator<_iterator, std::optional<std::reference_wrapper<const Type>>>
+    constexpr auto search(std::span<const Type> keys, _iterator out) const -> _iterator
+    {
+        return this->__M_search_batch<std::reference_wrapper<const Type>>(static_cast<const Node *>(this->m_root),
+                                                                          keys, std::move(out));
+    }
 
-                traits::destroy(this->m_alloc, std::to_address(temp));
-                traits::deallocate(this->m_alloc, std::to_address(temp), 1UL);
+public:
+    // Removal and clearing functions
 
-                this->m_size = this->m_size - 1UL;
+    // Remove a value from the tree
+    constexpr void remove(Type const &key) { this->__M_remove(key); }
 
-                return;
-            }
-        }
+    // Remove by any key the transparent comparator can compare with Type
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    constexpr void remove(const Key &key)
+    {
+        this->__M_remove(key);
     }
 
     // Clear the tree
+    // With a monotonic allocator and a trivially destructible Type the nodes are
+    // dropped in O(1); their memory is reclaimed when the arena is released.
     constexpr void clear()
     {
-        Node *current = this->m_root;
-        Node *temp = nullptr;
-
-        while (current != nullptr)
+        if constexpr (details::trivially_releasable<allocator_t, Type>)
         {
-            if (current->m_left == nullptr)
-            {
-                temp = current->m_right;
-
-                traits::destroy(this->m_alloc, std::to_address(current));
-                traits::deallocate(this->m_alloc, std::to_address(current), 1UL);
-            }
-            else
-            {
-                temp = current->m_left;
-                current->m_left = temp->m_right;
-                temp->m_right = current;
-            }
-
-            current = temp;
+            this->m_root = nullptr;
+            this->m_size = 0UL;
+            return;
         }
 
+        this->__M_destroy(this->m_root);
+
         this->m_root = nullptr;
         this->m_size = 0UL;
     }
@@ -361,6 +560,38 @@ public:
         return this->m_size;
     }
 
+    // Get a copy of the allocator, rebound back to the value type
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+    // Get a copy of the comparator ordering the elements
+    [[nodiscard]] constexpr auto key_comp() const -> key_compare
+    {
+        return this->m_comp;
+    }
+
+    /**
+    * @brief The work counted since construction or the last reset_stats().
+    * @details Every lookup descent (search, contains, bounds, batched search) is recorded with
+    *          its depth, rotations count as rebalances, and node handles, split(), join() and
+    *          unite() as relinks.
+    * @return container_stats The counters, with the bytes of the nodes currently held.
+    */
+    [[nodiscard]] auto stats() const noexcept -> container_stats
+        requires details::stats_recorder<Stats>::enabled
+    {
+        return this->m_stats.snapshot(this->m_size * sizeof(Node));
+    }
+
+    // Zero the counters behind stats()
+    void reset_stats() noexcept
+        requires details::stats_recorder<Stats>::enabled
+    {
+        this->m_stats.reset();
+    }
+
     // Get the maximum value in the tree
     [[nodiscard]] constexpr auto max() const noexcept -> std::optional<Type>
     {
@@ -394,314 +625,1831 @@ public:
     }
 
 public:
-    // Printing functions
+    // Iterator Support
+    // (in-order iterators that walk the m_parent links, so traversal never mutates the tree)
 
-    // Print tree nodes in inorder traversal
-    friend constexpr void print_inorder(const binary_search_tree &tree) noexcept
+    /**
+    * @brief Returns an iterator to the smallest element.
+    * @return An iterator to the smallest element, or end() if the tree is empty.
+    */
+    [[nodiscard]] constexpr auto begin() const noexcept -> iterator
     {
-        if (tree.m_root == nullptr)
-            return;
+        return iterator{__M_leftmost(this->m_root), this};
+    }
 
-        Node *current = tree.m_root;
-        Node *temp = nullptr;
+    /**
+    * @brief Returns a constant iterator to the smallest element.
+    * @return A constant iterator to the smallest element, or cend() if the tree is empty.
+    */
+    [[nodiscard]] constexpr auto cbegin() const noexcept -> const_iterator { return this->begin(); }
 
-        // iterating tree nodes
-        while (current != nullptr)
-        {
-            if (current->m_left == nullptr)
-            {
-                // Print node value
-                std::cout << current->m_data << ' ';
-                // When left child are empty then
-                // visit to right child
-                current = current->m_right;
-            }
-            else
-            {
-                temp = current->m_left;
-                // Find rightmost node which is
-                // equal to current node
-                while ((temp->m_right != nullptr) && (temp->m_right != current))
-                {
-                    // Visit to right subtree
-                    temp = temp->m_right;
-                }
+    /**
+    * @brief Returns an iterator past the largest element.
+    * @return An iterator past the largest element.
+    */
+    [[nodiscard]] constexpr auto end() const noexcept -> iterator { return iterator{nullptr, this}; }
 
-                if (temp->m_right != nullptr)
-                {
-                    // Print node value
-                    std::cout << current->m_data << ' ';
-                    // Unlink
-                    temp->m_right = nullptr;
-                    // Visit to right child
-                    current = current->m_right;
-                }
-                else
+    /**
+    * @brief Returns a constant iterator past the largest element.
+    * @return A constant iterator past the largest element.
+    */
+    [[nodiscard]] constexpr auto cend() const noexcept -> const_iterator { return this->end(); }
+
+    /**
+    * @brief Returns a reverse iterator to the largest element.
+    * @return A reverse iterator to the largest element.
+    */
+    [[nodiscard]] constexpr auto rbegin() const noexcept -> reverse_iterator { return reverse_iterator{this->end()}; }
+
+    /**
+    * @brief Returns a constant reverse iterator to the largest element.
+    * @return A constant reverse iterator to the largest element.
+    */
+    [[nodiscard]] constexpr auto crbegin() const noexcept -> const_reverse_iterator { return this->rbegin(); }
+
+    /**
+    * @brief Returns a reverse iterator past the smallest element.
+    * @return A reverse iterator past the smallest element.
+    */
+    [[nodiscard]] constexpr auto rend() const noexcept -> reverse_iterator { return reverse_iterator{this->begin()}; }
+
+    /**
+    * @brief Returns a constant reverse iterator past the smallest element.
+    * @return A constant reverse iterator past the smallest element.
+    */
+    [[nodiscard]] constexpr auto crend() const noexcept -> const_reverse_iterator { return this->rend(); }
+
+public:
+    // Range queries
+
+    /**
+    * @brief Finds the first element not less than `key`, in O(height).
+    * @param key The key to compare against.
+    * @return An iterator to the element, or end() if every element is less than `key`.
+    */
+    [[nodiscard]] constexpr auto lower_bound(const Type &key) const noexcept -> const_iterator
+    {
+        return const_iterator{this->__M_lower_bound(key), this};
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto lower_bound(const Key &key) const noexcept -> const_iterator
+    {
+        return const_iterator{this->__M_lower_bound(key), this};
+    }
+
+    /**
+    * @brief Finds the first element greater than `key`, in O(height).
+    * @param key The key to compare against.
+    * @return An iterator to the element, or end() if no element is greater than `key`.
+    */
+    [[nodiscard]] constexpr auto upper_bound(const Type &key) const noexcept -> const_iterator
+    {
+        return const_iterator{this->__M_upper_bound(key), this};
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto upper_bound(const Key &key) const noexcept -> const_iterator
+    {
+        return const_iterator{this->__M_upper_bound(key), this};
+    }
+
+    /**
+    * @brief Finds the range of elements equivalent to `key`.
+    * @param key The key to compare against.
+    * @return The pair {lower_bound(key), upper_bound(key)}.
+    */
+    [[nodiscard]] constexpr auto equal_range(const Type &key) const noexcept
+        -> std::pair<const_iterator, const_iterator>
+    {
+        return {this->lower_bound(key), this->upper_bound(key)};
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto equal_range(const Key &key) const noexcept
+        -> std::pair<const_iterator, const_iterator>
+    {
+        return {this->lower_bound(key), this->upper_bound(key)};
+    }
+
+public:
+    // Order statistics
+    // Available with the order_statistics augmentation; each query descends once, in O(height).
+
+    /**
+    * @brief The number of elements ordered before `key`.
+    * @details That is the position lower_bound(key) would have in an in-order walk.
+    */
+    [[nodiscard]] constexpr auto rank(const Type &key) const noexcept -> size_type
+        requires is_ranked
+    {
+        return this->__M_rank(key);
+    }
+
+    template <class Key>
+        requires(details::transparent_comparator<Compare> && is_ranked)
+    [[nodiscard]] constexpr auto rank(const Key &key) const noexcept -> size_type
+    {
+        return this->__M_rank(key);
+    }
+
+    /**
+    * @brief The element at in-order position `index` (0 for the smallest).
+    * @return const_iterator The element, or end() if index >= size().
+    */
+    [[nodiscard]] constexpr auto select(size_type index) const noexcept -> const_iterator
+        requires is_ranked
+    {
+        if (index >= this->m_size)
+            return this->end();
+
+        const Node *current = this->m_root;
+
+        while (true)
+        {
+            __M_prefetch_children(current);
+
+            auto left = __M_count(current->m_left);
+
+            if (index < left)
+            {
+                current = current->m_left;
+            }
+            else if (index == left)
+            {
+                return const_iterator{current, this};
+            }
+            else
+            {
+                index = index - left - 1UL;
+                current = current->m_right;
+            }
+        }
+    }
+
+    /**
+    * @brief The number of elements in the half-open range [lower, upper).
+    * @details Adjacent ranges sharing a bound never count an element twice; an empty or
+    *          inverted range counts 0.
+    */
+    [[nodiscard]] constexpr auto count_range(const Type &lower, const Type &upper) const noexcept -> size_type
+        requires is_ranked
+    {
+        return this->__M_count_range(lower, upper);
+    }
+
+    template <class Key>
+        requires(details::transparent_comparator<Compare> && is_ranked)
+    [[nodiscard]] constexpr auto count_range(const Key &lower, const Key &upper) const noexcept -> size_type
+    {
+        return this->__M_count_range(lower, upper);
+    }
+
+public:
+    // Set algebra
+    // These relink the nodes of both trees instead of copying elements, so `other` is left
+    // empty and must use an equal allocator. Built on split/join, the operations take
+    // O(m log(n/m + 1)) comparisons for trees of sizes m <= n under avl_policy; without
+    // balancing, split and join cost O(height). Comparisons must not throw.
+
+    /**
+    * @brief Moves every element not less than `key` into a new tree.
+    * @param key The splitting key.
+    * @return binary_search_tree The elements in [key, ...); this tree keeps those below `key`.
+    * @details O(height) relinking plus O(min(k, n - k)) to recount the two sizes.
+    */
+    [[nodiscard]] constexpr auto split(const Type &key) noexcept -> binary_search_tree
+    {
+        binary_search_tree upper(this->m_comp, allocator_type(this->m_alloc));
+
+        auto [lower, higher] = this->__M_split(this->m_root, key, nullptr);
+
+        this->m_root = __M_orphan(lower);
+        upper.m_root = __M_orphan(higher);
+
+        upper.m_size = __M_count_first(upper.m_root, this->m_root, this->m_size);
+        this->m_size = this->m_size - upper.m_size;
+
+        upper.m_stats.relinked();
+
+        return upper;
+    }
+
+    /**
+    * @brief Appends the elements of `other`, which must all be greater than or
+    *        equivalent to the largest element of this tree, in O(height).
+    * @param other The tree to join; left empty.
+    */
+    constexpr void join(binary_search_tree &other) noexcept
+    {
+        assert(this->__M_compatible(other));
+        assert(this->empty() || other.empty() || not std::invoke(this->m_comp, *other.begin(), *std::ranges::prev(this->end())));
+
+        if (this == std::addressof(other))
+            return;
+
+        this->m_stats.relinked();
+
+        this->m_root = __M_orphan(this->__M_join2(this->m_root, std::exchange(other.m_root, nullptr)));
+        this->m_size = this->m_size + std::exchange(other.m_size, 0UL);
+    }
+
+    constexpr void join(binary_search_tree &&other) noexcept { this->join(other); }
+
+    /**
+    * @brief Adds the elements of `other` that have no equivalent in this tree.
+    * @details Elements of `other` equivalent to one of this tree are destroyed.
+    * @param other The tree to merge from; left empty.
+    */
+    constexpr void unite(binary_search_tree &other) noexcept { this->__M_unite(other, 0); }
+
+    constexpr void unite(binary_search_tree &&other) noexcept { this->unite(other); }
+
+    /**
+    * @brief Parallel unite(), recursing into the two halves concurrently at the top levels.
+    * @param policy The parallelism to use.
+    * @param other The tree to merge from; left empty.
+    */
+    void unite(parallel_t policy, binary_search_tree &other) noexcept
+    {
+        this->__M_unite(other, __M_fork_depth(policy));
+    }
+
+    /**
+    * @brief Keeps only the elements that have an equivalent in `other`.
+    * @param other The tree to intersect with; its nodes are destroyed.
+    */
+    constexpr void intersect(binary_search_tree &other) noexcept { this->__M_filter_by(other, true, 0); }
+
+    constexpr void intersect(binary_search_tree &&other) noexcept { this->intersect(other); }
+
+    /**
+    * @brief Parallel intersect(), recursing into the two halves concurrently at the top levels.
+    * @param policy The parallelism to use.
+    * @param other The tree to intersect with; its nodes are destroyed.
+    */
+    void intersect(parallel_t policy, binary_search_tree &other) noexcept
+    {
+        this->__M_filter_by(other, true, __M_fork_depth(policy));
+    }
+
+    /**
+    * @brief Removes the elements that have an equivalent in `other`.
+    * @param other The tree to subtract; its nodes are destroyed.
+    */
+    constexpr void subtract(binary_search_tree &other) noexcept { this->__M_filter_by(other, false, 0); }
+
+    constexpr void subtract(binary_search_tree &&other) noexcept { this->subtract(other); }
+
+    /**
+    * @brief Parallel subtract(), recursing into the two halves concurrently at the top levels.
+    * @param policy The parallelism to use.
+    * @param other The tree to subtract; its nodes are destroyed.
+    */
+    void subtract(parallel_t policy, binary_search_tree &other) noexcept
+    {
+        this->__M_filter_by(other, false, __M_fork_depth(policy));
+    }
+
+public:
+    // Parallel bulk operations
+
+    /**
+    * @brief Copies the tree, cloning the subtrees below the top levels on separate threads.
+    * @param policy The parallelism to use.
+    * @return binary_search_tree A tree of the same shape, using a copy of this allocator.
+    */
+    [[nodiscard]] auto clone(parallel_t policy) const -> binary_search_tree
+    {
+        binary_search_tree copy(this->m_comp, traits::select_on_container_copy_construction(this->m_alloc));
+
+        copy.m_root = copy.__M_clone_parallel(this->m_root, __M_fork_depth(policy));
+        copy.m_size = this->m_size;
+
+        return copy;
+    }
+
+    /**
+    * @brief Visits every element, splitting the top levels of the tree across threads.
+    * @details The visitor is copied into each task and invoked concurrently on different
+    *          elements, in no particular order. If any invocation throws, one of the
+    *          exceptions is rethrown once every task has finished.
+    * @param policy The parallelism to use.
+    * @param tree The tree to traverse.
+    * @param visitor The callable invoked with each element.
+    */
+    template <class Visitor>
+        requires std::conjunction<
+            std::bool_constant<std::invocable<Visitor &, const Type &>>,
+            std::bool_constant<std::copy_constructible<Visitor>>
+        >::value
+    friend void for_each(parallel_t policy, const binary_search_tree &tree, Visitor visitor)
+    {
+        __M_for_each_parallel(static_cast<const Node *>(tree.m_root), visitor, __M_fork_depth(policy));
+    }
+
+public:
+    // Traversals
+    // Each walk follows the m_parent links: it never mutates the tree, needs no stack and
+    // inlines the visitor. A visitor returning a value convertible to bool stops the walk
+    // as soon as it returns false; each function returns whether every node was visited.
+
+    /**
+    * @brief Visits every element in ascending order.
+    * @param tree The tree to traverse.
+    * @param visitor The callable invoked with each element.
+    * @return bool False if the visitor stopped the walk early.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    friend constexpr auto for_each_inorder(const binary_search_tree &tree, Visitor visitor) -> bool
+    {
+        return __M_walk(__M_leftmost(static_cast<const Node *>(tree.m_root)), &__M_inorder_next, visitor);
+    }
+
+    /**
+    * @brief Visits every element, each node before its subtrees.
+    * @param tree The tree to traverse.
+    * @param visitor The callable invoked with each element.
+    * @return bool False if the visitor stopped the walk early.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    friend constexpr auto for_each_preorder(const binary_search_tree &tree, Visitor visitor) -> bool
+    {
+        return __M_walk(static_cast<const Node *>(tree.m_root), &__M_preorder_next, visitor);
+    }
+
+    /**
+    * @brief Visits every element, each node after its subtrees.
+    * @param tree The tree to traverse.
+    * @param visitor The callable invoked with each element.
+    * @return bool False if the visitor stopped the walk early.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    friend constexpr auto for_each_postorder(const binary_search_tree &tree, Visitor visitor) -> bool
+    {
+        return __M_walk(__M_first_leaf(static_cast<const Node *>(tree.m_root)), &__M_postorder_next, visitor);
+    }
+
+    /**
+    * @brief Copies the elements in ascending order into `buffer`, handing each filled
+    *        chunk (and the final partial one) to `sink`.
+    * @param tree The tree to traverse.
+    * @param buffer The caller-supplied, non-empty staging buffer.
+    * @param sink The callable invoked with each chunk; may stop the walk by returning false.
+    * @return bool False if the sink stopped the walk early.
+    */
+    template <class Sink>
+        requires std::conjunction<
+            std::bool_constant<std::invocable<Sink &, std::span<const Type>>>,
+            std::bool_constant<std::copyable<Type>>
+        >::value
+    friend constexpr auto for_each_inorder(const binary_search_tree &tree, std::span<Type> buffer, Sink sink) -> bool
+    {
+        return __M_walk_batched(__M_leftmost(static_cast<const Node *>(tree.m_root)), &__M_inorder_next, buffer, sink);
+    }
+
+    /**
+    * @brief Batched preorder walk, see the inorder overload.
+    */
+    template <class Sink>
+        requires std::conjunction<
+            std::bool_constant<std::invocable<Sink &, std::span<const Type>>>,
+            std::bool_constant<std::copyable<Type>>
+        >::value
+    friend constexpr auto for_each_preorder(const binary_search_tree &tree, std::span<Type> buffer, Sink sink) -> bool
+    {
+        return __M_walk_batched(static_cast<const Node *>(tree.m_root), &__M_preorder_next, buffer, sink);
+    }
+
+    /**
+    * @brief Batched postorder walk, see the inorder overload.
+    */
+    template <class Sink>
+        requires std::conjunction<
+            std::bool_constant<std::invocable<Sink &, std::span<const Type>>>,
+            std::bool_constant<std::copyable<Type>>
+        >::value
+    friend constexpr auto for_each_postorder(const binary_search_tree &tree, std::span<Type> buffer, Sink sink) -> bool
+    {
+        return __M_walk_batched(__M_first_leaf(static_cast<const Node *>(tree.m_root)), &__M_postorder_next, buffer, sink);
+    }
+
+public:
+    // Printing functions
+    // Thin wrappers over the traversals, writing space-separated elements to `os`
+
+    // Print tree nodes in inorder traversal
+    friend void print_inorder(const binary_search_tree &tree, std::ostream &os = std::cout)
+    {
+        for_each_inorder(tree, [&os](const Type &data) { os << data << ' '; });
+    }
+
+    // Print tree nodes in preorder traversal
+    friend void print_preorder(const binary_search_tree &tree, std::ostream &os = std::cout)
+    {
+        for_each_preorder(tree, [&os](const Type &data) { os << data << ' '; });
+    }
+
+    // Print tree nodes in postorder traversal
+    friend void print_postorder(const binary_search_tree &tree, std::ostream &os = std::cout)
+    {
+        for_each_postorder(tree, [&os](const Type &data) { os << data << ' '; });
+    }
+
+    // Swap
+    // Swap function
+
+    /**
+    * @brief Swaps the contents of two binary search trees.
+    * @param lhs The first binary search tree.
+    * @param rhs The second binary search tree.
+    */
+    friend constexpr void swap(binary_search_tree &lhs, binary_search_tree &rhs)
+            noexcept(std::disjunction<typename traits::propagate_on_container_swap,
+                                        typename traits::is_always_equal>{})
+    {
+        if constexpr (typename traits::propagate_on_container_swap{})
+        {
+            std::swap(lhs.m_alloc, rhs.m_alloc);
+        }
+        std::swap(lhs.m_root, rhs.m_root);
+        std::swap(lhs.m_size, rhs.m_size);
+        std::swap(lhs.m_comp, rhs.m_comp);
+    }
+
+public:
+    // Destructor
+    /**
+    * @brief Destructor. Clears the binary search tree.
+    */
+    constexpr ~binary_search_tree() { this->clear(); }
+
+private:
+    // Private member functions
+
+    /**
+    * @brief Starts loading both children of `node`, one of which a descent visits next.
+    * @details Issued before comparing against the node, so the child's cache miss overlaps
+    *          the comparison instead of following it.
+    */
+    template <class NodePtr>
+    static constexpr void __M_prefetch_children(NodePtr node) noexcept
+    {
+        details::prefetch(node->m_left);
+        details::prefetch(node->m_right);
+    }
+
+    /**
+    * @brief Finds the smallest node of a subtree.
+    * @param node The root of the subtree, may be null.
+    * @return NodePtr The leftmost node, or null for an empty subtree.
+    */
+    template <class NodePtr>
+    [[nodiscard]] static constexpr auto __M_leftmost(NodePtr node) noexcept -> NodePtr
+    {
+        if (node != nullptr)
+        {
+            while (node->m_left != nullptr)
+                node = node->m_left;
+        }
+
+        return node;
+    }
+
+    /**
+    * @brief Finds the largest node of a subtree.
+    * @param node The root of the subtree, may be null.
+    * @return NodePtr The rightmost node, or null for an empty subtree.
+    */
+    template <class NodePtr>
+    [[nodiscard]] static constexpr auto __M_rightmost(NodePtr node) noexcept -> NodePtr
+    {
+        if (node != nullptr)
+        {
+            while (node->m_right != nullptr)
+                node = node->m_right;
+        }
+
+        return node;
+    }
+
+    /**
+    * @brief Finds the first node of a subtree in postorder: its leftmost-deepest leaf.
+    * @param node The root of the subtree, may be null.
+    * @return const Node* The first node, or null for an empty subtree.
+    */
+    [[nodiscard]] static constexpr auto __M_first_leaf(const Node *node) noexcept -> const Node *
+    {
+        while (node != nullptr)
+        {
+            if (node->m_left != nullptr)
+                node = node->m_left;
+            else if (node->m_right != nullptr)
+                node = node->m_right;
+            else
+                break;
+        }
+
+        return node;
+    }
+
+    /**
+    * @brief In-order successor of a node, null after the largest.
+    */
+    [[nodiscard]] static constexpr auto __M_inorder_next(const Node *node) noexcept -> const Node *
+    {
+        if (node->m_right != nullptr)
+            return __M_leftmost(static_cast<const Node *>(node->m_right));
+
+        auto parent = node->m_parent;
+
+        while ((parent != nullptr) && (node == parent->m_right))
+        {
+            node = parent;
+            parent = parent->m_parent;
+        }
+
+        return parent;
+    }
+
+    /**
+    * @brief Preorder successor of a node, null after the last.
+    */
+    [[nodiscard]] static constexpr auto __M_preorder_next(const Node *node) noexcept -> const Node *
+    {
+        if (node->m_left != nullptr)
+            return node->m_left;
+
+        if (node->m_right != nullptr)
+            return node->m_right;
+
+        for (auto parent = node->m_parent; parent != nullptr; node = parent, parent = parent->m_parent)
+        {
+            if ((node == parent->m_left) && (parent->m_right != nullptr))
+                return parent->m_right;
+        }
+
+        return nullptr;
+    }
+
+    /**
+    * @brief Postorder successor of a node, null after the root.
+    */
+    [[nodiscard]] static constexpr auto __M_postorder_next(const Node *node) noexcept -> const Node *
+    {
+        auto parent = node->m_parent;
+
+        if ((parent == nullptr) || (node == parent->m_right) || (parent->m_right == nullptr))
+            return parent;
+
+        return __M_first_leaf(static_cast<const Node *>(parent->m_right));
+    }
+
+    /**
+    * @brief Invokes a visitor, treating a void result as "continue".
+    * @return bool False if the visitor asked to stop.
+    */
+    template <class Visitor, class Arg>
+    static constexpr auto __M_visit(Visitor &visitor, Arg &&arg) -> bool
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<Visitor &, Arg>>)
+        {
+            std::invoke(visitor, std::forward<Arg>(arg));
+            return true;
+        }
+        else
+        {
+            return static_cast<bool>(std::invoke(visitor, std::forward<Arg>(arg)));
+        }
+    }
+
+    /**
+    * @brief Visits the nodes from `node` onwards in the order given by `next`.
+    * @return bool False if the visitor stopped the walk early.
+    */
+    template <class Visitor>
+    static constexpr auto __M_walk(const Node *node, const Node *(*next)(const Node *) noexcept,
+                                   Visitor &visitor) -> bool
+    {
+        for (; node != nullptr; node = next(node))
+        {
+            if (not __M_visit(visitor, std::as_const(node->m_data)))
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+    * @brief Walks like __M_walk, staging elements in `buffer` and flushing full chunks to `sink`.
+    * @return bool False if the sink stopped the walk early.
+    */
+    template <class Sink>
+    static constexpr auto __M_walk_batched(const Node *node, const Node *(*next)(const Node *) noexcept,
+                                           std::span<Type> buffer, Sink &sink) -> bool
+    {
+        assert(not buffer.empty());
+
+        size_type used = 0UL;
+
+        auto stage = [&](const Type &data) -> bool {
+            buffer[used++] = data;
+
+            if (used != buffer.size())
+                return true;
+
+            return __M_visit(sink, std::span<const Type>(buffer.data(), std::exchange(used, 0UL)));
+        };
+
+        if (not __M_walk(node, next, stage))
+            return false;
+
+        return (used == 0UL) || __M_visit(sink, std::span<const Type>(buffer.data(), used));
+    }
+
+    /**
+    * @brief Destroys and deallocates every node of a subtree in O(n) without recursion.
+    * @details Right rotations flatten the subtree into a chain as it is consumed.
+    * @param current The root of the subtree, may be null.
+    * @return size_type The number of nodes destroyed.
+    */
+    constexpr auto __M_destroy(Node *current) noexcept -> size_type
+    {
+        Node *temp = nullptr;
+        size_type count = 0UL;
+
+        while (current != nullptr)
+        {
+            if (current->m_left == nullptr)
+            {
+                temp = current->m_right;
+
+                traits::destroy(this->m_alloc, std::to_address(current));
+                traits::deallocate(this->m_alloc, std::to_address(current), 1UL);
+                this->m_stats.deallocated();
+
+                count = count + 1UL;
+            }
+            else
+            {
+                temp = current->m_left;
+                current->m_left = temp->m_right;
+                temp->m_right = current;
+            }
+
+            current = temp;
+        }
+
+        return count;
+    }
+
+    /**
+    * @brief Number of tree levels at which the parallel operations still fork.
+    * @details Each level doubles the number of tasks, so forking stops once there is
+    *          a task per thread.
+    */
+    [[nodiscard]] static auto __M_fork_depth(parallel_t policy) noexcept -> int
+    {
+        auto threads = (policy.m_threads != 0U) ? policy.m_threads : std::thread::hardware_concurrency();
+
+        int depth = 0;
+
+        for (; (1U << depth) < threads; ++depth)
+        {
+        }
+
+        return depth;
+    }
+
+    /**
+    * @brief Links `left` and `right` below `root` and refreshes its height.
+    * @return Node* The root, whose m_parent is left null.
+    */
+    static constexpr auto __M_attach(Node *root, Node *left, Node *right) noexcept -> Node *
+    {
+        root->m_left = left;
+        root->m_right = right;
+
+        if (left != nullptr)
+            left->m_parent = root;
+
+        if (right != nullptr)
+            right->m_parent = root;
+
+        __M_update(root);
+
+        return root;
+    }
+
+    /**
+    * @brief Whether nodes of `other` may be relinked into this tree.
+    */
+    [[nodiscard]] constexpr auto __M_compatible(const binary_search_tree &other) const noexcept -> bool
+    {
+        if constexpr (typename traits::is_always_equal{})
+        {
+            return true;
+        }
+        else
+        {
+            return (this->m_alloc == other.m_alloc);
+        }
+    }
+
+    /**
+    * @brief Clears the parent link of a subtree root, making it a tree root.
+    */
+    static constexpr auto __M_orphan(Node *root) noexcept -> Node *
+    {
+        if (root != nullptr)
+            root->m_parent = nullptr;
+
+        return root;
+    }
+
+    /**
+    * @brief Detaches both children of `node`.
+    * @return std::pair<Node*, Node*> The former left and right subtrees, as roots.
+    */
+    static constexpr auto __M_expose(Node *node) noexcept -> std::pair<Node *, Node *>
+    {
+        return {__M_orphan(std::exchange(node->m_left, nullptr)),
+                __M_orphan(std::exchange(node->m_right, nullptr))};
+    }
+
+    /**
+    * @brief Rotates a detached subtree to the left, returning its new root.
+    */
+    static constexpr auto __M_lift_right(Node *node) noexcept -> Node *
+    {
+        auto pivot = node->m_right;
+
+        return __M_attach(pivot, __M_attach(node, node->m_left, pivot->m_left), pivot->m_right);
+    }
+
+    /**
+    * @brief Rotates a detached subtree to the right, returning its new root.
+    */
+    static constexpr auto __M_lift_left(Node *node) noexcept -> Node *
+    {
+        auto pivot = node->m_left;
+
+        return __M_attach(pivot, pivot->m_left, __M_attach(node, pivot->m_right, node->m_right));
+    }
+
+    /**
+    * @brief Joins `left`, `middle` and `right`, where every element of `left` orders before
+    *        `middle` and every element of `right` after it.
+    * @details Under avl_policy the shorter side is hung on the spine of the taller one at the
+    *          matching height and rebalanced on the way up, in O(|height difference|).
+    * @return Node* The root of the joined subtree.
+    */
+    static constexpr auto __M_join(Node *left, Node *middle, Node *right) noexcept -> Node *
+    {
+        if constexpr (is_balanced)
+        {
+            if (__M_height(left) > __M_height(right) + 1)
+                return __M_join_right(left, middle, right);
+
+            if (__M_height(right) > __M_height(left) + 1)
+                return __M_join_left(left, middle, right);
+        }
+
+        return __M_attach(middle, left, right);
+    }
+
+    /**
+    * @brief __M_join() when `left` is the taller side: descends its right spine.
+    */
+    static constexpr auto __M_join_right(Node *left, Node *middle, Node *right) noexcept -> Node *
+    {
+        auto inner = left->m_right;
+
+        if (__M_height(inner) <= __M_height(right) + 1)
+        {
+            auto joined = __M_attach(middle, inner, right);
+
+            if (__M_height(joined) <= __M_height(left->m_left) + 1)
+                return __M_attach(left, left->m_left, joined);
+
+            return __M_lift_right(__M_attach(left, left->m_left, __M_lift_left(joined)));
+        }
+
+        auto joined = __M_join_right(inner, middle, right);
+        auto root = __M_attach(left, left->m_left, joined);
+
+        if (__M_height(joined) <= __M_height(root->m_left) + 1)
+            return root;
+
+        return __M_lift_right(root);
+    }
+
+    /**
+    * @brief __M_join() when `right` is the taller side: descends its left spine.
+    */
+    static constexpr auto __M_join_left(Node *left, Node *middle, Node *right) noexcept -> Node *
+    {
+        auto inner = right->m_left;
+
+        if (__M_height(inner) <= __M_height(left) + 1)
+        {
+            auto joined = __M_attach(middle, left, inner);
+
+            if (__M_height(joined) <= __M_height(right->m_right) + 1)
+                return __M_attach(right, joined, right->m_right);
+
+            return __M_lift_left(__M_attach(right, __M_lift_right(joined), right->m_right));
+        }
+
+        auto joined = __M_join_left(left, middle, inner);
+        auto root = __M_attach(right, joined, right->m_right);
+
+        if (__M_height(joined) <= __M_height(root->m_right) + 1)
+            return root;
+
+        return __M_lift_left(root);
+    }
+
+    /**
+    * @brief Detaches the largest node of a subtree.
+    * @return std::pair<Node*, Node*> The remaining subtree and the detached node.
+    */
+    static constexpr auto __M_split_last(Node *root) noexcept -> std::pair<Node *, Node *>
+    {
+        auto [left, right] = __M_expose(root);
+
+        if (right == nullptr)
+            return {left, root};
+
+        auto [rest, last] = __M_split_last(right);
+
+        return {__M_join(left, root, rest), last};
+    }
+
+    /**
+    * @brief Joins two subtrees where every element of `left` orders before those of `right`.
+    */
+    static constexpr auto __M_join2(Node *left, Node *right) noexcept -> Node *
+    {
+        if (left == nullptr)
+            return right;
+
+        if (right == nullptr)
+            return left;
+
+        auto [rest, last] = __M_split_last(left);
+
+        return __M_join(rest, last, right);
+    }
+
+    /**
+    * @brief Splits a subtree into the elements less than `key` and the others.
+    * @param dropped If not null, elements equivalent to `key` are destroyed instead and
+    *                counted here, so the second part holds only the greater elements.
+    * @return std::pair<Node*, Node*> The lower and the upper subtree.
+    */
+    constexpr auto __M_split(Node *root, const Type &key, size_type *dropped) noexcept
+        -> std::pair<Node *, Node *>
+    {
+        if (root == nullptr)
+            return {nullptr, nullptr};
+
+        auto [left, right] = __M_expose(root);
+
+        if (this->__M_compare(root->m_data, key))
+        {
+            auto [lower, upper] = this->__M_split(right, key, dropped);
+            return {__M_join(left, root, lower), upper};
+        }
+
+        if ((dropped == nullptr) || this->__M_compare(key, root->m_data))
+        {
+            auto [lower, upper] = this->__M_split(left, key, dropped);
+            return {lower, __M_join(upper, root, right)};
+        }
+
+        auto lower = this->__M_split(left, key, dropped).first;
+        auto upper = this->__M_split(right, key, dropped).second;
+
+        *dropped = *dropped + this->__M_destroy(root);
+
+        return {lower, upper};
+    }
+
+    /**
+    * @brief Counts the nodes of `lhs` given that both trees hold `total` nodes together.
+    * @details Both in-order walks advance in lockstep and stop with the shorter one,
+    *          so the cost is linear in the smaller tree only; with order statistics the
+    *          root of `lhs` already knows.
+    */
+    [[nodiscard]] static constexpr auto __M_count_first(const Node *lhs, const Node *rhs, size_type total) noexcept
+        -> size_type
+    {
+        if constexpr (is_ranked)
+            return __M_count(lhs);
+
+        size_type count = 0UL;
+
+        for (lhs = __M_leftmost(lhs), rhs = __M_leftmost(rhs); (lhs != nullptr) && (rhs != nullptr);
+             lhs = __M_inorder_next(lhs), rhs = __M_inorder_next(rhs))
+        {
+            count = count + 1UL;
+        }
+
+        return (lhs == nullptr) ? count : total - count;
+    }
+
+    /**
+    * @brief Runs two recursive halves, the first on another thread while `depth` remains.
+    * @return std::pair<Node*, Node*> The results of `lhs` and `rhs`.
+    */
+    template <class Lhs, class Rhs>
+    static constexpr auto __M_fork(int depth, Lhs lhs, Rhs rhs) -> std::pair<Node *, Node *>
+    {
+        if (depth <= 0)
+        {
+            auto first = lhs();
+            return {first, rhs()};
+        }
+
+        auto first = std::async(std::launch::async | std::launch::deferred, std::move(lhs));
+        auto second = rhs();
+
+        return {first.get(), second};
+    }
+
+    /**
+    * @brief Shared body of the unite() overloads.
+    */
+    constexpr void __M_unite(binary_search_tree &other, int depth) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        if (this == std::addressof(other))
+            return;
+
+        size_type dropped = 0UL;
+
+        this->m_stats.relinked();
+
+        this->m_root = __M_orphan(this->__M_union(this->m_root, std::exchange(other.m_root, nullptr), dropped, depth));
+        this->m_size = this->m_size + std::exchange(other.m_size, 0UL) - dropped;
+    }
+
+    /**
+    * @brief Union of two subtrees: `lhs` is split around by each of its roots in turn.
+    * @param dropped Incremented for every node of `rhs` destroyed as a duplicate.
+    */
+    constexpr auto __M_union(Node *lhs, Node *rhs, size_type &dropped, int depth) noexcept -> Node *
+    {
+        if (lhs == nullptr)
+            return rhs;
+
+        if (rhs == nullptr)
+            return lhs;
+
+        auto [lhs_left, lhs_right] = __M_expose(lhs);
+        auto [rhs_left, rhs_right] = this->__M_split(rhs, lhs->m_data, &dropped);
+
+        size_type right_dropped = 0UL;
+
+        auto [left, right] = __M_fork(
+            depth,
+            [this, &dropped, depth, a = lhs_left, b = rhs_left] { return this->__M_union(a, b, dropped, depth - 1); },
+            [this, &right_dropped, depth, a = lhs_right, b = rhs_right] {
+                return this->__M_union(a, b, right_dropped, depth - 1);
+            });
+
+        dropped = dropped + right_dropped;
+
+        return __M_join(left, lhs, right);
+    }
+
+    // Key of an ancestor bounding a subtree, and whether `other` holds an equivalent of it.
+    // Equivalent elements may sit on both sides of a node, so the verdict for a key is
+    // passed down to the descendants that can still be equivalent to it.
+    struct Bound final
+    {
+        const Type *m_key{nullptr};
+        bool m_found{false};
+    };
+
+    /**
+    * @brief Shared body of the intersect() and subtract() overloads.
+    * @param keep_found Whether to keep (intersect) or drop (subtract) elements found in `other`.
+    */
+    constexpr void __M_filter_by(binary_search_tree &other, bool keep_found, int depth) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        if (this == std::addressof(other))
+        {
+            if (not keep_found)
+                this->clear();
+            return;
+        }
+
+        size_type removed = 0UL;
+
+        this->m_root = __M_orphan(this->__M_filter(this->m_root, std::exchange(other.m_root, nullptr),
+                                                   Bound{}, Bound{}, keep_found, removed, depth));
+        this->m_size = this->m_size - removed;
+
+        other.m_size = 0UL;
+    }
+
+    /**
+    * @brief Keeps the nodes of `lhs` whose presence in `rhs` equals `keep_found`; all of `rhs`
+    *        is destroyed.
+    * @param lower The bound to the left of this subtree.
+    * @param upper The bound to the right of this subtree.
+    * @param removed Incremented for every node of `lhs` destroyed.
+    */
+    constexpr auto __M_filter(Node *lhs, Node *rhs, Bound lower, Bound upper, bool keep_found,
+                              size_type &removed, int depth) noexcept -> Node *
+    {
+        if (lhs == nullptr)
+        {
+            this->__M_destroy(rhs);
+            return nullptr;
+        }
+
+        if (rhs == nullptr)
+        {
+            // Only elements equivalent to a bound can still be found
+            lower.m_found = lower.m_found && not this->__M_compare(*lower.m_key, __M_leftmost(lhs)->m_data);
+            upper.m_found = upper.m_found && not this->__M_compare(__M_rightmost(lhs)->m_data, *upper.m_key);
+
+            if (not lower.m_found && not upper.m_found)
+            {
+                if (keep_found)
+                    removed = removed + this->__M_destroy(lhs);
+
+                return keep_found ? nullptr : lhs;
+            }
+        }
+
+        auto [lhs_left, lhs_right] = __M_expose(lhs);
+
+        size_type dropped = 0UL;
+
+        auto [rhs_left, rhs_right] = this->__M_split(rhs, lhs->m_data, &dropped);
+
+        bool found = (dropped != 0UL)
+                     || (lower.m_found && not this->__M_compare(*lower.m_key, lhs->m_data))
+                     || (upper.m_found && not this->__M_compare(lhs->m_data, *upper.m_key));
+
+        Bound middle{std::addressof(lhs->m_data), found};
+
+        size_type right_removed = 0UL;
+
+        auto [left, right] = __M_fork(
+            depth,
+            [&, a = lhs_left, b = rhs_left] {
+                return this->__M_filter(a, b, lower, middle, keep_found, removed, depth - 1);
+            },
+            [&, a = lhs_right, b = rhs_right] {
+                return this->__M_filter(a, b, middle, upper, keep_found, right_removed, depth - 1);
+            });
+
+        removed = removed + right_removed;
+
+        if (found == keep_found)
+            return __M_join(left, lhs, right);
+
+        removed = removed + this->__M_destroy(lhs);
+
+        return __M_join2(left, right);
+    }
+
+    /**
+    * @brief Builds a balanced subtree from `count` sorted elements, forking the left half
+    *        onto another thread while `depth` remains and the half is large enough to pay off.
+    * @return Node* The root of the subtree, whose m_parent is left null.
+    */
+    template <typename _iterator>
+    auto __M_build_parallel(_iterator first, size_type count, int depth) -> Node *
+    {
+        // Below this many nodes a subtree is cheaper to build than a thread is to start
+        constexpr size_type grain = 4096UL;
+
+        if ((depth == 0) || (count < grain))
+            return this->__M_build_sorted(first, count);
+
+        auto half = count / 2UL;
+
+        auto left = std::async(std::launch::async, [this, first, half, depth] {
+            return this->__M_build_parallel(first, half, depth - 1);
+        });
+
+        Node *root = nullptr;
+        Node *right = nullptr;
+
+        try {
+            root = this->__M_create_node(*(first + static_cast<difference_type>(half)));
+            right = this->__M_build_parallel(first + static_cast<difference_type>(half + 1UL),
+                                             count - half - 1UL, depth - 1);
+        }
+        catch (...) {
+            this->__M_destroy(root);
+
+            try {
+                this->__M_destroy(left.get());
+            }
+            catch (...) {
+            }
+            throw;
+        }
+
+        try {
+            return __M_attach(root, left.get(), right);
+        }
+        catch (...) {
+            this->__M_destroy(root);
+            this->__M_destroy(right);
+            throw;
+        }
+    }
+
+    /**
+    * @brief Clones a subtree, forking the left child onto another thread while `depth` remains.
+    * @return Node* The root of the copy, whose m_parent is left null.
+    */
+    auto __M_clone_parallel(const Node *root, int depth) -> Node *
+    {
+        if ((depth == 0) || (root == nullptr))
+            return this->__M_clone(root);
+
+        auto left = std::async(std::launch::async, [this, root, depth] {
+            return this->__M_clone_parallel(root->m_left, depth - 1);
+        });
+
+        Node *copy = nullptr;
+        Node *right = nullptr;
+
+        try {
+            copy = this->__M_create_node(root->m_data);
+            right = this->__M_clone_parallel(root->m_right, depth - 1);
+        }
+        catch (...) {
+            this->__M_destroy(copy);
+
+            try {
+                this->__M_destroy(left.get());
+            }
+            catch (...) {
+            }
+            throw;
+        }
+
+        try {
+            return __M_attach(copy, left.get(), right);
+        }
+        catch (...) {
+            this->__M_destroy(copy);
+            this->__M_destroy(right);
+            throw;
+        }
+    }
+
+    /**
+    * @brief Visits a subtree, forking the left child onto another thread while `depth` remains.
+    */
+    template <class Visitor>
+    static void __M_for_each_parallel(const Node *root, const Visitor &visitor, int depth)
+    {
+        if (root == nullptr)
+            return;
+
+        if (depth == 0)
+        {
+            auto local = visitor;
+            auto last = __M_rightmost(root);
+
+            for (auto node = __M_leftmost(root);; node = __M_inorder_next(node))
+            {
+                std::invoke(local, std::as_const(node->m_data));
+
+                if (node == last)
+                    break;
+            }
+            return;
+        }
+
+        auto left = std::async(std::launch::async, [root, &visitor, depth] {
+            __M_for_each_parallel(static_cast<const Node *>(root->m_left), visitor, depth - 1);
+        });
+
+        try {
+            auto local = visitor;
+
+            std::invoke(local, std::as_const(root->m_data));
+            __M_for_each_parallel(static_cast<const Node *>(root->m_right), visitor, depth - 1);
+        }
+        catch (...) {
+            left.wait();
+            throw;
+        }
+
+        left.get();
+    }
+
+    /**
+    * @brief Creates a new node with the given arguments.
+    * @tparam ARGS Types of arguments for constructing the node.
+    * @param args Arguments for constructing the node.
+    * @return Node* Pointer to the newly created node.
+    */
+    template <class... ARGS>
+    constexpr Node *__M_create_node(ARGS &&...args)
+    {
+        auto node = traits::allocate(this->m_alloc, 1UL);
+        this->m_stats.allocated();
+        try {
+            traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
+            this->m_stats.deallocated();
+            throw;
+        }
+        return node;
+    }
+
+    /**
+    * @brief Invokes the comparator, counting the comparison under operation_stats.
+    */
+    template <class Lhs, class Rhs>
+    constexpr auto __M_compare(const Lhs &lhs, const Rhs &rhs) const -> bool
+    {
+        this->m_stats.compared();
+        return std::invoke(this->m_comp, lhs, rhs);
+    }
+
+    /**
+    * @brief Search for a value in the tree.
+    * @tparam RType The return type of the search.
+    * @tparam NodePtr The (possibly const) node pointer type.
+    * @param current The current node being examined.
+    * @param key The key to search for.
+    * @return std::optional<RType> An optional containing the found value, if any.
+    */
+    template <class RType, class NodePtr, class Key>
+    constexpr auto __M_search(NodePtr current, const Key &key) const noexcept
+        -> std::optional<RType>
+    {
+        size_type depth = 0UL;
+
+        while (current != nullptr)
+        {
+            __M_prefetch_children(current);
+
+            depth = depth + 1UL;
+
+            if (this->__M_compare(key, std::as_const(current->m_data)))
+                current = current->m_left;
+            else if (this->__M_compare(std::as_const(current->m_data), key))
+                current = current->m_right;
+            else
+                break;
+        }
+
+        this->m_stats.searched(depth);
+
+        if (current == nullptr)
+            return std::nullopt;
+
+        return std::optional<RType>{current->m_data};
+    }
+
+    /**
+    * @brief Search for a batch of keys, interleaving up to search_lanes descents.
+    * @tparam RType The result type written per key.
+    * @tparam NodePtr The (possibly const) node pointer type.
+    * @param root The root of the tree.
+    * @param keys The keys to search for.
+    * @param out The output iterator receiving the results.
+    * @return _iterator The output iterator past the last result.
+    */
+    template <class RType, class NodePtr, class _iterator>
+    constexpr auto __M_search_batch(NodePtr root, std::span<const Type> keys, _iterator out) const -> _iterator
+    {
+        for (size_type base = 0UL; base < keys.size(); base = base + search_lanes)
+        {
+            const auto lanes = std::min(search_lanes, keys.size() - base);
+
+            NodePtr cursor[search_lanes]{};
+            NodePtr found[search_lanes]{};
+            size_type depth[search_lanes]{};
+
+            std::fill_n(cursor, lanes, root);
+
+            for (auto active = (root != nullptr) ? lanes : 0UL; active != 0UL;)
+            {
+                for (size_type lane = 0UL; lane < lanes; ++lane)
                 {
-                    // Change link
-                    temp->m_right = current;
-                    // Visit to right child
-                    current = current->m_left;
+                    auto current = cursor[lane];
+
+                    if (current == nullptr)
+                        continue;
+
+                    const auto &key = keys[base + lane];
+
+                    depth[lane] = depth[lane] + 1UL;
+
+                    if (this->__M_compare(key, std::as_const(current->m_data)))
+                    {
+                        current = current->m_left;
+                    }
+                    else if (this->__M_compare(std::as_const(current->m_data), key))
+                    {
+                        current = current->m_right;
+                    }
+                    else
+                    {
+                        found[lane] = current;
+                        current = nullptr;
+                    }
+
+                    if (current != nullptr)
+                    {
+                        details::prefetch(current);
+                    }
+                    else
+                    {
+                        active = active - 1UL;
+                        this->m_stats.searched(depth[lane]);
+                    }
+
+                    cursor[lane] = current;
                 }
             }
+
+            for (size_type lane = 0UL; lane < lanes; ++lane, ++out)
+            {
+                if (found[lane] != nullptr)
+                    *out = std::optional<RType>{found[lane]->m_data};
+                else
+                    *out = std::optional<RType>{};
+            }
         }
+        return out;
     }
 
-    // Print tree nodes in preorder traversal
-    friend constexpr void print_preorder(const binary_search_tree &tree) noexcept
+    /**
+    * @brief Removes one element equivalent to `key`, if any.
+    * @tparam Key The key type, Type itself unless the comparator is transparent.
+    */
+    template <class Key>
+    constexpr void __M_remove(const Key &key)
     {
-        if (tree.m_root == nullptr)
+        auto current = this->m_root;
+
+        while (current != nullptr)
+        {
+            __M_prefetch_children(current);
+
+            if (this->__M_compare(key, std::as_const(current->m_data)))
+            {
+                current = current->m_left;
+            }
+            else if (this->__M_compare(std::as_const(current->m_data), key))
+            {
+                current = current->m_right;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (current == nullptr)
+        {
             return;
+        }
 
-        Node *current = tree.m_root;
-        Node *temp = nullptr;
+        this->__M_unlink(current);
 
-        // iterating tree nodes
-        while (current != nullptr)
+        traits::destroy(this->m_alloc, std::to_address(current));
+        traits::deallocate(this->m_alloc, std::to_address(current), 1UL);
+        this->m_stats.deallocated();
+    }
+
+    /**
+    * @brief Unlinks the first element equivalent to `key` into a node handle.
+    */
+    template <class Key>
+    constexpr auto __M_extract(const Key &key) noexcept -> node_type
+    {
+        auto found = this->__M_lower_bound(key);
+
+        if ((found == nullptr) || this->__M_compare(key, found->m_data))
+            return node_type{};
+
+        return this->extract(const_iterator{found, this});
+    }
+
+    /**
+    * @brief First node not ordered before `key`, null if none.
+    */
+    template <class Key>
+    [[nodiscard]] constexpr auto __M_lower_bound(const Key &key) const noexcept -> const Node *
+    {
+        const Node *bound = nullptr;
+        size_type depth = 0UL;
+
+        for (const Node *current = this->m_root; current != nullptr;)
         {
-            if (current->m_left == nullptr)
+            __M_prefetch_children(current);
+
+            depth = depth + 1UL;
+
+            if (this->__M_compare(current->m_data, key))
             {
-                // Print node value
-                std::cout << current->m_data << ' ';
-                // Visit to right childs
                 current = current->m_right;
             }
             else
             {
-                temp = current->m_left;
-                // Find rightmost node which is not
-                // equal to current node
-                while ((temp->m_right != nullptr) && (temp->m_right != current))
-                {
-                    // Visit to right subtree
-                    temp = temp->m_right;
-                }
+                bound = current;
+                current = current->m_left;
+            }
+        }
 
-                if (temp->m_right != current)
-                {
-                    // Print node value
-                    std::cout << current->m_data << ' ';
-                    // Connect rightmost right node to current node
-                    temp->m_right = current;
-                    // Visit to left childs
-                    current = current->m_left;
-                }
-                else
-                {
-                    // unlink
-                    temp->m_right = nullptr;
-                    // Visit to right child
-                    current = current->m_right;
-                }
+        this->m_stats.searched(depth);
+
+        return bound;
+    }
+
+    /**
+    * @brief First node ordered after `key`, null if none.
+    */
+    template <class Key>
+    [[nodiscard]] constexpr auto __M_upper_bound(const Key &key) const noexcept -> const Node *
+    {
+        const Node *bound = nullptr;
+        size_type depth = 0UL;
+
+        for (const Node *current = this->m_root; current != nullptr;)
+        {
+            __M_prefetch_children(current);
+
+            depth = depth + 1UL;
+
+            if (this->__M_compare(key, current->m_data))
+            {
+                bound = current;
+                current = current->m_left;
+            }
+            else
+            {
+                current = current->m_right;
             }
         }
+
+        this->m_stats.searched(depth);
+
+        return bound;
     }
 
-    // Print tree nodes in postorder traversal
-    friend constexpr void print_postorder(const binary_search_tree &tree) noexcept
+    /**
+    * @brief Number of elements ordered before `key`, summing the left subtrees passed by.
+    */
+    template <class Key>
+    [[nodiscard]] constexpr auto __M_rank(const Key &key) const noexcept -> size_type
+    {
+        size_type rank = 0UL;
+
+        for (const Node *current = this->m_root; current != nullptr;)
+        {
+            __M_prefetch_children(current);
+
+            if (this->__M_compare(current->m_data, key))
+            {
+                rank = rank + __M_count(current->m_left) + 1UL;
+                current = current->m_right;
+            }
+            else
+            {
+                current = current->m_left;
+            }
+        }
+
+        return rank;
+    }
+
+    /**
+    * @brief Number of elements in [lower, upper), 0 for an inverted range.
+    */
+    template <class Key>
+    [[nodiscard]] constexpr auto __M_count_range(const Key &lower, const Key &upper) const noexcept -> size_type
+    {
+        auto first = this->__M_rank(lower);
+        auto last = this->__M_rank(upper);
+
+        return (first < last) ? last - first : 0UL;
+    }
+
+    /**
+    * @brief Insert a node into the tree.
+    * @param node The node to insert.
+    */
+    constexpr void __M_insert(Node *node)
     {
-        if (tree.m_root == nullptr)
+        if (node == nullptr)
             return;
 
-        // Create a dummy node
-        Node *dummy = new Node();
+        Node *current = this->m_root;
+        Node *parent = nullptr;
+
+        while (current != nullptr)
+        {
+            __M_prefetch_children(current);
+
+            parent = current;
+            if (not this->__M_compare(current->m_data, node->m_data))
+                current = current->m_left;
+            else
+                current = current->m_right;
+        }
+
+        this->__M_link(node, parent,
+                       (parent != nullptr) && not this->__M_compare(parent->m_data, node->m_data));
+    }
+
+    /**
+    * @brief Hangs a new leaf below `parent` (as the root if null) and rebalances.
+    * @param node The node to link.
+    * @param parent The parent found by the descent.
+    * @param is_left Whether the node becomes the left child.
+    */
+    constexpr void __M_link(Node *node, Node *parent, bool is_left) noexcept
+    {
+        __M_update(node);
+
+        node->m_parent = parent;
+
+        if (parent == nullptr)
+            this->m_root = node;
+        else if (is_left)
+            parent->m_left = node;
+        else
+            parent->m_right = node;
 
-        dummy->m_left = tree.m_root;
+        this->m_size = this->m_size + 1UL;
 
-        auto current = dummy;
+        this->__M_rebalance(parent);
+    }
 
-        // Define some useful variables
+    /**
+    * @brief Finds the element equivalent to `key`, or emplaces one from `args` where the
+    *        descent ended, so a lookup-or-insert walks the tree once.
+    * @tparam Key The key type, comparable with Type by the comparator.
+    * @return std::pair<Node*, bool> The node holding the element, and whether it was created.
+    */
+    template <class Key, class... ARGS>
+    constexpr auto __M_find_or_emplace(const Key &key, ARGS &&...args) -> std::pair<Node *, bool>
+    {
+        Node *current = this->m_root;
         Node *parent = nullptr;
-        Node *middle = nullptr;
-        Node *temp = nullptr;
-        Node *back = nullptr;
 
-        // iterating tree nodes
+        bool is_left = false;
+
         while (current != nullptr)
         {
+            __M_prefetch_children(current);
 
-            if (current->m_left == nullptr)
+            parent = current;
+
+            if (this->__M_compare(key, std::as_const(current->m_data)))
+            {
+                current = current->m_left;
+                is_left = true;
+            }
+            else if (this->__M_compare(std::as_const(current->m_data), key))
             {
-                // When left child are empty then
-                // Visit to right child
                 current = current->m_right;
+                is_left = false;
             }
             else
             {
-                // Get to left child
-                temp = current->m_left;
+                return {current, false};
+            }
+        }
 
-                while ((temp->m_right != nullptr) && (temp->m_right != current))
-                {
-                    temp = temp->m_right;
-                }
+        auto node = this->__M_create_node(std::in_place_type<Type>, std::forward<ARGS>(args)...);
 
-                if (temp->m_right != current)
-                {
-                    temp->m_right = current;
-                    current = current->m_left;
-                }
-                else
-                {
-                    parent = current;
-                    middle = current->m_left;
+        this->__M_link(node, parent, is_left);
 
-                    // Update new path
-                    while (middle != current)
-                    {
-                        back = middle->m_right;
-                        middle->m_right = parent;
-                        parent = middle;
-                        middle = back;
-                    }
+        return {node, true};
+    }
 
-                    parent = current;
-                    middle = temp;
+    /**
+    * @brief Detach a node from the tree without destroying it.
+    * @details A node with two children is replaced by its in-order successor,
+    *          relinking nodes rather than copying data so no element is moved.
+    * @param node The node to detach.
+    */
+    constexpr void __M_unlink(Node *node) noexcept
+    {
+        Node *retrace = node->m_parent;
 
-                    // Print the resultant nodes.
-                    // And correct node link in current path
-                    while (middle != current)
-                    {
-                        std::cout << middle->m_data << ' ';
+        if (node->m_left == nullptr)
+        {
+            this->__M_transplant(node, node->m_right);
+        }
+        else if (node->m_right == nullptr)
+        {
+            this->__M_transplant(node, node->m_left);
+        }
+        else
+        {
+            auto successor = node->m_right;
 
-                        back = middle->m_right;
-                        middle->m_right = parent;
-                        parent = middle;
-                        middle = back;
-                    }
+            while (successor->m_left != nullptr)
+                successor = successor->m_left;
 
-                    // Unlink previous bind element
-                    temp->m_right = nullptr;
-                    // Visit to right child
-                    current = current->m_right;
-                }
+            if (successor->m_parent != node)
+            {
+                retrace = successor->m_parent;
+
+                this->__M_transplant(successor, successor->m_right);
+                successor->m_right = node->m_right;
+                successor->m_right->m_parent = successor;
+            }
+            else
+            {
+                retrace = successor;
             }
+
+            this->__M_transplant(node, successor);
+            successor->m_left = node->m_left;
+            successor->m_left->m_parent = successor;
         }
 
-        delete dummy;
-        dummy = nullptr;
-    }
+        node->m_left = node->m_right = node->m_parent = nullptr;
 
-    // Swap
-    // Swap function
+        this->m_size = this->m_size - 1UL;
+
+        this->__M_rebalance(retrace);
+    }
 
     /**
-    * @brief Swaps the contents of two binary search trees.
-    * @param lhs The first binary search tree.
-    * @param rhs The second binary search tree.
+    * @brief Replace the subtree rooted at `target` with the one rooted at `source`.
+    * @param target The node whose position is taken over.
+    * @param source The replacement subtree, possibly null.
     */
-    friend constexpr void swap(binary_search_tree &lhs, binary_search_tree &rhs)
-            noexcept(std::disjunction<typename traits::propagate_on_container_swap,
-                                        typename traits::is_always_equal>{})
+    constexpr void __M_transplant(Node *target, Node *source) noexcept
     {
-        if constexpr (typename traits::propagate_on_container_swap{})
-        {
-            std::swap(lhs.m_alloc, rhs.m_alloc);
-        }
-        std::swap(lhs.m_root, rhs.m_root);
-        std::swap(lhs.m_size, rhs.m_size);
+        if (target->m_parent == nullptr)
+            this->m_root = source;
+        else if (target == target->m_parent->m_left)
+            target->m_parent->m_left = source;
+        else
+            target->m_parent->m_right = source;
+
+        if (source != nullptr)
+            source->m_parent = target->m_parent;
+    }
+
+    /**
+    * @brief Height of a subtree, -1 for an empty one.
+    * @param node The root of the subtree.
+    */
+    [[nodiscard]] static constexpr auto __M_height(const Node *node) noexcept -> int
+    {
+        if constexpr (is_balanced)
+            return (node == nullptr) ? -1 : node->m_height;
+        else
+            return 0;
     }
 
-public:
-    // Destructor
     /**
-    * @brief Destructor. Clears the binary search tree.
+    * @brief Size of a subtree, 0 for an empty one (and always 0 without order statistics).
+    * @param node The root of the subtree.
     */
-    constexpr ~binary_search_tree() { this->clear(); }
-
-private:
-    // Private member functions
+    [[nodiscard]] static constexpr auto __M_count(const Node *node) noexcept -> size_type
+    {
+        if constexpr (is_ranked)
+            return (node == nullptr) ? 0UL : node->m_count;
+        else
+            return 0UL;
+    }
 
     /**
-    * @brief Creates a new node with the given arguments.
-    * @tparam ARGS Types of arguments for constructing the node.
-    * @param args Arguments for constructing the node.
-    * @return Node* Pointer to the newly created node.
+    * @brief Recompute the cached height and subtree size of a node from its children.
+    * @param node The node to update.
     */
-    template <class... ARGS>
-    constexpr Node *__M_create_node(ARGS &&...args)
+    static constexpr void __M_update(Node *node) noexcept
     {
-        auto node = traits::allocate(this->m_alloc, 1UL);
-        try {
-            traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
+        if constexpr (is_balanced)
+        {
+            node->m_height = static_cast<height_t>(
+                1 + std::max(__M_height(node->m_left), __M_height(node->m_right)));
         }
-        catch (...) {
-            traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
-            throw;
+
+        if constexpr (is_ranked)
+        {
+            node->m_count = 1UL + __M_count(node->m_left) + __M_count(node->m_right);
         }
-        return node;
     }
 
     /**
-    * @brief Search for a value in the tree.
-    * @tparam RType The return type of the search.
-    * @param current The current node being examined.
-    * @param key The key to search for.
-    * @return std::optional<RType> An optional containing the found value, if any.
+    * @brief Rotate the subtree rooted at `node` to the left.
+    * @param node The root of the subtree, whose right child becomes the new root.
+    * @return Node* The new root of the subtree.
     */
-    template <class RType>
-    constexpr auto __M_search(const Node *current, const Type &key)
-        -> std::optional<RType>
+    constexpr auto __M_rotate_left(Node *node) noexcept -> Node *
     {
-        if (current != nullptr)
-        {
-            while (current != nullptr && (key != current->m_data))
-            {
-                if (key == current->m_data)
-                    return std::optional{std::ref(current->m_data)};
-                else if (key < current->m_data)
-                    current = current->m_left;
-                else
-                    current = current->m_right;
-            }
-            return std::nullopt;
-        }
-        return std::nullopt;
+        this->m_stats.rebalanced();
+
+        auto pivot = node->m_right;
+
+        node->m_right = pivot->m_left;
+
+        if (pivot->m_left != nullptr)
+            pivot->m_left->m_parent = node;
+
+        this->__M_transplant(node, pivot);
+
+        pivot->m_left = node;
+        node->m_parent = pivot;
+
+        __M_update(node);
+        __M_update(pivot);
+
+        return pivot;
     }
 
     /**
-    * @brief Insert a node into the tree.
-    * @param node The node to insert.
+    * @brief Rotate the subtree rooted at `node` to the right.
+    * @param node The root of the subtree, whose left child becomes the new root.
+    * @return Node* The new root of the subtree.
     */
-    constexpr void __M_insert(Node *node)
+    constexpr auto __M_rotate_right(Node *node) noexcept -> Node *
     {
-        if (node == nullptr)
-            return;
+        this->m_stats.rebalanced();
 
-        if (this->m_root == nullptr)
-        {
-            this->m_root = node;
-            this->m_size = this->m_size + 1UL;
-            return;
-        }
+        auto pivot = node->m_left;
 
-        Node *current = this->m_root;
-        Node *parent = nullptr;
+        node->m_left = pivot->m_right;
 
-        while (current != nullptr)
-        {
-            parent = current;
-            if (node->m_data <= current->m_data)
-                current = current->m_left;
-            else
-                current = current->m_right;
-        }
+        if (pivot->m_right != nullptr)
+            pivot->m_right->m_parent = node;
 
-        node->m_parent = parent;
+        this->__M_transplant(node, pivot);
 
-        if (parent == nullptr)
+        pivot->m_right = node;
+        node->m_parent = pivot;
+
+        __M_update(node);
+        __M_update(pivot);
+
+        return pivot;
+    }
+
+    /**
+    * @brief Restore the AVL invariant and the cached subtree sizes on the path from `node`
+    *        up to the root.
+    * @details No-op for the unbalanced policy without order statistics.
+    * @param node The lowest node whose subtree changed.
+    */
+    constexpr void __M_rebalance(Node *node) noexcept
+    {
+        if constexpr (is_balanced || is_ranked)
         {
-            parent = node;
-            this->m_size = this->m_size + 1UL;
-            return;
-        }
+            while (node != nullptr)
+            {
+                __M_update(node);
 
-        if (node->m_data <= parent->m_data)
-            parent->m_left = node;
-        else
-            parent->m_right = node;
+                if constexpr (is_balanced)
+                {
+                    auto balance = __M_height(node->m_left) - __M_height(node->m_right);
 
-        this->m_size = this->m_size + 1UL;
+                    if (balance > 1)
+                    {
+                        if (__M_height(node->m_left->m_left) < __M_height(node->m_left->m_right))
+                            this->__M_rotate_left(node->m_left);
+
+                        node = this->__M_rotate_right(node);
+                    }
+                    else if (balance < -1)
+                    {
+                        if (__M_height(node->m_right->m_right) < __M_height(node->m_right->m_left))
+                            this->__M_rotate_right(node->m_right);
+
+                        node = this->__M_rotate_left(node);
+                    }
+                }
+
+                node = node->m_parent;
+            }
+        }
     }
 
     /**
@@ -709,19 +2457,28 @@ private:
     * @param root The root of the subtree to clone.
     * @return Node* Pointer to the root of the cloned subtree.
     */
-    [[nodiscard]] constexpr Node *__M_clone(Node *root)
+    [[nodiscard]] constexpr Node *__M_clone(const Node *root)
     {
-        if (root != nullptr)
-        {
-            auto new_root = this->__M_create_node(root->m_data);
-            auto cursor = new_root;
+        if (root == nullptr)
+            return nullptr;
 
-            while (root != nullptr)
+        const Node *source = root;
+
+        auto new_root = this->__M_create_node(root->m_data);
+        auto cursor = new_root;
+
+        new_root->m_height = root->m_height;
+        new_root->m_count = root->m_count;
+
+        try {
+            while (true)
             {
                 if ((root->m_left != nullptr) && (cursor->m_left == nullptr))
                 {
                     auto node = this->__M_create_node(root->m_left->m_data);
 
+                    node->m_height = root->m_left->m_height;
+                    node->m_count = root->m_left->m_count;
                     cursor->m_left = node;
                     cursor->m_left->m_parent = cursor;
 
@@ -732,21 +2489,31 @@ private:
                 {
                     auto node = this->__M_create_node(root->m_right->m_data);
 
+                    node->m_height = root->m_right->m_height;
+                    node->m_count = root->m_right->m_count;
                     cursor->m_right = node;
                     cursor->m_right->m_parent = cursor;
 
                     root = root->m_right;
                     cursor = cursor->m_right;
                 }
-                else
+                else if (root != source)
                 {
                     root = root->m_parent;
                     cursor = cursor->m_parent;
                 }
+                else
+                {
+                    break;
+                }
             }
-            return new_root;
         }
-        return root;
+        catch (...) {
+            this->__M_destroy(new_root);
+            throw;
+        }
+
+        return new_root;
     }
 
     /**
@@ -769,6 +2536,123 @@ private:
         }
     }
 
+    /**
+    * @brief Initialize the tree from `count` sorted elements in O(n).
+    * @tparam _iterator Iterator type for the range.
+    * @param first Iterator pointing to the smallest element.
+    * @param count The number of elements.
+    */
+    template <typename _iterator>
+    constexpr void __M_sorted_init(_iterator first, size_type count)
+    {
+        this->m_root = this->__M_build_sorted(first, count);
+        this->m_size = count;
+    }
+
+    /**
+    * @brief Builds a balanced subtree from `count` sorted elements in O(n).
+    * @details The nodes are first created as an in-order chain threaded through
+    *          m_right, which keeps cleanup trivial if a constructor throws, and then
+    *          relinked into a perfectly balanced shape.
+    * @tparam _iterator Iterator type for the range.
+    * @param first Iterator pointing to the smallest element.
+    * @param count The number of elements.
+    * @return Node* The root of the subtree, whose m_parent is left null.
+    */
+    template <typename _iterator>
+    constexpr auto __M_build_sorted(_iterator first, size_type count) -> Node *
+    {
+        if (count == 0UL)
+            return nullptr;
+
+        constexpr bool is_batched = details::monotonic_allocator<allocator_t>;
+
+        Node *block = nullptr;
+        Node *head = nullptr;
+        Node *tail = nullptr;
+
+        if constexpr (is_batched)
+        {
+            // The arena never takes single nodes back, so one block can serve them all
+            block = std::to_address(traits::allocate(this->m_alloc, count));
+            this->m_stats.allocated();
+        }
+
+        try {
+            for (size_type index = 0UL; index < count; ++index, first = std::ranges::next(first))
+            {
+                Node *node = nullptr;
+
+                if constexpr (is_batched)
+                {
+                    node = block + index;
+                    traits::construct(this->m_alloc, node, *first);
+                }
+                else
+                {
+                    node = this->__M_create_node(*first);
+                }
+
+                if (tail != nullptr)
+                    tail->m_right = node;
+                else
+                    head = node;
+
+                tail = node;
+            }
+        }
+        catch (...) {
+            while (head != nullptr)
+            {
+                auto next = head->m_right;
+
+                traits::destroy(this->m_alloc, std::to_address(head));
+
+                if constexpr (not is_batched)
+                {
+                    traits::deallocate(this->m_alloc, std::to_address(head), 1UL);
+                    this->m_stats.deallocated();
+                }
+
+                head = next;
+            }
+            throw;
+        }
+
+        return __M_build_balanced(head, count);
+    }
+
+    /**
+    * @brief Relink the next `count` nodes of an in-order chain into a balanced subtree.
+    * @param head The head of the chain, advanced past the consumed nodes.
+    * @param count The number of nodes in the subtree.
+    * @return Node* The root of the subtree, whose m_parent is left null.
+    */
+    static constexpr auto __M_build_balanced(Node *&head, size_type count) noexcept -> Node *
+    {
+        if (count == 0UL)
+            return nullptr;
+
+        auto left = __M_build_balanced(head, count / 2UL);
+
+        auto root = head;
+        head = head->m_right;
+
+        root->m_left = left;
+
+        if (left != nullptr)
+            left->m_parent = root;
+
+        root->m_right = __M_build_balanced(head, count - count / 2UL - 1UL);
+
+        if (root->m_right != nullptr)
+            root->m_right->m_parent = root;
+
+        __M_update(root);
+
+        return root;
+    }
+
     /**
     * @brief Copy assignment.
     * @param outer The tree to copy from.
@@ -790,6 +2674,7 @@ private:
 
         this->m_root = this->__M_clone(outer.m_root);
         this->m_size = outer.m_size;
+        this->m_comp = outer.m_comp;
     }
 
     /**
@@ -803,6 +2688,7 @@ private:
 
         this->m_root = this->__M_clone(outer.m_root);
         this->m_size = outer.m_size;
+        this->m_comp = outer.m_comp;
     }
 
     /**
@@ -814,9 +2700,13 @@ private:
     {
         this->clear();
 
-        this->m_alloc = std::move(outer.m_alloc);
+        // Equal but non-propagating allocators (std::pmr) are kept: they cannot be assigned
+        if constexpr (typename traits::propagate_on_container_move_assignment{})
+            this->m_alloc = std::move(outer.m_alloc);
+
         this->m_root = std::exchange(outer.m_root, nullptr);
         this->m_size = std::exchange(outer.m_size, 0UL);
+        this->m_comp = std::move(outer.m_comp);
     }
 
     /**
@@ -832,8 +2722,19 @@ private:
         }
         else
         {
-            this->m_root = std::exchange(outer.m_root, nullptr);
-            this->m_size = std::exchange(outer.m_size, 0UL);
+            // The nodes of `outer` must go back to its own allocator: move the elements,
+            // already in order, into a balanced tree of new nodes
+            this->clear();
+
+            // The nodes themselves are not const: only the iterators guard the order
+            auto elements = outer | std::views::transform([](const Type &data) -> Type && {
+                return std::move(const_cast<Type &>(data));
+            });
+
+            this->__M_sorted_init(std::ranges::begin(elements), outer.m_size);
+            this->m_comp = std::move(outer.m_comp);
+
+            outer.clear();
         }
     }
 
@@ -842,6 +2743,10 @@ private:
     Node *m_root{nullptr};
     size_type m_size{0UL};
     [[no_unique_address]] allocator_t m_alloc{};
+    [[no_unique_address]] Compare m_comp{};
+
+    // Counters behind stats(); lookups are const, so it is mutable.
+    [[no_unique_address]] mutable details::stats_recorder<Stats> m_stats{};
 };
 
 
@@ -852,7 +2757,7 @@ private:
 * @tparam range_t Type of the range.
 */
 template <class Range_t>
-binary_search_tree(std::from_range_t, Range_t &&) -> binary_search_tree<std::ranges::range_value_t<Range_t>>;
+binary_search_tree(details::from_range_t, Range_t &&) -> binary_search_tree<std::ranges::range_value_t<Range_t>>;
 
 /**
 * @brief Deduction guide for BS_tree from iterators and sentinels.
@@ -865,8 +2770,9 @@ binary_search_tree(Iterator, Sentinel) -> binary_search_tree<std::iter_value_t<I
 
 
 // Node struct representing a node in the binary search tree
-template <typename Type> requires std::totally_ordered<Type>
-struct binary_search_tree<Type>::Node final
+template <typename Type, typename Allocator, typename Balance, typename Compare, typename Augment, typename Stats>
+    requires std::strict_weak_order<Compare &, const Type &, const Type &>
+struct binary_search_tree<Type, Allocator, Balance, Compare, Augment, Stats>::Node final
 {
 
 public:
@@ -925,12 +2831,186 @@ public:
     {
     }
 
+    /**
+    * @brief Constructor forwarding every argument to the constructor of the data.
+    * @tparam ARGS The argument types.
+    * @param args The arguments the data is constructed from, in place.
+    */
+    template <class... ARGS>
+    explicit constexpr Node(std::in_place_type_t<Type>, ARGS &&...args)
+        noexcept(std::is_nothrow_constructible_v<Type, ARGS...>)
+        requires(std::constructible_from<Type, ARGS...>)
+        : m_data(std::forward<ARGS>(args)...)
+    {
+    }
+
 private:
     // Private data members
     Type m_data{};
+    [[no_unique_address]] height_t m_height{}; // Height of the subtree, 0 for a leaf
+    [[no_unique_address]] count_t m_count{};   // Number of nodes in the subtree, 1 for a leaf
     Node *m_left{nullptr};
     Node *m_right{nullptr};
     Node *m_parent{nullptr};
 };
 
+
+// In-order iterator of the binary search tree
+// Successors are found through the m_parent links, so iteration is read-only
+// and needs no stack. The end iterator is a null node; it keeps a pointer to
+// its tree so that decrementing it reaches the largest element.
+template <typename Type, typename Allocator, typename Balance, typename Compare, typename Augment, typename Stats>
+    requires std::strict_weak_order<Compare &, const Type &, const Type &>
+struct binary_search_tree<Type, Allocator, Balance, Compare, Augment, Stats>::Iterator final
+{
+public:
+    friend struct binary_search_tree;
+
+public:
+    using value_type = Type;
+
+    using reference       = const Type &;
+    using const_reference = const Type &;
+
+    using pointer       = const Type *;
+    using const_pointer = const Type *;
+
+    using difference_type = std::ptrdiff_t;
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using iterator_concept  = std::bidirectional_iterator_tag;
+
+public:
+    // Constructors
+    /**
+    * Constructs a singular iterator.
+    * @brief Default constructor.
+    */
+    constexpr Iterator() noexcept = default;
+
+    /**
+    * Constructs an iterator pointing to the provided node of `tree`.
+    * @brief Constructs an iterator with a given node pointer.
+    * @param cursor Pointer to the node, null for the end iterator.
+    * @param tree The tree the node belongs to.
+    */
+    constexpr Iterator(const Node *cursor, const binary_search_tree *tree) noexcept
+        : m_cursor{cursor}, m_tree{tree}
+    {
+    }
+
+    constexpr Iterator(const Iterator &) noexcept = default; ///< Copy constructor.
+    constexpr Iterator(Iterator &&) noexcept = default;      ///< Move constructor.
+
+    // Assignment operators
+    constexpr auto operator=(const Iterator &) noexcept -> Iterator & = default; ///< Copy assignment operator.
+    constexpr auto operator=(Iterator &&) noexcept -> Iterator & = default;      ///< Move assignment operator.
+
+public:
+    // Dereferencing operators
+    /**
+    * Returns a reference to the data stored in the current node.
+    * @brief Dereference operator.
+    * @return Const reference to the data.
+    */
+    constexpr auto operator*() const noexcept -> reference { return this->m_cursor->m_data; }
+
+    /**
+    * Returns a pointer to the data stored in the current node.
+    * @brief Member access operator.
+    * @return Const pointer to the data.
+    */
+    constexpr auto operator->() const noexcept -> pointer { return std::addressof(this->m_cursor->m_data); }
+
+public:
+    // Increment and decrement operators
+    /**
+    * Advances the iterator to the in-order successor, in amortized O(1).
+    * @brief Pre-increment operator.
+    * @return Reference to the updated iterator.
+    */
+    constexpr auto operator++() noexcept -> Iterator &
+    {
+        this->m_cursor = __M_inorder_next(this->m_cursor);
+        return *this;
+    }
+
+    /**
+    * Moves the iterator to the in-order predecessor; the end iterator moves to the largest element.
+    * @brief Pre-decrement operator.
+    * @return Reference to the updated iterator.
+    */
+    constexpr auto operator--() noexcept -> Iterator &
+    {
+        if (this->m_cursor == nullptr)
+        {
+            this->m_cursor = __M_rightmost(static_cast<const Node *>(this->m_tree->m_root));
+        }
+        else if (this->m_cursor->m_left != nullptr)
+        {
+            this->m_cursor = __M_rightmost(static_cast<const Node *>(this->m_cursor->m_left));
+        }
+        else
+        {
+            auto parent = this->m_cursor->m_parent;
+
+            while ((parent != nullptr) && (this->m_cursor == parent->m_left))
+            {
+                this->m_cursor = parent;
+                parent = parent->m_parent;
+            }
+
+            this->m_cursor = parent;
+        }
+
+        return *this;
+    }
+
+    /**
+    * Advances the iterator and returns a copy of the previous iterator.
+    * @brief Post-increment operator.
+    * @return Copy of the previous iterator.
+    */
+    [[nodiscard]] constexpr auto operator++(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        std::ranges::advance(*this, 1);
+
+        return copy;
+    }
+
+    /**
+    * Moves the iterator back and returns a copy of the previous iterator.
+    * @brief Post-decrement operator.
+    * @return Copy of the previous iterator.
+    */
+    [[nodiscard]] constexpr auto operator--(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        std::ranges::advance(*this, -1);
+
+        return copy;
+    }
+
+public:
+    // Equality operator
+    /**
+    * Compares two iterators for equality based on the node they are pointing to.
+    * @brief Equality comparison operator.
+    * @param lhs Left-hand side iterator.
+    * @param rhs Right-hand side iterator.
+    * @return True if the iterators point to the same node, false otherwise.
+    */
+    [[nodiscard]]
+    friend constexpr auto operator==(const Iterator &lhs,
+                                     const Iterator &rhs) noexcept -> bool
+    {
+        return (lhs.m_cursor == rhs.m_cursor);
+    }
+
+private:
+    const Node *m_cursor{nullptr};               ///< Pointer to the current node, null at the end.
+    const binary_search_tree *m_tree{nullptr};   ///< The tree iterated over, used to step back from end().
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,272 @@
+#ifndef __BINARYSEARCH_VIEW_HXX__
+#define __BINARYSEARCH_VIEW_HXX__
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "details.h"
+#include "serialization.h"
+
+
+
+/**
+* @brief A read-only binary search tree over elements stored in level order.
+* @details The elements are the nodes of a complete tree, root first, the children of the
+*          element at index i at 2i+1 and 2i+2: the layout serialize() writes for a
+*          binary_search_tree. No node is built, so a view over a mapped archive is ready as
+*          soon as the file is mapped, and only the pages a search touches are ever read.
+*          Each descent step is branch-free and prefetches the block holding the element's
+*          great-great-grandchildren, which the top levels, touched by every search, keep hot.
+*          The view owns nothing: the elements must outlive it.
+* @tparam Type The type of the elements.
+* @tparam Compare The ordering the elements were sorted by; a transparent comparator enables
+*         lookups by any key type it can compare with Type.
+*/
+template <typename Type, typename Compare = std::less<Type>>
+    requires std::strict_weak_order<Compare &, const Type &, const Type &>
+struct binary_search_tree_view final
+{
+public:
+    // Public typedefs for types used in the view
+    using value_type = Type;
+
+    using reference       = const Type &;
+    using const_reference = const Type &;
+
+    using pointer       = const Type *;
+    using const_pointer = const Type *;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using key_compare = Compare;
+
+    // In-order iterators, walking the implicit tree by position arithmetic
+    using iterator       = details::level_order_iterator<Type>;
+    using const_iterator = details::level_order_iterator<Type>;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Constructs an empty view.
+    */
+    constexpr binary_search_tree_view() noexcept = default;
+
+    /**
+    * @brief Constructs a view over elements already in level order.
+    * @param levels The elements, root first.
+    * @param comp The ordering of the elements.
+    */
+    explicit constexpr binary_search_tree_view(std::span<const Type> levels, const Compare &comp = Compare())
+        : m_levels{levels}, m_comp{comp}
+    {
+    }
+
+    /**
+    * @brief Constructs a view over the bytes of a binary_search_tree archive, such as a
+    *        mapped_file, without copying them.
+    * @param bytes The archive, header included.
+    * @param comp The ordering the archived tree used.
+    * @return std::optional<binary_search_tree_view> The view, or std::nullopt if the bytes
+    *         are not a complete level-order archive of Type, or are not suitably aligned.
+    */
+    [[nodiscard]] static auto from_archive(std::span<const std::byte> bytes, const Compare &comp = Compare())
+        -> std::optional<binary_search_tree_view>
+        requires details::archive_element<Type>
+    {
+        if (bytes.size() < details::archive_header_size)
+            return std::nullopt;
+
+        auto header = details::decode_header<Type>(bytes.template first<details::archive_header_size>());
+
+        if (not header.has_value() || (header->m_layout != archive_layout::level_order))
+            return std::nullopt;
+
+        // Arithmetic elements are archived little-endian: in place, they are only readable
+        // on a little-endian host
+        if constexpr ((std::endian::native != std::endian::little) && (sizeof(Type) > 1UL))
+            return std::nullopt;
+
+        auto payload = bytes.subspan(details::archive_header_size);
+
+        if ((header->m_count > (payload.size() / sizeof(Type))) ||
+            ((reinterpret_cast<std::uintptr_t>(payload.data()) % alignof(Type)) != 0UL))
+        {
+            return std::nullopt;
+        }
+
+        // Trivially copyable elements written by serialize() live in the archive's bytes
+        auto first = reinterpret_cast<const Type *>(payload.data());
+
+        return binary_search_tree_view{std::span<const Type>{first, static_cast<size_type>(header->m_count)}, comp};
+    }
+
+public:
+    // Search functions
+
+    /**
+    * @brief Search for a value in the view.
+    * @return std::optional<std::reference_wrapper<const Type>> An equivalent element, or std::nullopt.
+    */
+    [[nodiscard]] constexpr auto search(const Type &key) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_search(key);
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto search(const Key &key) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_search(key);
+    }
+
+    [[nodiscard]] constexpr auto contains(const Type &key) const noexcept -> bool
+    {
+        return this->__M_search(key).has_value();
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto contains(const Key &key) const noexcept -> bool
+    {
+        return this->__M_search(key).has_value();
+    }
+
+    /**
+    * @brief The first element not ordered before `key`.
+    * @return std::optional<std::reference_wrapper<const Type>> The element, or std::nullopt
+    *         if every element is ordered before `key`.
+    */
+    [[nodiscard]] constexpr auto lower_bound(const Type &key) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_element(this->__M_lower_bound(key));
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto lower_bound(const Key &key) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_element(this->__M_lower_bound(key));
+    }
+
+public:
+    // Utility functions
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return this->m_levels.empty(); }
+
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type { return this->m_levels.size(); }
+
+    [[nodiscard]] constexpr auto key_comp() const -> key_compare { return this->m_comp; }
+
+    /**
+    * @brief The elements in level order, as stored.
+    */
+    [[nodiscard]] constexpr auto levels() const noexcept -> std::span<const Type> { return this->m_levels; }
+
+    // Get the minimum value in the view: the end of the leftmost path
+    [[nodiscard]] constexpr auto min() const noexcept -> std::optional<Type>
+    {
+        return this->__M_copy(details::level_order_first(this->size()));
+    }
+
+    // Get the maximum value in the view: the end of the rightmost path
+    [[nodiscard]] constexpr auto max() const noexcept -> std::optional<Type>
+    {
+        size_type position = this->empty() ? 0UL : 1UL;
+
+        while ((2UL * position + 1UL) <= this->size())
+            position = 2UL * position + 1UL;
+
+        return this->__M_copy(position);
+    }
+
+public:
+    // Iterator Support (ascending order)
+
+    [[nodiscard]] constexpr auto begin() const noexcept -> const_iterator
+    {
+        return const_iterator{this->m_levels, details::level_order_first(this->size())};
+    }
+
+    [[nodiscard]] constexpr auto end() const noexcept -> const_iterator { return const_iterator{this->m_levels, 0UL}; }
+
+    [[nodiscard]] constexpr auto cbegin() const noexcept -> const_iterator { return this->begin(); }
+    [[nodiscard]] constexpr auto cend() const noexcept -> const_iterator { return this->end(); }
+
+private:
+    // Descent helpers
+    // Positions are 1-based, so the children of p are 2p and 2p+1 and 0 means none.
+
+    // Positions the prefetch runs ahead: 16p is the first great-great-grandchild of p
+    static constexpr size_type prefetch_distance = 16UL;
+
+    /**
+    * @brief Descends to a leaf, going right whenever the element is ordered before `key`,
+    *        then climbs back to the last left turn: the lower bound.
+    */
+    template <class Key>
+    constexpr auto __M_lower_bound(const Key &key) const noexcept -> size_type
+    {
+        const auto count = this->size();
+        const auto data = this->m_levels.data();
+
+        size_type position = 1UL;
+
+        while (position <= count)
+        {
+            if ((prefetch_distance * position) <= count)
+                details::prefetch(data + (prefetch_distance * position - 1UL));
+
+            position = 2UL * position + static_cast<size_type>(this->m_comp(data[position - 1UL], key));
+        }
+
+        // Undo the right turns taken after the last left turn, and that left turn itself
+        return position >> (std::countr_one(position) + 1);
+    }
+
+    template <class Key>
+    constexpr auto __M_search(const Key &key) const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        auto position = this->__M_lower_bound(key);
+
+        if ((position == 0UL) || this->m_comp(key, this->m_levels[position - 1UL]))
+            return std::nullopt;
+
+        return std::optional{std::cref(this->m_levels[position - 1UL])};
+    }
+
+    [[nodiscard]] constexpr auto __M_element(size_type position) const noexcept
+        -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (position == 0UL)
+            return std::nullopt;
+
+        return std::optional{std::cref(this->m_levels[position - 1UL])};
+    }
+
+    [[nodiscard]] constexpr auto __M_copy(size_type position) const noexcept -> std::optional<Type>
+    {
+        if (position == 0UL)
+            return std::nullopt;
+
+        return std::optional{this->m_levels[position - 1UL]};
+    }
+
+private:
+    std::span<const Type> m_levels{}; // The elements, root first
+    [[no_unique_address]] Compare m_comp{};
+};
+
+#endif
@@ -0,0 +1,496 @@
+#ifndef __BST_MAP_HXX__
+#define __BST_MAP_HXX__
+
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+#include "bs_tree.h"
+#include "details.h"
+
+
+/**
+* @brief An ordered key/value map stored in a binary_search_tree of std::pair<const Key, Value>.
+* @details Only the keys are compared; values are updated in place through the iterators, and
+*          try_emplace, insert_or_assign and operator[] descend the tree once, constructing the
+*          value only when the key is absent. Keys are unique.
+* @tparam Key The type of the keys.
+* @tparam Value The type of the mapped values.
+* @tparam Allocator The allocator passed on to the underlying tree.
+* @tparam Balance The balancing policy of the underlying tree.
+* @tparam Compare The strict weak ordering on keys.
+*/
+template <typename Key, typename Value,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>,
+          typename Balance = unbalanced_policy,
+          typename Compare = std::less<Key>>
+    requires std::strict_weak_order<Compare &, const Key &, const Key &>
+struct bst_map final
+{
+public:
+    // Public typedefs for types used in the map
+    using key_type    = Key;
+    using mapped_type = Value;
+    using value_type  = std::pair<const Key, Value>;
+
+    using allocator_type = Allocator;
+    using key_compare    = Compare;
+    using balance_policy = Balance;
+
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    // Orders the stored pairs, and keys against pairs, by key alone
+    struct value_compare final
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] static constexpr auto key_of(const value_type &value) noexcept -> const Key & { return value.first; }
+
+        template <class K>
+        [[nodiscard]] static constexpr auto key_of(const K &key) noexcept -> const K & { return key; }
+
+        template <class Lhs, class Rhs>
+        [[nodiscard]] constexpr auto operator()(const Lhs &lhs, const Rhs &rhs) const -> bool
+        {
+            return std::invoke(this->m_comp, key_of(lhs), key_of(rhs));
+        }
+
+        [[no_unique_address]] Compare m_comp{};
+    };
+
+    using tree_t = binary_search_tree<value_type, Allocator, Balance, value_compare>;
+
+    // Nested iterator adapting the (constant) tree iterator
+    template <bool IsConst>
+    struct Iterator;
+
+public:
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+    // Constructors
+    /**
+    * @brief Default constructor.
+    */
+    constexpr bst_map() = default;
+
+    /**
+    * @brief Constructs an empty map using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr bst_map(const Allocator &alloc)
+        : m_tree{alloc}
+    {
+    }
+
+    /**
+    * @brief Constructs an empty map ordered by `comp`.
+    * @param comp The comparator ordering the keys.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr bst_map(const Compare &comp, const Allocator &alloc = Allocator())
+        : m_tree{value_compare{comp}, alloc}
+    {
+    }
+
+    /**
+    * @brief Constructs the map from a range of key/value pairs; later duplicates are ignored.
+    * @param first The beginning of the range.
+    * @param last The end of the range.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename Iterator_, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<Iterator_>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator_>>
+        >::value
+    constexpr bst_map(Iterator_ first, Sentinel last, const Allocator &alloc = Allocator())
+        : bst_map(alloc)
+    {
+        for (; first != last; first = std::ranges::next(first))
+        {
+            this->insert(*first);
+        }
+    }
+
+    /**
+    * @brief Constructs the map from an initializer list; later duplicates are ignored.
+    * @param list The key/value pairs.
+    * @param alloc The allocator used for all node allocations.
+    */
+    constexpr bst_map(std::initializer_list<value_type> list, const Allocator &alloc = Allocator())
+        : bst_map(std::ranges::begin(list), std::ranges::end(list), alloc)
+    {
+    }
+
+public:
+    // Lookup
+
+    /**
+    * @brief Finds the element with the given key, in one descent.
+    * @param key The key to search for.
+    * @return An iterator to the element, or end() if the key is absent.
+    */
+    [[nodiscard]] constexpr auto find(const Key &key) -> iterator { return iterator{this->__M_find(key)}; }
+
+    [[nodiscard]] constexpr auto find(const Key &key) const -> const_iterator
+    {
+        return const_iterator{this->__M_find(key)};
+    }
+
+    // Find by any key the transparent comparator can compare with Key
+    template <class K>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto find(const K &key) -> iterator
+    {
+        return iterator{this->__M_find(key)};
+    }
+
+    template <class K>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto find(const K &key) const -> const_iterator
+    {
+        return const_iterator{this->__M_find(key)};
+    }
+
+    /**
+    * @brief Whether an element with the given key exists.
+    */
+    [[nodiscard]] constexpr auto contains(const Key &key) const -> bool
+    {
+        return (this->__M_find(key) != this->m_tree.end());
+    }
+
+    template <class K>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] constexpr auto contains(const K &key) const -> bool
+    {
+        return (this->__M_find(key) != this->m_tree.end());
+    }
+
+    /**
+    * @brief Finds the first element whose key is not less than `key`.
+    */
+    [[nodiscard]] constexpr auto lower_bound(const Key &key) -> iterator { return iterator{this->m_tree.lower_bound(key)}; }
+
+    [[nodiscard]] constexpr auto lower_bound(const Key &key) const -> const_iterator
+    {
+        return const_iterator{this->m_tree.lower_bound(key)};
+    }
+
+    /**
+    * @brief Finds the first element whose key is greater than `key`.
+    */
+    [[nodiscard]] constexpr auto upper_bound(const Key &key) -> iterator { return iterator{this->m_tree.upper_bound(key)}; }
+
+    [[nodiscard]] constexpr auto upper_bound(const Key &key) const -> const_iterator
+    {
+        return const_iterator{this->m_tree.upper_bound(key)};
+    }
+
+public:
+    // Insertion
+
+    /**
+    * @brief Inserts `value` unless its key is already present.
+    * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+    */
+    constexpr auto insert(const value_type &value) -> std::pair<iterator, bool>
+    {
+        return this->__M_emplace(value.first, value);
+    }
+
+    constexpr auto insert(value_type &&value) -> std::pair<iterator, bool>
+    {
+        return this->__M_emplace(value.first, std::move(value));
+    }
+
+    /**
+    * @brief Constructs the value from `args` in place if, and only if, `key` is absent.
+    * @details A present key leaves `args` untouched, so move-only arguments are not consumed.
+    * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+    */
+    template <class... ARGS>
+        requires std::constructible_from<Value, ARGS...>
+    constexpr auto try_emplace(const Key &key, ARGS &&...args) -> std::pair<iterator, bool>
+    {
+        return this->__M_emplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<ARGS>(args)...));
+    }
+
+    template <class... ARGS>
+        requires std::constructible_from<Value, ARGS...>
+    constexpr auto try_emplace(Key &&key, ARGS &&...args) -> std::pair<iterator, bool>
+    {
+        return this->__M_emplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                 std::forward_as_tuple(std::forward<ARGS>(args)...));
+    }
+
+    /**
+    * @brief Inserts `obj` under `key`, or assigns it to the value already stored there.
+    * @return std::pair<iterator, bool> The element with that key, and whether it was inserted.
+    */
+    template <class M>
+        requires std::conjunction<
+            std::bool_constant<std::constructible_from<Value, M>>,
+            std::bool_constant<std::assignable_from<Value &, M>>
+        >::value
+    constexpr auto insert_or_assign(const Key &key, M &&obj) -> std::pair<iterator, bool>
+    {
+        auto result = this->try_emplace(key, std::forward<M>(obj));
+
+        if (not result.second)
+            result.first->second = std::forward<M>(obj);
+
+        return result;
+    }
+
+    template <class M>
+        requires std::conjunction<
+            std::bool_constant<std::constructible_from<Value, M>>,
+            std::bool_constant<std::assignable_from<Value &, M>>
+        >::value
+    constexpr auto insert_or_assign(Key &&key, M &&obj) -> std::pair<iterator, bool>
+    {
+        auto result = this->try_emplace(std::move(key), std::forward<M>(obj));
+
+        if (not result.second)
+            result.first->second = std::forward<M>(obj);
+
+        return result;
+    }
+
+    /**
+    * @brief Returns the value stored under `key`, value-initializing it first if absent.
+    */
+    constexpr auto operator[](const Key &key) -> Value &
+        requires std::default_initializable<Value>
+    {
+        return this->try_emplace(key).first->second;
+    }
+
+    constexpr auto operator[](Key &&key) -> Value &
+        requires std::default_initializable<Value>
+    {
+        return this->try_emplace(std::move(key)).first->second;
+    }
+
+public:
+    // Removal
+
+    /**
+    * @brief Removes the element with the given key.
+    * @return size_type The number of elements removed, 0 or 1.
+    */
+    constexpr auto erase(const Key &key) -> size_type
+    {
+        auto before = this->m_tree.size();
+
+        this->m_tree.remove(key);
+
+        return before - this->m_tree.size();
+    }
+
+    template <class K>
+        requires details::transparent_comparator<Compare>
+    constexpr auto erase(const K &key) -> size_type
+    {
+        auto before = this->m_tree.size();
+
+        this->m_tree.remove(key);
+
+        return before - this->m_tree.size();
+    }
+
+    /**
+    * @brief Removes every element.
+    */
+    constexpr void clear() { this->m_tree.clear(); }
+
+public:
+    // Utility functions
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return this->m_tree.empty(); }
+
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type { return this->m_tree.size(); }
+
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type { return this->m_tree.get_allocator(); }
+
+    [[nodiscard]] constexpr auto key_comp() const -> key_compare { return this->m_tree.key_comp().m_comp; }
+
+public:
+    // Iterator Support
+
+    [[nodiscard]] constexpr auto begin() noexcept -> iterator { return iterator{this->m_tree.begin()}; }
+    [[nodiscard]] constexpr auto begin() const noexcept -> const_iterator { return const_iterator{this->m_tree.begin()}; }
+    [[nodiscard]] constexpr auto cbegin() const noexcept -> const_iterator { return this->begin(); }
+
+    [[nodiscard]] constexpr auto end() noexcept -> iterator { return iterator{this->m_tree.end()}; }
+    [[nodiscard]] constexpr auto end() const noexcept -> const_iterator { return const_iterator{this->m_tree.end()}; }
+    [[nodiscard]] constexpr auto cend() const noexcept -> const_iterator { return this->end(); }
+
+    [[nodiscard]] constexpr auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{this->end()}; }
+    [[nodiscard]] constexpr auto rbegin() const noexcept -> const_reverse_iterator { return const_reverse_iterator{this->end()}; }
+    [[nodiscard]] constexpr auto crbegin() const noexcept -> const_reverse_iterator { return this->rbegin(); }
+
+    [[nodiscard]] constexpr auto rend() noexcept -> reverse_iterator { return reverse_iterator{this->begin()}; }
+    [[nodiscard]] constexpr auto rend() const noexcept -> const_reverse_iterator { return const_reverse_iterator{this->begin()}; }
+    [[nodiscard]] constexpr auto crend() const noexcept -> const_reverse_iterator { return this->rend(); }
+
+public:
+    // Swap function
+
+    /**
+    * @brief Swaps the contents of two maps.
+    */
+    friend constexpr void swap(bst_map &lhs, bst_map &rhs) noexcept(noexcept(swap(lhs.m_tree, rhs.m_tree)))
+    {
+        swap(lhs.m_tree, rhs.m_tree);
+    }
+
+private:
+    // Private member functions
+
+    /**
+    * @brief One descent to the element equivalent to `key`.
+    * @return The tree iterator to it, or the tree's end().
+    */
+    template <class K>
+    [[nodiscard]] constexpr auto __M_find(const K &key) const -> typename tree_t::const_iterator
+    {
+        auto found = this->m_tree.lower_bound(key);
+
+        if ((found != this->m_tree.end()) && not std::invoke(this->m_tree.m_comp, key, *found))
+            return found;
+
+        return this->m_tree.end();
+    }
+
+    /**
+    * @brief Emplaces a pair from `args` unless `key` is present, in one descent.
+    */
+    template <class... ARGS>
+    constexpr auto __M_emplace(const Key &key, ARGS &&...args) -> std::pair<iterator, bool>
+    {
+        auto [node, inserted] = this->m_tree.__M_find_or_emplace(key, std::forward<ARGS>(args)...);
+
+        return {iterator{typename tree_t::const_iterator{node, std::addressof(this->m_tree)}}, inserted};
+    }
+
+private:
+    // Private data members
+    tree_t m_tree{};
+};
+
+
+// Iterator of the map: the tree's in-order iterator, exposing the mapped value as mutable
+// The key stays const (value_type is std::pair<const Key, Value>), so the order cannot break.
+template <typename Key, typename Value, typename Allocator, typename Balance, typename Compare>
+    requires std::strict_weak_order<Compare &, const Key &, const Key &>
+template <bool IsConst>
+struct bst_map<Key, Value, Allocator, Balance, Compare>::Iterator final
+{
+public:
+    friend struct bst_map;
+
+public:
+    using value_type = typename bst_map::value_type;
+
+    using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+    using pointer   = std::conditional_t<IsConst, const value_type *, value_type *>;
+
+    using difference_type = std::ptrdiff_t;
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using iterator_concept  = std::bidirectional_iterator_tag;
+
+public:
+    // Constructors
+    /**
+    * @brief Default constructor.
+    */
+    constexpr Iterator() noexcept = default;
+
+    /**
+    * @brief Wraps a tree iterator.
+    * @param cursor The tree iterator.
+    */
+    explicit constexpr Iterator(typename tree_t::const_iterator cursor) noexcept
+        : m_cursor{cursor}
+    {
+    }
+
+    /**
+    * @brief Converts a mutable iterator to a constant one.
+    */
+    template <bool OtherConst>
+        requires(IsConst && not OtherConst)
+    constexpr Iterator(const Iterator<OtherConst> &other) noexcept
+        : m_cursor{other.m_cursor}
+    {
+    }
+
+public:
+    // Dereferencing operators
+    constexpr auto operator*() const noexcept -> reference { return const_cast<reference>(*this->m_cursor); }
+
+    constexpr auto operator->() const noexcept -> pointer { return std::addressof(**this); }
+
+public:
+    // Increment and decrement operators
+    constexpr auto operator++() noexcept -> Iterator &
+    {
+        ++this->m_cursor;
+        return *this;
+    }
+
+    constexpr auto operator--() noexcept -> Iterator &
+    {
+        --this->m_cursor;
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto operator++(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        std::ranges::advance(*this, 1);
+
+        return copy;
+    }
+
+    [[nodiscard]] constexpr auto operator--(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        std::ranges::advance(*this, -1);
+
+        return copy;
+    }
+
+public:
+    // Equality operator
+    [[nodiscard]]
+    friend constexpr auto operator==(const Iterator &lhs, const Iterator &rhs) noexcept -> bool
+    {
+        return (lhs.m_cursor == rhs.m_cursor);
+    }
+
+private:
+    template <bool>
+    friend struct Iterator;
+
+    typename tree_t::const_iterator m_cursor{}; ///< The underlying tree iterator.
+};
+
+#endif
@@ -0,0 +1,582 @@
+#ifndef __CHUNKED_STACK_HXX__
+#define __CHUNKED_STACK_HXX__
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+#include "details.h"
+
+
+
+/**
+* @brief A stack storing its elements in linked segments of ChunkSize elements each.
+* @details Offers the same interface as stack while paying for one allocation and one link
+*          per ChunkSize elements instead of per element, and keeping neighbouring elements
+*          adjacent in memory. Segments never move, so references to elements stay valid
+*          until the element is popped. The most recently emptied segment is kept as a
+*          spare, which stops a push/pop sequence at a segment boundary from allocating
+*          and freeing a segment every time.
+* @tparam Type The type of elements stored in the stack.
+* @tparam Allocator The allocator used for the segments, rebound to the segment type.
+* @tparam ChunkSize The number of elements per segment.
+*/
+template <class Type, class Allocator = std::allocator<Type>, std::size_t ChunkSize = 64UL>
+    requires (ChunkSize > 0UL)
+struct chunked_stack final
+{
+
+private:
+    // Forward declaration of the Segment structure
+    struct Segment;
+
+private:
+    // Type aliases for allocator and allocator traits
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Segment>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+public:
+    // Type aliases for readability and standard conformance
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using reference       = Type &;
+    using const_reference = const Type &;
+
+    using pointer       = Type *;
+    using const_pointer = const Type *;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Default constructor for chunked_stack.
+    */
+    constexpr chunked_stack() noexcept = default;
+
+    /**
+    * @brief Constructs an empty stack using the given allocator.
+    * @param alloc The allocator used for all segment allocations.
+    */
+    explicit constexpr chunked_stack(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
+    /**
+    * @brief Move constructor for chunked_stack.
+    * @param outer The stack to be moved from.
+    */
+    constexpr chunked_stack(chunked_stack &&outer) noexcept
+        : m_alloc{std::move(outer.m_alloc)}
+    {
+        this->m_top   = std::exchange(outer.m_top, nullptr);
+        this->m_spare = std::exchange(outer.m_spare, nullptr);
+        this->m_used  = std::exchange(outer.m_used, 0UL);
+        this->m_size  = std::exchange(outer.m_size, 0UL);
+    }
+
+    /**
+    * @brief Copy constructor for chunked_stack.
+    * @param outer The stack to be copied from.
+    */
+    constexpr chunked_stack(const chunked_stack &outer)
+        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
+    {
+        this->__M_copy_from(outer);
+    }
+
+    /**
+    * @brief Range constructor using iterators.
+    * @tparam Iterator The type of iterator.
+    * @tparam Sentinel The type of sentinel.
+    * @param begin The beginning iterator of the range.
+    * @param end The ending sentinel of the range.
+    * @param alloc The allocator used for all segment allocations.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<Iterator>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
+            std::bool_constant<std::constructible_from<Type, std::iter_reference_t<Iterator>>>
+        >::value
+    constexpr chunked_stack(Iterator begin, Sentinel end, const Allocator &alloc = Allocator())
+        : chunked_stack(alloc)
+    {
+        try {
+            for (; begin != end; begin = std::ranges::next(std::move(begin)))
+            {
+                this->push(*begin);
+            }
+        }
+        catch (...) {
+            this->__M_release();
+            throw;
+        }
+    }
+
+    /**
+    * @brief Initializer list constructor.
+    * @param list The initializer list of elements.
+    * @param alloc The allocator used for all segment allocations.
+    */
+    constexpr chunked_stack(std::initializer_list<Type> list, const Allocator &alloc = Allocator())
+        : chunked_stack(std::ranges::begin(list), std::ranges::end(list), alloc)
+    {
+    }
+
+    /**
+    * @brief Range constructor using ranges.
+    * @tparam range_t The type of range.
+    * @param from_range_t A tag type to identify the range constructor.
+    * @param range The range of elements.
+    * @param alloc The allocator used for all segment allocations.
+    */
+    template <typename range_t>
+        requires std::conjunction<
+            std::bool_constant<std::ranges::range<range_t>>,
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_reference_t<range_t>>>
+        >::value
+    constexpr chunked_stack(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
+        : chunked_stack(std::ranges::begin(range), std::ranges::end(range), alloc)
+    {
+    }
+
+public:
+    /**
+    * @brief Copy assignment operator.
+    * @param rhs The stack to be copied from.
+    * @return Reference to the newly assigned stack.
+    */
+    constexpr chunked_stack &operator=(const chunked_stack &rhs)
+    {
+        if (this == std::addressof(rhs)) {
+            return *this;
+        }
+
+        this->__M_release();
+
+        if constexpr (typename traits::propagate_on_container_copy_assignment{}) {
+            this->m_alloc = rhs.m_alloc;
+        }
+
+        this->__M_copy_from(rhs);
+        return *this;
+    }
+
+    /**
+    * @brief Move assignment operator.
+    * @details Segments are taken over when the allocators allow it; otherwise the elements
+    *          are moved into segments of this stack's allocator and `rhs` is left empty.
+    * @param rhs The stack to be moved from.
+    * @return Reference to the newly assigned stack.
+    */
+    constexpr chunked_stack &operator=(chunked_stack &&rhs)
+                noexcept(std::disjunction<typename traits::propagate_on_container_move_assignment,
+                                            typename traits::is_always_equal>{})
+    {
+        if (this == std::addressof(rhs)) {
+            return *this;
+        }
+
+        this->__M_release();
+
+        if constexpr (typename traits::propagate_on_container_move_assignment{}) {
+            this->m_alloc = std::move(rhs.m_alloc);
+        }
+        else if constexpr (not typename traits::is_always_equal{}) {
+
+            if (this->m_alloc != rhs.m_alloc) {
+                this->__M_copy_from(rhs);
+                rhs.__M_release();
+                return *this;
+            }
+        }
+
+        this->m_top   = std::exchange(rhs.m_top, nullptr);
+        this->m_spare = std::exchange(rhs.m_spare, nullptr);
+        this->m_used  = std::exchange(rhs.m_used, 0UL);
+        this->m_size  = std::exchange(rhs.m_size, 0UL);
+
+        return *this;
+    }
+
+public:
+    /**
+    * @brief Push an element onto the top of the stack.
+    * @tparam UType The type of the element to be pushed.
+    * @param data The data of the element to be pushed.
+    */
+    template <class UType>
+    constexpr void push(UType &&data)
+        requires(std::constructible_from<Type, UType>)
+    {
+        this->emplace(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Emplace an element onto the top of the stack.
+    * @tparam ARGS The types of arguments for constructing the element.
+    * @param args The arguments for constructing the element.
+    */
+    template <class... ARGS>
+    constexpr void emplace(ARGS &&...args)
+        requires(std::constructible_from<Type, ARGS...>)
+    {
+        if ((this->m_top == nullptr) || (this->m_used == ChunkSize))
+        {
+            this->__M_push_segment();
+        }
+
+        try {
+            ::new (static_cast<void *>(this->m_top->slot(this->m_used))) Type(std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            if (this->m_used == 0UL) {
+                this->__M_pop_segment();
+            }
+            throw;
+        }
+
+        this->m_used = this->m_used + 1UL;
+        this->m_size = this->m_size + 1UL;
+    }
+
+public:
+    /**
+    * @brief Pop the top element from the stack.
+    */
+    constexpr void pop()
+    {
+        if (this->m_size == 0UL)
+            return;
+
+        this->m_used = this->m_used - 1UL;
+        this->m_size = this->m_size - 1UL;
+
+        std::destroy_at(this->m_top->data(this->m_used));
+
+        if (this->m_used == 0UL)
+        {
+            this->__M_pop_segment();
+        }
+    }
+
+    /**
+    * @brief Clear all elements from the stack.
+    * @details One emptied segment is kept as the spare; see shrink_to_fit().
+    *          With a monotonic allocator and a trivially destructible Type the
+    *          segments are dropped in O(1).
+    */
+    constexpr void clear()
+    {
+        if constexpr (details::trivially_releasable<allocator_t, Type>)
+        {
+            this->m_top   = nullptr;
+            this->m_spare = nullptr;
+            this->m_used  = 0UL;
+            this->m_size  = 0UL;
+            return;
+        }
+
+        while (this->m_top != nullptr)
+        {
+            if constexpr (not std::is_trivially_destructible_v<Type>)
+            {
+                std::destroy_n(this->m_top->data(0UL), this->m_used);
+            }
+
+            this->m_used = 0UL;
+            this->__M_pop_segment();
+        }
+
+        this->m_size = 0UL;
+    }
+
+    /**
+    * @brief Return the spare segment to the allocator.
+    */
+    constexpr void shrink_to_fit() noexcept
+    {
+        if (auto spare = std::exchange(this->m_spare, nullptr))
+        {
+            this->__M_destroy_segment(spare);
+        }
+    }
+
+public:
+    /**
+    * @brief Get the top element of the stack (const version).
+    * @return Optional containing the top element if the stack is not empty, otherwise std::nullopt.
+    */
+    [[nodiscard]]
+    constexpr auto top() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (this->m_size == 0UL) {
+            return std::nullopt;
+        }
+        return std::optional{std::cref(*this->m_top->data(this->m_used - 1UL))};
+    }
+
+    /**
+    * @brief Get the top element of the stack.
+    * @return Optional containing the top element if the stack is not empty, otherwise std::nullopt.
+    */
+    [[nodiscard]]
+    constexpr auto top() noexcept -> std::optional<std::reference_wrapper<Type>>
+    {
+        if (this->m_size == 0UL) {
+            return std::nullopt;
+        }
+        return std::optional{std::ref(*this->m_top->data(this->m_used - 1UL))};
+    }
+
+    /**
+    * @brief Visits every element, from the top down, one segment at a time.
+    * @param visitor The callable invoked with each element.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    constexpr void for_each(Visitor visitor) const
+    {
+        auto count = this->m_used;
+
+        for (auto segment = this->m_top; segment != nullptr; segment = segment->m_prev, count = ChunkSize)
+        {
+            while (count != 0UL)
+                std::invoke(visitor, std::as_const(*segment->data(--count)));
+        }
+    }
+
+public:
+    /**
+    * @brief Check if the stack is empty.
+    * @return True if the stack is empty, otherwise false.
+    */
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return (this->m_size == 0UL); }
+
+    /**
+    * @brief Get the size of the stack.
+    * @return The number of elements in the stack.
+    */
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type { return this->m_size; }
+
+    /**
+    * @brief Get a copy of the allocator associated with the stack.
+    * @return The allocator, rebound back to the value type.
+    */
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+public:
+    /**
+    * @brief Swap the contents of two stacks.
+    * @param lhs The first stack.
+    * @param rhs The second stack.
+    */
+    friend constexpr void swap(chunked_stack &lhs, chunked_stack &rhs)
+            noexcept(std::disjunction<typename traits::propagate_on_container_swap,
+                                        typename traits::is_always_equal>{})
+    {
+        if constexpr (typename traits::propagate_on_container_swap{}) {
+            std::swap(lhs.m_alloc, rhs.m_alloc);
+        }
+
+        std::swap(lhs.m_top, rhs.m_top);
+        std::swap(lhs.m_spare, rhs.m_spare);
+        std::swap(lhs.m_used, rhs.m_used);
+        std::swap(lhs.m_size, rhs.m_size);
+    }
+
+public:
+    /**
+    * @brief Destructor for the stack.
+    */
+    constexpr ~chunked_stack() { this->__M_release(); }
+
+private:
+    /**
+    * @brief Make a fresh segment, the spare if there is one, the new top.
+    */
+    constexpr void __M_push_segment()
+    {
+        auto segment = std::exchange(this->m_spare, nullptr);
+
+        if (segment == nullptr)
+        {
+            segment = traits::allocate(this->m_alloc, 1UL);
+            traits::construct(this->m_alloc, std::to_address(segment));
+        }
+
+        segment->m_prev = this->m_top;
+
+        this->m_top  = segment;
+        this->m_used = 0UL;
+    }
+
+    /**
+    * @brief Unlink the empty top segment, keeping it as the spare.
+    */
+    constexpr void __M_pop_segment() noexcept
+    {
+        auto segment = this->m_top;
+
+        this->m_top  = segment->m_prev;
+        this->m_used = (this->m_top != nullptr) ? ChunkSize : 0UL;
+
+        if (this->m_spare == nullptr) {
+            this->m_spare = segment;
+        }
+        else {
+            this->__M_destroy_segment(segment);
+        }
+    }
+
+    /**
+    * @brief Destroy and deallocate a segment whose elements have been destroyed.
+    */
+    constexpr void __M_destroy_segment(Segment *segment) noexcept
+    {
+        traits::destroy(this->m_alloc, std::to_address(segment));
+        traits::deallocate(this->m_alloc, std::to_address(segment), 1UL);
+    }
+
+    /**
+    * @brief Destroy every element and return every segment, the spare included.
+    */
+    constexpr void __M_release() noexcept
+    {
+        this->clear();
+        this->shrink_to_fit();
+    }
+
+    /**
+    * @brief Copy the elements of `outer` into an identically shaped chain of segments, or
+    *        move them when `outer` is not const.
+    * @details The chain is built top-down; a throwing copy destroys what was built so far.
+    * @tparam Outer chunked_stack, possibly const.
+    */
+    template <class Outer>
+    constexpr void __M_copy_from(Outer &outer)
+    {
+        Segment *head = nullptr;
+        Segment **link = std::addressof(head);
+
+        size_type completed = 0UL;
+
+        try {
+            for (auto source = outer.m_top; source != nullptr; source = source->m_prev)
+            {
+                auto segment = traits::allocate(this->m_alloc, 1UL);
+                traits::construct(this->m_alloc, std::to_address(segment));
+                segment->m_prev = nullptr;
+
+                *link = segment;
+                link = std::addressof(segment->m_prev);
+
+                auto count = (completed == 0UL) ? outer.m_used : ChunkSize;
+
+                for (size_type index = 0UL; index != count; ++index)
+                {
+                    try {
+                        if constexpr (std::is_const_v<Outer>)
+                            ::new (static_cast<void *>(segment->slot(index))) Type(*source->data(index));
+                        else
+                            ::new (static_cast<void *>(segment->slot(index))) Type(std::move(*source->data(index)));
+                    }
+                    catch (...) {
+                        std::destroy_n(segment->data(0UL), index);
+                        throw;
+                    }
+                }
+
+                completed = completed + 1UL;
+            }
+        }
+        catch (...) {
+            for (size_type index = 0UL; head != nullptr; ++index)
+            {
+                auto segment = std::exchange(head, head->m_prev);
+
+                if (index < completed) {
+                    std::destroy_n(segment->data(0UL), (index == 0UL) ? outer.m_used : ChunkSize);
+                }
+
+                this->__M_destroy_segment(segment);
+            }
+            throw;
+        }
+
+        this->m_top  = head;
+        this->m_used = outer.m_used;
+        this->m_size = outer.m_size;
+    }
+
+private:
+    // Member variables
+    Segment *m_top{nullptr};   // Segment holding the top element
+    Segment *m_spare{nullptr}; // Emptied segment kept for the next push
+    size_type m_used{0UL};     // Number of elements in the top segment
+    size_type m_size{0UL};     // Number of elements in the stack
+    [[no_unique_address]] allocator_t m_alloc{};
+};
+
+// Deduction guides
+
+/**
+* @brief Deduction guide for chunked_stack from range.
+* @tparam range_t Type of the range.
+*/
+template <class range_t>
+chunked_stack(details::from_range_t, range_t &&) -> chunked_stack<std::ranges::range_value_t<range_t>>;
+
+/**
+* @brief Deduction guide for chunked_stack from iterators and sentinels.
+* @tparam Iterator Type of the iterator.
+* @tparam Sentinel Type of the sentinel.
+*/
+template <class Iterator, class Sentinel>
+chunked_stack(Iterator, Sentinel) -> chunked_stack<std::iter_value_t<Iterator>>;
+
+
+
+/**
+* @brief A segment of a chunked_stack: a link to the segment below and raw storage
+*        for ChunkSize elements.
+* @tparam Type The type of data held by the segment.
+* @tparam Allocator The allocator type of the owning stack.
+* @tparam ChunkSize The number of elements per segment.
+*/
+template <class Type, class Allocator, std::size_t ChunkSize>
+    requires (ChunkSize > 0UL)
+struct chunked_stack<Type, Allocator, ChunkSize>::Segment final
+{
+    // User-provided so that constructing a segment never zero-fills m_storage; the
+    // stack sets m_prev itself whenever it links a segment in
+    Segment() noexcept {}
+
+    [[nodiscard]] auto slot(size_type index) noexcept -> void *
+    {
+        return this->m_storage + (index * sizeof(Type));
+    }
+
+    [[nodiscard]] auto data(size_type index) noexcept -> Type *
+    {
+        return std::launder(reinterpret_cast<Type *>(this->slot(index)));
+    }
+
+    Segment *m_prev;                                             // Segment below, nullptr for the bottom
+    alignas(Type) std::byte m_storage[ChunkSize * sizeof(Type)]; // Storage of the elements
+};
+
+#endif
@@ -0,0 +1,1008 @@
+#ifndef __CONCURRENT_BINARYSEARCH_HXX__
+#define __CONCURRENT_BINARYSEARCH_HXX__
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "details.h"
+
+
+
+/**
+* @brief A read-mostly ordered set: wait-free readers over a path-copied AVL tree.
+* @details Published nodes are immutable. A writer copies the path from the root to the
+*          nodes it changes (plus the siblings a rotation touches), then publishes the new
+*          root with a single store, so a reader always sees one consistent version of the
+*          tree. Writers are serialized by a mutex; readers never take it.
+*
+*          Nodes replaced by a writer are retired rather than freed: readers announce
+*          themselves in per-thread counters split by epoch parity, and once
+*          `reclaim_threshold` nodes are retired the writer flips the epoch twice, waiting
+*          each time for the readers of the previous parity to leave. Any reader that could
+*          still hold a retired node has then quiesced, and the batch is freed.
+*
+*          Lookups return copies; snapshot() pins a version for iteration and for lookups
+*          by reference. Duplicates are kept, as in binary_search_tree.
+* @tparam Type The type of elements stored in the tree; copied along modified paths.
+* @tparam Allocator The allocator used for the nodes; only writers use it, under the lock.
+* @tparam Compare The ordering of the elements; a transparent comparator enables lookups
+*         by any key type it can compare with Type.
+*/
+template <typename Type, typename Allocator = std::allocator<Type>, typename Compare = std::less<Type>>
+    requires std::conjunction<
+        std::bool_constant<std::copy_constructible<Type>>,
+        std::bool_constant<std::strict_weak_order<Compare &, const Type &, const Type &>>
+    >::value
+struct concurrent_binary_search_tree final
+{
+private:
+    // Nested Node struct representing an immutable node of a published version
+    struct Node;
+
+    // Nested in-order iterator over a pinned version
+    struct Iterator;
+
+    // Nested guard pinning one version of the tree
+    struct Snapshot;
+
+    // Reader counter pair of one slot, indexed by epoch parity
+    using counter_t = std::atomic<std::size_t>;
+
+private:
+    // Type aliases for allocator and allocator traits
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+public:
+    // Public typedefs for types used in the tree
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using reference       = const Type &;
+    using const_reference = const Type &;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using key_compare   = Compare;
+    using value_compare = Compare;
+
+    // Published elements are immutable, so iterators are constant iterators
+    using iterator       = Iterator;
+    using const_iterator = Iterator;
+
+    using snapshot_type = Snapshot;
+
+public:
+    // Number of reader slots; threads beyond this share slots, which stays correct
+    static constexpr size_type reader_slots = 64UL;
+
+    // Number of retired nodes that triggers a grace period and frees the batch
+    static constexpr size_type reclaim_threshold = 128UL;
+
+    // Height bound of the AVL tree for any node count addressable in 64 bits
+    static constexpr size_type max_height = 96UL;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Default constructor.
+    */
+    concurrent_binary_search_tree() noexcept = default;
+
+    /**
+    * @brief Constructs an empty tree using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit concurrent_binary_search_tree(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
+    /**
+    * @brief Constructs an empty tree ordered by `comp`.
+    * @param comp The comparator ordering the elements.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit concurrent_binary_search_tree(const Compare &comp, const Allocator &alloc = Allocator())
+        : m_alloc{alloc}, m_comp{comp}
+    {
+    }
+
+    concurrent_binary_search_tree(const concurrent_binary_search_tree &) = delete;
+    concurrent_binary_search_tree &operator=(const concurrent_binary_search_tree &) = delete;
+
+public:
+    // Writers
+    // Serialized by an internal mutex. A thread holding a snapshot must release it before
+    // modifying the tree: a write may wait for every pinned reader to leave.
+
+    /**
+    * @brief Insert a value into the tree.
+    * @tparam UType The type of the value to be inserted.
+    * @param data The value to be inserted.
+    */
+    template <class UType>
+    void insert(UType &&data)
+        requires std::constructible_from<Type, UType>
+    {
+        this->emplace(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Emplace a value into the tree.
+    * @details The path is copied privately before it is published, so a throwing
+    *          constructor, copy or allocation leaves the published version untouched.
+    * @tparam ARGS The types of arguments to construct the element.
+    * @param args The arguments to construct the element.
+    */
+    template <class... ARGS>
+    void emplace(ARGS &&...args)
+        requires std::constructible_from<Type, ARGS...>
+    {
+        std::lock_guard lock{this->m_writer};
+
+        this->__M_begin_update();
+
+        try {
+            auto leaf = this->__M_create_node(nullptr, nullptr, std::forward<ARGS>(args)...);
+
+            this->__M_publish(this->__M_insert(this->__M_root(), leaf), +1);
+        }
+        catch (...) {
+            this->__M_abort_update();
+            throw;
+        }
+    }
+
+    /**
+    * @brief Remove one element equivalent to `key`.
+    * @return bool Whether an element was removed.
+    */
+    auto remove(const Type &key) -> bool { return this->__M_remove_key(key); }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    auto remove(const Key &key) -> bool
+    {
+        return this->__M_remove_key(key);
+    }
+
+    /**
+    * @brief Remove every element. The nodes are retired, not freed in place.
+    */
+    void clear()
+    {
+        std::lock_guard lock{this->m_writer};
+
+        this->__M_begin_update();
+
+        auto root = this->__M_root();
+
+        this->m_root.store(nullptr, std::memory_order_seq_cst);
+        this->m_size.store(0UL, std::memory_order_relaxed);
+
+        this->__M_retire_all(root);
+        this->__M_maybe_reclaim();
+    }
+
+    /**
+    * @brief Waits for the current readers to leave, then frees every retired node.
+    */
+    void reclaim()
+    {
+        std::lock_guard lock{this->m_writer};
+
+        this->__M_reclaim();
+    }
+
+public:
+    // Readers
+    // Wait-free: each pins the current version with one increment of a per-thread counter.
+
+    /**
+    * @brief Search for a value in the tree.
+    * @return std::optional<Type> A copy of an equivalent element, or std::nullopt.
+    */
+    [[nodiscard]] auto search(const Type &key) const -> std::optional<Type>
+    {
+        return this->__M_copy_of(this->snapshot().search(key));
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] auto search(const Key &key) const -> std::optional<Type>
+    {
+        return this->__M_copy_of(this->snapshot().search(key));
+    }
+
+    /**
+    * @brief Whether an element equivalent to `key` is in the tree.
+    */
+    [[nodiscard]] auto contains(const Type &key) const noexcept -> bool
+    {
+        return this->snapshot().search(key).has_value();
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] auto contains(const Key &key) const noexcept -> bool
+    {
+        return this->snapshot().search(key).has_value();
+    }
+
+    /**
+    * @brief Get the minimum value in the tree.
+    */
+    [[nodiscard]] auto min() const -> std::optional<Type> { return this->__M_copy_of(this->snapshot().min()); }
+
+    /**
+    * @brief Get the maximum value in the tree.
+    */
+    [[nodiscard]] auto max() const -> std::optional<Type> { return this->__M_copy_of(this->snapshot().max()); }
+
+    /**
+    * @brief Pins the current version of the tree.
+    * @details Until the snapshot is destroyed, its nodes are not freed: the snapshot can be
+    *          iterated and searched by reference while writers publish newer versions.
+    */
+    [[nodiscard]] auto snapshot() const noexcept -> snapshot_type { return snapshot_type{this}; }
+
+public:
+    // Utility functions
+
+    /**
+    * @brief Check if the tree is empty. Only a snapshot while writers are active.
+    */
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return (this->m_root.load(std::memory_order_acquire) == nullptr);
+    }
+
+    /**
+    * @brief Get the size of the tree. Only a snapshot while writers are active.
+    */
+    [[nodiscard]] auto size() const noexcept -> size_type { return this->m_size.load(std::memory_order_relaxed); }
+
+    /**
+    * @brief Get a copy of the allocator, rebound back to the value type.
+    */
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type { return allocator_type(this->m_alloc); }
+
+    /**
+    * @brief Get a copy of the comparator ordering the elements.
+    */
+    [[nodiscard]] auto key_comp() const -> key_compare { return this->m_comp; }
+
+public:
+    // Destructor
+
+    /**
+    * @brief Destroys every element and frees every node, published or retired.
+    * @note No thread may be using the tree, or hold a snapshot of it, during destruction.
+    */
+    ~concurrent_binary_search_tree()
+    {
+        this->__M_destroy(this->__M_root());
+        this->__M_free_chain(std::exchange(this->m_retired, nullptr));
+    }
+
+private:
+    // Epoch-based reclamation
+
+    /**
+    * @brief The reader slot of the calling thread; threads are spread round-robin.
+    */
+    [[nodiscard]] static auto __M_slot_index() noexcept -> size_type
+    {
+        static std::atomic<size_type> next{0UL};
+        thread_local const size_type index = next.fetch_add(1UL, std::memory_order_relaxed) % reader_slots;
+
+        return index;
+    }
+
+    /**
+    * @brief Announces a reader in the counter of the current epoch parity.
+    * @details The increment is ordered before the reader loads the root: a writer that
+    *          misses it when draining has already published the root the reader will load.
+    * @return counter_t* The counter to decrement when the reader leaves.
+    */
+    auto __M_enter() const noexcept -> counter_t *
+    {
+        auto parity = this->m_epoch.load(std::memory_order_relaxed) & 1UL;
+        auto counter = std::addressof(this->m_slots[__M_slot_index()].m_readers[parity]);
+
+        counter->fetch_add(1UL, std::memory_order_seq_cst);
+
+        return counter;
+    }
+
+    static void __M_leave(counter_t *counter) noexcept { counter->fetch_sub(1UL, std::memory_order_release); }
+
+    /**
+    * @brief Waits until no reader can still hold a node retired before the call.
+    * @details Each phase moves new readers to the other parity, then drains the old one.
+    *          A reader that read the epoch before a flip but announced itself after it is
+    *          counted under a stale parity; two phases drain both, and new readers cannot
+    *          keep either phase waiting.
+    */
+    void __M_synchronize() noexcept
+    {
+        for (int phase = 0; phase != 2; ++phase)
+        {
+            auto parity = this->m_epoch.fetch_add(1UL, std::memory_order_seq_cst) & 1UL;
+
+            for (auto &slot : this->m_slots)
+            {
+                for (size_type spins = 0UL; slot.m_readers[parity].load(std::memory_order_seq_cst) != 0UL; ++spins)
+                {
+                    if (spins < 64UL)
+                        details::cpu_relax();
+                    else
+                        std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    /**
+    * @brief Frees the retired nodes once the readers that could see them have left.
+    */
+    void __M_reclaim() noexcept
+    {
+        if (this->m_retired == nullptr)
+            return;
+
+        this->__M_synchronize();
+
+        this->__M_free_chain(std::exchange(this->m_retired, nullptr));
+        this->m_retired_count = 0UL;
+    }
+
+    void __M_maybe_reclaim() noexcept
+    {
+        if (this->m_retired_count >= reclaim_threshold)
+            this->__M_reclaim();
+    }
+
+private:
+    // Update bookkeeping
+    // Nodes created by the update in progress carry its version: they are still private
+    // and may be modified in place. Any other node must be copied before it changes.
+
+    void __M_begin_update() noexcept
+    {
+        this->m_version = this->m_version + 1UL;
+        this->m_fresh = nullptr;
+        this->m_replaced = nullptr;
+    }
+
+    /**
+    * @brief Publishes the new root and retires the nodes the update replaced.
+    */
+    void __M_publish(Node *root, int delta) noexcept
+    {
+        this->m_root.store(root, std::memory_order_seq_cst);
+
+        if (delta > 0)
+            this->m_size.fetch_add(1UL, std::memory_order_relaxed);
+        else if (delta < 0)
+            this->m_size.fetch_sub(1UL, std::memory_order_relaxed);
+
+        while (auto node = this->m_replaced)
+        {
+            this->m_replaced = node->m_link;
+            this->__M_retire(node);
+        }
+
+        this->__M_maybe_reclaim();
+    }
+
+    /**
+    * @brief Frees the private nodes of a failed update; the published tree is untouched.
+    */
+    void __M_abort_update() noexcept
+    {
+        this->__M_free_chain(std::exchange(this->m_fresh, nullptr));
+        this->m_replaced = nullptr;
+    }
+
+    void __M_retire(Node *node) noexcept
+    {
+        node->m_link = this->m_retired;
+        this->m_retired = node;
+        this->m_retired_count = this->m_retired_count + 1UL;
+    }
+
+    void __M_retire_all(Node *node) noexcept
+    {
+        if (node == nullptr)
+            return;
+
+        this->__M_retire_all(node->m_left);
+        this->__M_retire_all(node->m_right);
+        this->__M_retire(node);
+    }
+
+    // Records a published node that the update is replacing
+    void __M_replace(Node *node) noexcept
+    {
+        node->m_link = this->m_replaced;
+        this->m_replaced = node;
+    }
+
+    /**
+    * @brief Returns a node the update may modify: `node` itself if it is private,
+    *        otherwise a private copy, the original being retired on publication.
+    */
+    auto __M_own(Node *node) -> Node *
+    {
+        if (node->m_version == this->m_version)
+            return node;
+
+        auto copy = this->__M_create_node(node->m_left, node->m_right, node->m_data);
+
+        copy->m_height = node->m_height;
+        this->__M_replace(node);
+
+        return copy;
+    }
+
+private:
+    // Path-copying AVL updates
+
+    [[nodiscard]] static auto __M_height(const Node *node) noexcept -> int
+    {
+        return (node != nullptr) ? node->m_height : 0;
+    }
+
+    static void __M_update(Node *node) noexcept
+    {
+        node->m_height = static_cast<std::int8_t>(1 + std::max(__M_height(node->m_left), __M_height(node->m_right)));
+    }
+
+    // Rotations take a private node, and copy the child they lift if it is still shared
+    auto __M_rotate_left(Node *node) -> Node *
+    {
+        auto pivot = this->__M_own(node->m_right);
+
+        node->m_right = pivot->m_left;
+        pivot->m_left = node;
+
+        __M_update(node);
+        __M_update(pivot);
+
+        return pivot;
+    }
+
+    auto __M_rotate_right(Node *node) -> Node *
+    {
+        auto pivot = this->__M_own(node->m_left);
+
+        node->m_left = pivot->m_right;
+        pivot->m_right = node;
+
+        __M_update(node);
+        __M_update(pivot);
+
+        return pivot;
+    }
+
+    /**
+    * @brief Restores the AVL invariant at a private node whose subtrees differ by at most 2.
+    * @return Node* The root of the rebalanced subtree.
+    */
+    auto __M_balance(Node *node) -> Node *
+    {
+        auto factor = __M_height(node->m_left) - __M_height(node->m_right);
+
+        if (factor > 1)
+        {
+            auto left = node->m_left;
+
+            if (__M_height(left->m_left) < __M_height(left->m_right))
+                node->m_left = this->__M_rotate_left(this->__M_own(left));
+
+            return this->__M_rotate_right(node);
+        }
+
+        if (factor < -1)
+        {
+            auto right = node->m_right;
+
+            if (__M_height(right->m_right) < __M_height(right->m_left))
+                node->m_right = this->__M_rotate_right(this->__M_own(right));
+
+            return this->__M_rotate_left(node);
+        }
+
+        __M_update(node);
+
+        return node;
+    }
+
+    auto __M_insert(Node *current, Node *leaf) -> Node *
+    {
+        if (current == nullptr)
+            return leaf;
+
+        details::prefetch(current->m_left);
+        details::prefetch(current->m_right);
+
+        auto copy = this->__M_own(current);
+
+        if (this->m_comp(leaf->m_data, copy->m_data))
+            copy->m_left = this->__M_insert(copy->m_left, leaf);
+        else
+            copy->m_right = this->__M_insert(copy->m_right, leaf);
+
+        return this->__M_balance(copy);
+    }
+
+    /**
+    * @brief Detaches the minimum of a subtree.
+    * @param minimum Receives the detached (still published) node.
+    * @return Node* The root of the subtree without it.
+    */
+    auto __M_remove_min(Node *current, Node *&minimum) -> Node *
+    {
+        if (current->m_left == nullptr)
+        {
+            minimum = current;
+            return current->m_right;
+        }
+
+        auto left = this->__M_remove_min(current->m_left, minimum);
+        auto copy = this->__M_own(current);
+
+        copy->m_left = left;
+
+        return this->__M_balance(copy);
+    }
+
+    /**
+    * @brief Removes one element equivalent to `key` from a subtree.
+    * @param removed Set when an element was found; the subtree is returned unchanged otherwise.
+    */
+    template <class Key>
+    auto __M_remove(Node *current, const Key &key, bool &removed) -> Node *
+    {
+        if (current == nullptr)
+            return nullptr;
+
+        details::prefetch(current->m_left);
+        details::prefetch(current->m_right);
+
+        if (this->m_comp(key, current->m_data))
+        {
+            auto left = this->__M_remove(current->m_left, key, removed);
+
+            if (not removed)
+                return current;
+
+            auto copy = this->__M_own(current);
+            copy->m_left = left;
+
+            return this->__M_balance(copy);
+        }
+
+        if (this->m_comp(current->m_data, key))
+        {
+            auto right = this->__M_remove(current->m_right, key, removed);
+
+            if (not removed)
+                return current;
+
+            auto copy = this->__M_own(current);
+            copy->m_right = right;
+
+            return this->__M_balance(copy);
+        }
+
+        removed = true;
+        this->__M_replace(current);
+
+        if (current->m_left == nullptr)
+            return current->m_right;
+
+        if (current->m_right == nullptr)
+            return current->m_left;
+
+        // Two children: the successor, copied, takes the place of the removed node
+        Node *successor = nullptr;
+
+        auto right = this->__M_remove_min(current->m_right, successor);
+        auto copy = this->__M_create_node(current->m_left, right, successor->m_data);
+
+        this->__M_replace(successor);
+
+        return this->__M_balance(copy);
+    }
+
+    template <class Key>
+    auto __M_remove_key(const Key &key) -> bool
+    {
+        std::lock_guard lock{this->m_writer};
+
+        this->__M_begin_update();
+
+        try {
+            bool removed = false;
+
+            auto root = this->__M_remove(this->__M_root(), key, removed);
+
+            if (removed)
+                this->__M_publish(root, -1);
+            else
+                this->__M_abort_update();
+
+            return removed;
+        }
+        catch (...) {
+            this->__M_abort_update();
+            throw;
+        }
+    }
+
+private:
+    // Helper functions
+
+    [[nodiscard]] auto __M_root() const noexcept -> Node * { return this->m_root.load(std::memory_order_relaxed); }
+
+    /**
+    * @brief Allocates a private node of the update in progress.
+    */
+    template <class... ARGS>
+    auto __M_create_node(Node *left, Node *right, ARGS &&...args) -> Node *
+    {
+        auto node = traits::allocate(this->m_alloc, 1UL);
+
+        try {
+            traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            traits::deallocate(this->m_alloc, node, 1UL);
+            throw;
+        }
+
+        node->m_left = left;
+        node->m_right = right;
+        node->m_height = 1;
+        node->m_version = this->m_version;
+
+        node->m_link = this->m_fresh;
+        this->m_fresh = node;
+
+        return node;
+    }
+
+    void __M_destroy_node(Node *node) noexcept
+    {
+        traits::destroy(this->m_alloc, std::to_address(node));
+        traits::deallocate(this->m_alloc, node, 1UL);
+    }
+
+    // Frees a chain of nodes linked through m_link
+    void __M_free_chain(Node *node) noexcept
+    {
+        while (node != nullptr)
+        {
+            auto next = node->m_link;
+
+            this->__M_destroy_node(node);
+
+            node = next;
+        }
+    }
+
+    void __M_destroy(Node *node) noexcept
+    {
+        if (node == nullptr)
+            return;
+
+        this->__M_destroy(node->m_left);
+        this->__M_destroy(node->m_right);
+        this->__M_destroy_node(node);
+    }
+
+    [[nodiscard]] static auto __M_copy_of(std::optional<std::reference_wrapper<const Type>> found)
+        -> std::optional<Type>
+    {
+        if (found.has_value())
+            return std::optional<Type>{found->get()};
+
+        return std::nullopt;
+    }
+
+private:
+    // A pair of reader counters, padded to a cache line
+    struct alignas(details::cache_line_size) Slot
+    {
+        counter_t m_readers[2]{};
+    };
+
+private:
+    // Member variables
+    alignas(details::cache_line_size) std::atomic<Node *> m_root{nullptr}; // Published version
+    std::atomic<size_type> m_size{0UL};                                    // Number of elements
+    alignas(details::cache_line_size) std::atomic<size_type> m_epoch{0UL}; // Its parity selects the readers' counter
+    mutable Slot m_slots[reader_slots]{};                                  // Reader counters
+
+    // Writer state, guarded by m_writer
+    alignas(details::cache_line_size) std::mutex m_writer{};
+    Node *m_retired{nullptr};          // Nodes waiting for a grace period
+    size_type m_retired_count{0UL};
+    Node *m_fresh{nullptr};            // Nodes created by the update in progress
+    Node *m_replaced{nullptr};         // Published nodes the update in progress replaces
+    std::uint64_t m_version{0UL};      // Version of the update in progress
+    [[no_unique_address]] allocator_t m_alloc{};
+    [[no_unique_address]] Compare m_comp{};
+};
+
+
+
+/**
+* @brief A node of a concurrent_binary_search_tree.
+* @details Immutable once published; m_version and m_link are only used by writers.
+* @tparam Type The type of data held by the node.
+* @tparam Allocator The allocator type of the owning tree.
+* @tparam Compare The comparator type of the owning tree.
+*/
+template <typename Type, typename Allocator, typename Compare>
+    requires std::conjunction<
+        std::bool_constant<std::copy_constructible<Type>>,
+        std::bool_constant<std::strict_weak_order<Compare &, const Type &, const Type &>>
+    >::value
+struct concurrent_binary_search_tree<Type, Allocator, Compare>::Node final
+{
+    template <class... ARGS>
+    explicit Node(ARGS &&...args) : m_data(std::forward<ARGS>(args)...)
+    {
+    }
+
+    Node *m_left{nullptr};
+    Node *m_right{nullptr};
+    Node *m_link{nullptr};         // Chains private, replaced or retired nodes
+    std::uint64_t m_version{0UL};  // The update that created the node
+    std::int8_t m_height{1};
+    Type m_data;
+};
+
+
+
+/**
+* @brief A pinned version of a concurrent_binary_search_tree.
+* @details Holds the tree's reader counter for its lifetime, so none of the nodes it can
+*          reach are freed. Keep it short-lived: retired nodes pile up behind it.
+*/
+template <typename Type, typename Allocator, typename Compare>
+    requires std::conjunction<
+        std::bool_constant<std::copy_constructible<Type>>,
+        std::bool_constant<std::strict_weak_order<Compare &, const Type &, const Type &>>
+    >::value
+struct concurrent_binary_search_tree<Type, Allocator, Compare>::Snapshot final
+{
+public:
+    friend struct concurrent_binary_search_tree;
+
+public:
+    // Constructors and Destructor
+
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+
+    Snapshot(Snapshot &&outer) noexcept
+        : m_tree{outer.m_tree}, m_root{outer.m_root}, m_counter{std::exchange(outer.m_counter, nullptr)}
+    {
+    }
+
+    Snapshot &operator=(Snapshot &&rhs) noexcept
+    {
+        if (this != std::addressof(rhs))
+        {
+            this->__M_release();
+
+            this->m_tree = rhs.m_tree;
+            this->m_root = rhs.m_root;
+            this->m_counter = std::exchange(rhs.m_counter, nullptr);
+        }
+        return *this;
+    }
+
+    ~Snapshot() { this->__M_release(); }
+
+public:
+    // Lookups, valid as long as the snapshot
+
+    /**
+    * @brief Search for a value in the pinned version.
+    * @return A reference to an equivalent element, or std::nullopt.
+    */
+    [[nodiscard]] auto search(const Type &key) const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_search(key);
+    }
+
+    template <class Key>
+        requires details::transparent_comparator<Compare>
+    [[nodiscard]] auto search(const Key &key) const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->__M_search(key);
+    }
+
+    [[nodiscard]] auto min() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (auto current = this->m_root)
+        {
+            while (current->m_left != nullptr)
+                current = current->m_left;
+
+            return std::optional{std::cref(current->m_data)};
+        }
+
+        return std::nullopt;
+    }
+
+    [[nodiscard]] auto max() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (auto current = this->m_root)
+        {
+            while (current->m_right != nullptr)
+                current = current->m_right;
+
+            return std::optional{std::cref(current->m_data)};
+        }
+
+        return std::nullopt;
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return (this->m_root == nullptr); }
+
+public:
+    // Iterator Support
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator { return const_iterator{this->m_root}; }
+    [[nodiscard]] auto end() const noexcept -> const_iterator { return const_iterator{}; }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator { return this->begin(); }
+    [[nodiscard]] auto cend() const noexcept -> const_iterator { return this->end(); }
+
+private:
+    // Pins the tree: announce the reader first, then load the root
+    explicit Snapshot(const concurrent_binary_search_tree *tree) noexcept
+        : m_tree{tree}, m_counter{tree->__M_enter()}
+    {
+        this->m_root = tree->m_root.load(std::memory_order_seq_cst);
+    }
+
+    void __M_release() noexcept
+    {
+        if (this->m_counter != nullptr)
+            __M_leave(std::exchange(this->m_counter, nullptr));
+    }
+
+    template <class Key>
+    auto __M_search(const Key &key) const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        auto &comp = this->m_tree->m_comp;
+
+        for (auto current = this->m_root; current != nullptr;)
+        {
+            details::prefetch(current->m_left);
+            details::prefetch(current->m_right);
+
+            if (comp(key, current->m_data))
+                current = current->m_left;
+            else if (comp(current->m_data, key))
+                current = current->m_right;
+            else
+                return std::optional{std::cref(current->m_data)};
+        }
+
+        return std::nullopt;
+    }
+
+private:
+    const concurrent_binary_search_tree *m_tree; // The pinned tree
+    const Node *m_root{nullptr};                 // Root of the pinned version
+    counter_t *m_counter{nullptr};               // Reader counter to release
+};
+
+
+
+/**
+* @brief In-order iterator over a pinned version.
+* @details Nodes have no parent links (they are shared between versions), so the iterator
+*          keeps the path to its node; copying it copies that path.
+*/
+template <typename Type, typename Allocator, typename Compare>
+    requires std::conjunction<
+        std::bool_constant<std::copy_constructible<Type>>,
+        std::bool_constant<std::strict_weak_order<Compare &, const Type &, const Type &>>
+    >::value
+struct concurrent_binary_search_tree<Type, Allocator, Compare>::Iterator final
+{
+public:
+    using value_type = Type;
+
+    using reference = const Type &;
+    using pointer   = const Type *;
+
+    using difference_type = std::ptrdiff_t;
+
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept  = std::forward_iterator_tag;
+
+public:
+    // Constructors
+
+    Iterator() noexcept = default;
+
+    /**
+    * @brief Constructs an iterator on the minimum of the subtree rooted at `root`.
+    */
+    explicit Iterator(const Node *root) noexcept { this->__M_descend(root); }
+
+public:
+    // Operators
+
+    auto operator*() const noexcept -> reference { return this->m_path[this->m_depth - 1UL]->m_data; }
+
+    auto operator->() const noexcept -> pointer { return std::addressof(**this); }
+
+    auto operator++() noexcept -> Iterator &
+    {
+        auto node = this->m_path[--this->m_depth];
+
+        this->__M_descend(node->m_right);
+
+        return *this;
+    }
+
+    auto operator++(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    friend auto operator==(const Iterator &lhs, const Iterator &rhs) noexcept -> bool
+    {
+        return (lhs.__M_node() == rhs.__M_node());
+    }
+
+private:
+    // Pushes the left spine of `node`; the top of the path is the current node
+    void __M_descend(const Node *node) noexcept
+    {
+        for (; node != nullptr; node = node->m_left)
+        {
+            details::prefetch(node->m_left);
+
+            this->m_path[this->m_depth++] = node;
+        }
+    }
+
+    [[nodiscard]] auto __M_node() const noexcept -> const Node *
+    {
+        return (this->m_depth != 0UL) ? this->m_path[this->m_depth - 1UL] : nullptr;
+    }
+
+private:
+    std::array<const Node *, max_height> m_path{}; // Ancestors still to be visited, current on top
+    size_type m_depth{0UL};
+};
+
+#endif
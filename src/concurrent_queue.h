@@ -0,0 +1,661 @@
+#ifndef __CONCURRENT_QUEUE_HXX__
+#define __CONCURRENT_QUEUE_HXX__
+
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "details.h"
+
+/**
+* @brief A bounded lock-free queue for exactly one producer and one consumer thread.
+* @details The producer only writes the tail index and the consumer only writes the head
+*          index; each lives on its own cache line together with a private copy of the other
+*          side's index, so the shared line is only read when the cached copy says the
+*          queue looks full (producer) or empty (consumer).
+* @tparam Type The type of elements stored in the queue.
+* @tparam Allocator The allocator used for the element buffer.
+*/
+template <class Type, class Allocator = std::allocator<Type>>
+struct spsc_queue final
+{
+
+public:
+    // Public member type aliases
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    // Allocator and allocator traits
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Constructs an empty queue.
+    * @param capacity The minimum number of elements, rounded up to a power of two.
+    * @param alloc The allocator used for the element buffer.
+    */
+    explicit spsc_queue(size_type capacity, const Allocator &alloc = Allocator())
+        : m_capacity{std::bit_ceil(std::max<size_type>(capacity, 2UL))}, m_alloc{alloc}
+    {
+        this->m_buffer = traits::allocate(this->m_alloc, this->m_capacity);
+    }
+
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+
+public:
+    // Producer side
+
+    /**
+    * @brief Constructs an element in-place at the back of the queue unless it is full.
+    * @tparam ARGS Types of the arguments to construct the element.
+    * @param args Arguments to construct the element.
+    * @return True if the element was added.
+    */
+    template <class... ARGS>
+    auto try_emplace(ARGS &&...args) -> bool
+        requires std::constructible_from<Type, ARGS...>
+    {
+        auto tail = this->m_tail.load(std::memory_order_relaxed);
+
+        if (tail - this->m_head_cache == this->m_capacity)
+        {
+            this->m_head_cache = this->m_head.load(std::memory_order_acquire);
+
+            if (tail - this->m_head_cache == this->m_capacity)
+            {
+                return false;
+            }
+        }
+
+        traits::construct(this->m_alloc, std::to_address(this->__M_slot(tail)), std::forward<ARGS>(args)...);
+
+        this->m_tail.store(tail + 1UL, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    * @brief Adds an element to the back of the queue unless it is full.
+    * @tparam UType Type of the element to be added.
+    * @param data The element to be added.
+    * @return True if the element was added.
+    */
+    template <class UType>
+    auto try_push(UType &&data) -> bool
+        requires std::constructible_from<Type, UType>
+    {
+        return this->try_emplace(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Adds up to `count` elements from `first`, publishing them with a single store.
+    * @details Pass a std::move_iterator to move elements in. If constructing an element
+    *          throws, the elements constructed before it are published and the exception
+    *          is rethrown.
+    * @param first The beginning of the elements to add.
+    * @param count The maximum number of elements to add.
+    * @return The number of elements added.
+    */
+    template <std::input_iterator Iterator>
+    auto try_push_n(Iterator first, size_type count) -> size_type
+        requires std::constructible_from<Type, std::iter_reference_t<Iterator>>
+    {
+        auto tail = this->m_tail.load(std::memory_order_relaxed);
+
+        if (this->m_capacity - (tail - this->m_head_cache) < count)
+        {
+            this->m_head_cache = this->m_head.load(std::memory_order_acquire);
+        }
+
+        count = std::min(count, this->m_capacity - (tail - this->m_head_cache));
+
+        size_type index = 0UL;
+
+        try {
+            for (; index != count; ++index, ++first)
+            {
+                traits::construct(this->m_alloc, std::to_address(this->__M_slot(tail + index)), *first);
+            }
+        }
+        catch (...) {
+            this->m_tail.store(tail + index, std::memory_order_release);
+            throw;
+        }
+
+        this->m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+public:
+    // Consumer side
+
+    /**
+    * @brief Removes the front element unless the queue is empty.
+    * @return The removed element, or std::nullopt.
+    */
+    auto try_pop() -> std::optional<Type>
+    {
+        auto head = this->m_head.load(std::memory_order_relaxed);
+
+        if (head == this->m_tail_cache)
+        {
+            this->m_tail_cache = this->m_tail.load(std::memory_order_acquire);
+
+            if (head == this->m_tail_cache)
+            {
+                return std::nullopt;
+            }
+        }
+
+        auto slot = this->__M_slot(head);
+        std::optional<Type> result{std::move(*slot)};
+
+        traits::destroy(this->m_alloc, std::to_address(slot));
+
+        this->m_head.store(head + 1UL, std::memory_order_release);
+        return result;
+    }
+
+    /**
+    * @brief Moves up to `count` front elements into `out`, releasing them with a single store.
+    * @details If writing to `out` throws, the elements written before are released and
+    *          the exception is rethrown; the failed element stays in the queue.
+    * @param out The destination of the removed elements.
+    * @param count The maximum number of elements to remove.
+    * @return The number of elements removed.
+    */
+    template <class OutputIt>
+    auto try_pop_n(OutputIt out, size_type count) -> size_type
+        requires std::output_iterator<OutputIt, Type &&>
+    {
+        auto head = this->m_head.load(std::memory_order_relaxed);
+
+        if (this->m_tail_cache - head < count)
+        {
+            this->m_tail_cache = this->m_tail.load(std::memory_order_acquire);
+        }
+
+        count = std::min(count, this->m_tail_cache - head);
+
+        size_type index = 0UL;
+
+        try {
+            for (; index != count; ++index, ++out)
+            {
+                auto slot = this->__M_slot(head + index);
+
+                *out = std::move(*slot);
+                traits::destroy(this->m_alloc, std::to_address(slot));
+            }
+        }
+        catch (...) {
+            this->m_head.store(head + index, std::memory_order_release);
+            throw;
+        }
+
+        this->m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+public:
+    // Capacity
+
+    /**
+    * @brief Checks if the queue is empty. Only a snapshot while other threads are active.
+    */
+    [[nodiscard]] auto empty() const noexcept -> bool { return (this->size() == 0UL); }
+
+    /**
+    * @brief Returns the number of elements. Only a snapshot while other threads are active.
+    */
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        auto head = this->m_head.load(std::memory_order_acquire);
+        return this->m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    /**
+    * @brief Returns the maximum number of elements.
+    */
+    [[nodiscard]] auto capacity() const noexcept -> size_type { return this->m_capacity; }
+
+    /**
+    * @brief Returns a copy of the allocator associated with the queue.
+    */
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type { return allocator_type(this->m_alloc); }
+
+public:
+    // Destructor
+
+    /**
+    * @brief Destroys the remaining elements and deallocates the buffer.
+    * @note Neither side may be in use concurrently with destruction.
+    */
+    ~spsc_queue()
+    {
+        auto tail = this->m_tail.load(std::memory_order_acquire);
+
+        for (auto head = this->m_head.load(std::memory_order_relaxed); head != tail; ++head)
+        {
+            traits::destroy(this->m_alloc, std::to_address(this->__M_slot(head)));
+        }
+
+        traits::deallocate(this->m_alloc, this->m_buffer, this->m_capacity);
+    }
+
+private:
+    // Helper functions
+
+    [[nodiscard]] auto __M_slot(size_type index) const noexcept -> Type *
+    {
+        return this->m_buffer + (index & (this->m_capacity - 1UL));
+    }
+
+private:
+    // Consumer-owned line
+    alignas(details::cache_line_size) std::atomic<size_type> m_head{0UL}; // Next element to pop
+    size_type m_tail_cache{0UL};                                           // Consumer's copy of m_tail
+
+    // Producer-owned line
+    alignas(details::cache_line_size) std::atomic<size_type> m_tail{0UL}; // Next slot to push
+    size_type m_head_cache{0UL};                                           // Producer's copy of m_head
+
+    // Read-only after construction
+    alignas(details::cache_line_size) Type *m_buffer{nullptr};
+    size_type m_capacity;
+    [[no_unique_address]] allocator_t m_alloc{};
+};
+
+
+
+/**
+* @brief A bounded lock-free queue for any number of producer and consumer threads.
+* @details Dmitry Vyukov's design: every cell carries a sequence number telling which
+*          lap of the ring it is ready for, so producers and consumers only contend on
+*          one CAS of the enqueue or dequeue index; they never touch the same index.
+*          An element is fully constructed before its slot is claimed, which is why the
+*          element type must be nothrow move constructible.
+* @tparam Type The type of elements stored in the queue.
+* @tparam Allocator The allocator used for the cell buffer.
+*/
+template <class Type, class Allocator = std::allocator<Type>>
+    requires std::is_nothrow_move_constructible_v<Type>
+struct mpmc_queue final
+{
+
+private:
+    /**
+    * @brief Nested struct representing a cell of the ring.
+    */
+    struct Cell;
+
+public:
+    // Public member type aliases
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    // Allocator and allocator traits
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Cell>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Constructs an empty queue.
+    * @param capacity The minimum number of elements, rounded up to a power of two.
+    * @param alloc The allocator used for the cell buffer.
+    */
+    explicit mpmc_queue(size_type capacity, const Allocator &alloc = Allocator())
+        : m_capacity{std::bit_ceil(std::max<size_type>(capacity, 2UL))}, m_alloc{alloc}
+    {
+        this->m_cells = traits::allocate(this->m_alloc, this->m_capacity);
+
+        for (size_type index = 0UL; index != this->m_capacity; ++index)
+        {
+            traits::construct(this->m_alloc, std::to_address(this->m_cells + index), index);
+        }
+    }
+
+    mpmc_queue(const mpmc_queue &) = delete;
+    mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+public:
+    // Producer side
+
+    /**
+    * @brief Constructs an element at the back of the queue unless it is full.
+    * @details When construction may throw, the element is built before a cell is
+    *          claimed and then moved in, so a throwing constructor leaves the queue untouched.
+    * @tparam ARGS Types of the arguments to construct the element.
+    * @param args Arguments to construct the element.
+    * @return True if the element was added.
+    */
+    template <class... ARGS>
+    auto try_emplace(ARGS &&...args) -> bool
+        requires std::constructible_from<Type, ARGS...>
+    {
+        if constexpr (std::is_nothrow_constructible_v<Type, ARGS...>)
+        {
+            return this->__M_push(std::forward<ARGS>(args)...);
+        }
+        else
+        {
+            return this->__M_push(Type(std::forward<ARGS>(args)...));
+        }
+    }
+
+    /**
+    * @brief Adds an element to the back of the queue unless it is full.
+    * @tparam UType Type of the element to be added.
+    * @param data The element to be added.
+    * @return True if the element was added.
+    */
+    template <class UType>
+    auto try_push(UType &&data) -> bool
+        requires std::constructible_from<Type, UType>
+    {
+        return this->try_emplace(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Adds up to `count` elements from `first`, claiming consecutive cells with one CAS.
+    * @details Pass a std::move_iterator to move elements in.
+    * @param first The beginning of the elements to add.
+    * @param count The maximum number of elements to add.
+    * @return The number of elements added; fewer than `count` only when the queue filled up.
+    */
+    template <std::input_iterator Iterator>
+    auto try_push_n(Iterator first, size_type count) -> size_type
+        requires std::is_nothrow_constructible_v<Type, std::iter_reference_t<Iterator>>
+    {
+        size_type pushed = 0UL;
+
+        while (pushed != count)
+        {
+            auto position = this->m_enqueue.load(std::memory_order_relaxed);
+            auto claimed = this->__M_claim(this->m_enqueue, position, count - pushed, 0UL);
+
+            if (claimed == 0UL)
+            {
+                break;
+            }
+
+            for (size_type index = 0UL; index != claimed; ++index, ++first)
+            {
+                auto cell = this->__M_cell(position + index);
+
+                ::new (static_cast<void *>(cell->m_storage)) Type(*first);
+                cell->m_sequence.store(position + index + 1UL, std::memory_order_release);
+            }
+
+            pushed = pushed + claimed;
+        }
+
+        return pushed;
+    }
+
+public:
+    // Consumer side
+
+    /**
+    * @brief Removes the front element unless the queue is empty.
+    * @return The removed element, or std::nullopt.
+    */
+    auto try_pop() -> std::optional<Type>
+    {
+        auto position = this->m_dequeue.load(std::memory_order_relaxed);
+
+        if (this->__M_claim(this->m_dequeue, position, 1UL, 1UL) == 0UL)
+        {
+            return std::nullopt;
+        }
+
+        auto cell = this->__M_cell(position);
+        std::optional<Type> result{std::move(*cell->data())};
+
+        this->__M_vacate(cell, position);
+        return result;
+    }
+
+    /**
+    * @brief Moves up to `count` front elements into `out`, claiming consecutive cells with one CAS.
+    * @details If writing to `out` throws, the remaining claimed elements are discarded
+    *          so that the queue stays consistent, and the exception is rethrown.
+    * @param out The destination of the removed elements.
+    * @param count The maximum number of elements to remove.
+    * @return The number of elements removed; fewer than `count` only when the queue ran empty.
+    */
+    template <class OutputIt>
+    auto try_pop_n(OutputIt out, size_type count) -> size_type
+        requires std::output_iterator<OutputIt, Type &&>
+    {
+        size_type popped = 0UL;
+
+        while (popped != count)
+        {
+            auto position = this->m_dequeue.load(std::memory_order_relaxed);
+            auto claimed = this->__M_claim(this->m_dequeue, position, count - popped, 1UL);
+
+            if (claimed == 0UL)
+            {
+                break;
+            }
+
+            size_type index = 0UL;
+
+            try {
+                for (; index != claimed; ++index, ++out)
+                {
+                    auto cell = this->__M_cell(position + index);
+
+                    *out = std::move(*cell->data());
+                    this->__M_vacate(cell, position + index);
+                }
+            }
+            catch (...) {
+                for (; index != claimed; ++index)
+                {
+                    this->__M_vacate(this->__M_cell(position + index), position + index);
+                }
+                throw;
+            }
+
+            popped = popped + claimed;
+        }
+
+        return popped;
+    }
+
+public:
+    // Capacity
+
+    /**
+    * @brief Checks if the queue is empty. Only a snapshot while other threads are active.
+    */
+    [[nodiscard]] auto empty() const noexcept -> bool { return (this->size() == 0UL); }
+
+    /**
+    * @brief Returns the number of elements. Only a snapshot while other threads are active.
+    */
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        auto dequeue = this->m_dequeue.load(std::memory_order_acquire);
+        auto enqueue = this->m_enqueue.load(std::memory_order_acquire);
+
+        return (enqueue > dequeue) ? (enqueue - dequeue) : 0UL;
+    }
+
+    /**
+    * @brief Returns the maximum number of elements.
+    */
+    [[nodiscard]] auto capacity() const noexcept -> size_type { return this->m_capacity; }
+
+    /**
+    * @brief Returns a copy of the allocator associated with the queue.
+    */
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type { return allocator_type(this->m_alloc); }
+
+public:
+    // Destructor
+
+    /**
+    * @brief Destroys the remaining elements and deallocates the cells.
+    * @note No thread may be using the queue concurrently with destruction.
+    */
+    ~mpmc_queue()
+    {
+        for (; this->try_pop().has_value();)
+        {
+        }
+
+        for (size_type index = 0UL; index != this->m_capacity; ++index)
+        {
+            traits::destroy(this->m_alloc, std::to_address(this->m_cells + index));
+        }
+
+        traits::deallocate(this->m_alloc, this->m_cells, this->m_capacity);
+    }
+
+private:
+    // Helper functions
+
+    [[nodiscard]] auto __M_cell(size_type position) const noexcept -> Cell *
+    {
+        return this->m_cells + (position & (this->m_capacity - 1UL));
+    }
+
+    /**
+    * @brief Claims up to `count` consecutive cells starting at `position` from `index`.
+    * @details A cell is ready when its sequence equals `position + offset`, with offset 0
+    *          for producers (empty cell) and 1 for consumers (full cell). Cells that are
+    *          ready cannot change state until the index moves past them, so the contiguous
+    *          ready run is claimed with a single CAS.
+    * @param index The enqueue or dequeue index.
+    * @param position In: the expected index value; out: the first claimed position.
+    * @param count The maximum number of cells to claim.
+    * @param offset 0 for producers, 1 for consumers.
+    * @return The number of claimed cells, 0 when the queue is full (or empty).
+    */
+    auto __M_claim(std::atomic<size_type> &index, size_type &position, size_type count, size_type offset) noexcept
+        -> size_type
+    {
+        while (true)
+        {
+            size_type ready = 0UL;
+
+            while ((ready != count) &&
+                   (this->__M_cell(position + ready)->m_sequence.load(std::memory_order_acquire) ==
+                    position + ready + offset))
+            {
+                ready = ready + 1UL;
+            }
+
+            if (ready != 0UL)
+            {
+                if (index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed))
+                {
+                    return ready;
+                }
+                continue;
+            }
+
+            auto sequence = this->__M_cell(position)->m_sequence.load(std::memory_order_acquire);
+            auto distance = static_cast<difference_type>(sequence - (position + offset));
+
+            if (distance < 0L)
+            {
+                return 0UL;
+            }
+
+            position = index.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+    * @brief Constructs an element in a claimed cell and publishes it.
+    */
+    template <class... ARGS>
+    auto __M_push(ARGS &&...args) noexcept -> bool
+    {
+        auto position = this->m_enqueue.load(std::memory_order_relaxed);
+
+        if (this->__M_claim(this->m_enqueue, position, 1UL, 0UL) == 0UL)
+        {
+            return false;
+        }
+
+        auto cell = this->__M_cell(position);
+
+        ::new (static_cast<void *>(cell->m_storage)) Type(std::forward<ARGS>(args)...);
+        cell->m_sequence.store(position + 1UL, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+    * @brief Destroys the element of a claimed cell and hands the cell to the next lap.
+    */
+    void __M_vacate(Cell *cell, size_type position) noexcept
+    {
+        std::destroy_at(cell->data());
+        cell->m_sequence.store(position + this->m_capacity, std::memory_order_release);
+    }
+
+private:
+    // Producer index
+    alignas(details::cache_line_size) std::atomic<size_type> m_enqueue{0UL};
+
+    // Consumer index
+    alignas(details::cache_line_size) std::atomic<size_type> m_dequeue{0UL};
+
+    // Read-only after construction
+    alignas(details::cache_line_size) Cell *m_cells{nullptr};
+    size_type m_capacity;
+    [[no_unique_address]] allocator_t m_alloc{};
+};
+
+
+
+/**
+* @brief A cell of an mpmc_queue: a sequence number and raw storage for one element.
+* @tparam Type The type of data held by the cell.
+* @tparam Allocator The allocator type of the owning queue.
+*/
+template <class Type, class Allocator>
+    requires std::is_nothrow_move_constructible_v<Type>
+struct mpmc_queue<Type, Allocator>::Cell final
+{
+    explicit Cell(size_type sequence) noexcept
+        : m_sequence{sequence}
+    {
+    }
+
+    [[nodiscard]] auto data() noexcept -> Type *
+    {
+        return std::launder(reinterpret_cast<Type *>(this->m_storage));
+    }
+
+    std::atomic<size_type> m_sequence;                 // Lap the cell is ready for
+    alignas(Type) std::byte m_storage[sizeof(Type)];   // Storage of the element
+};
+
+#endif
@@ -0,0 +1,465 @@
+#ifndef __CONCURRENT_STACK_HXX__
+#define __CONCURRENT_STACK_HXX__
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "details.h"
+
+// The head packs a tag into the top 16 bits of a pointer, which needs 48-bit user addresses
+#if !(defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64))
+#error "concurrent_stack requires x86-64 or AArch64 (48-bit user-space addresses)"
+#endif
+
+#if defined(__SANITIZE_HWADDRESS__)
+#error "concurrent_stack cannot pack its tag into HWASan-tagged pointers"
+#elif defined(__has_feature)
+#if __has_feature(hwaddress_sanitizer)
+#error "concurrent_stack cannot pack its tag into HWASan-tagged pointers"
+#endif
+#endif
+
+
+/**
+* @brief A lock-free Treiber stack with tagged-pointer ABA protection and elimination backoff.
+* @details The head is a single word packing the top node pointer with a 16-bit modification
+*          tag in the unused upper address bits; every successful CAS bumps the tag, so a
+*          popper holding a stale head fails once the same node was popped and pushed again.
+*          The protection is probabilistic: the tag wraps modulo 65,536, and a stale CAS still
+*          succeeds if exactly a multiple of 65,536 updates land on the head between a thread's
+*          load and its CAS while the same node is back on top.
+*          Packing the tag needs every node address to fit in the low 48 bits, so only x86-64
+*          with 4-level paging and AArch64 without top-byte pointer tags (MTE, HWASan) are
+*          supported; other targets fail to compile and a wider address trips an assertion.
+*          Popped nodes are recycled through an internal free list (itself a tagged Treiber
+*          stack) and only returned to the allocator by the destructor, which keeps every node
+*          readable by slow threads without hazard pointers or epochs.
+*          When the CAS on the head fails, a push and a pop meet in a random slot of an
+*          elimination array and hand the element over directly, never touching the head.
+* @tparam Type The type of elements stored in the stack.
+* @tparam Allocator The allocator used for the nodes; its allocate() must be thread-safe.
+*/
+template <class Type, class Allocator = std::allocator<Type>>
+    requires std::move_constructible<Type>
+struct concurrent_stack final
+{
+
+private:
+    // Forward declaration of the Node structure
+    struct Node;
+
+    // A node pointer packed with a modification tag
+    using word_t = std::uintptr_t;
+
+    static_assert(sizeof(word_t) == 8UL, "tagged pointers need 64-bit addresses");
+
+private:
+    // Type aliases for allocator and allocator traits
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+public:
+    // Type aliases for readability and standard conformance
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+public:
+    // Number of elimination slots, each on its own cache line
+    static constexpr size_type elimination_slots = 16UL;
+
+    // Number of polls a pusher waits in an elimination slot for a popper
+    static constexpr size_type elimination_spins = 128UL;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Default constructor for concurrent_stack.
+    */
+    constexpr concurrent_stack() noexcept = default;
+
+    /**
+    * @brief Constructs an empty stack using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr concurrent_stack(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
+    concurrent_stack(const concurrent_stack &) = delete;
+    concurrent_stack &operator=(const concurrent_stack &) = delete;
+
+public:
+    // Stack operations
+
+    /**
+    * @brief Push an element onto the top of the stack.
+    * @tparam UType The type of the element to be pushed.
+    * @param data The data of the element to be pushed.
+    */
+    template <class UType>
+    void push(UType &&data)
+        requires std::constructible_from<Type, UType>
+    {
+        this->emplace(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Emplace an element onto the top of the stack.
+    * @details The element is constructed in a private node before it is published,
+    *          so a throwing constructor leaves the stack untouched.
+    * @tparam ARGS The types of arguments to construct the element.
+    * @param args The arguments to construct the element.
+    */
+    template <class... ARGS>
+    void emplace(ARGS &&...args)
+        requires std::constructible_from<Type, ARGS...>
+    {
+        auto node = this->__M_acquire_node();
+
+        try {
+            ::new (static_cast<void *>(node->m_storage)) Type(std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            __M_push_word(this->m_free, node);
+            throw;
+        }
+
+        this->__M_push_node(node);
+    }
+
+    /**
+    * @brief Pop the top element from the stack unless it is empty.
+    * @return The popped element, or std::nullopt.
+    */
+    auto try_pop() -> std::optional<Type>
+    {
+        auto node = this->__M_pop_node();
+
+        if (node == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        try {
+            std::optional<Type> result{std::move(*node->data())};
+
+            std::destroy_at(node->data());
+            __M_push_word(this->m_free, node);
+
+            return result;
+        }
+        catch (...) {
+            this->__M_push_node(node);
+            throw;
+        }
+    }
+
+    /**
+    * @brief Check if the stack is empty. Only a snapshot while other threads are active.
+    * @return True if the stack is empty, false otherwise.
+    */
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return (__M_pointer(this->m_head.load(std::memory_order_acquire)) == nullptr);
+    }
+
+    /**
+    * @brief Returns a copy of the allocator associated with the stack.
+    * @return The allocator, rebound back to the value type.
+    */
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+public:
+    // Destructor
+
+    /**
+    * @brief Destroys the remaining elements and returns every node to the allocator.
+    * @note No thread may be using the stack concurrently with destruction.
+    */
+    ~concurrent_stack()
+    {
+        for (auto node = __M_pointer(this->m_head.load(std::memory_order_acquire)); node != nullptr;)
+        {
+            auto next = node->m_next.load(std::memory_order_relaxed);
+
+            std::destroy_at(node->data());
+            this->__M_destroy_node(node);
+
+            node = next;
+        }
+
+        for (auto node = __M_pointer(this->m_free.load(std::memory_order_acquire)); node != nullptr;)
+        {
+            auto next = node->m_next.load(std::memory_order_relaxed);
+
+            this->__M_destroy_node(node);
+
+            node = next;
+        }
+    }
+
+private:
+    // Tagged pointer helpers
+
+    static constexpr unsigned tag_shift = 48U;
+    static constexpr word_t address_mask = (word_t{1} << tag_shift) - 1UL;
+
+    [[nodiscard]] static auto __M_pack(Node *node, word_t tag) noexcept -> word_t
+    {
+        assert((reinterpret_cast<word_t>(node) & ~address_mask) == 0UL);
+        return (reinterpret_cast<word_t>(node) & address_mask) | (tag << tag_shift);
+    }
+
+    [[nodiscard]] static auto __M_pointer(word_t word) noexcept -> Node *
+    {
+        return reinterpret_cast<Node *>(word & address_mask);
+    }
+
+    // The tag after `word`'s, wrapping to 0 after 65,535: a stale word is only caught while
+    // fewer than 65,536 updates separate it from the current one
+    [[nodiscard]] static auto __M_next_tag(word_t word) noexcept -> word_t
+    {
+        return ((word >> tag_shift) + 1UL) & 0xFFFFUL;
+    }
+
+    /**
+    * @brief Treiber push of `node` onto the tagged list `top`.
+    */
+    static void __M_push_word(std::atomic<word_t> &top, Node *node) noexcept
+    {
+        auto expected = top.load(std::memory_order_relaxed);
+
+        do {
+            node->m_next.store(__M_pointer(expected), std::memory_order_relaxed);
+        } while (not top.compare_exchange_weak(expected, __M_pack(node, __M_next_tag(expected)),
+                                               std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+    * @brief Treiber pop from the tagged list `top`.
+    * @details Reading `m_next` of a node another thread already popped is harmless:
+    *          nodes are never freed while the stack is alive, and the tag makes the CAS fail
+    *          unless the tag wrapped all the way around in between.
+    */
+    static auto __M_pop_word(std::atomic<word_t> &top) noexcept -> Node *
+    {
+        auto expected = top.load(std::memory_order_acquire);
+
+        while (auto node = __M_pointer(expected))
+        {
+            auto next = node->m_next.load(std::memory_order_relaxed);
+
+            if (top.compare_exchange_weak(expected, __M_pack(next, __M_next_tag(expected)),
+                                          std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return node;
+            }
+        }
+
+        return nullptr;
+    }
+
+private:
+    // Helper functions
+
+    /**
+    * @brief Publish a node holding a constructed element, eliminating on contention.
+    */
+    void __M_push_node(Node *node) noexcept
+    {
+        auto expected = this->m_head.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            node->m_next.store(__M_pointer(expected), std::memory_order_relaxed);
+
+            if (this->m_head.compare_exchange_weak(expected, __M_pack(node, __M_next_tag(expected)),
+                                                   std::memory_order_release, std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            if (this->__M_offer(node))
+            {
+                return;
+            }
+
+            expected = this->m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+    * @brief Claim the top node, or a node offered in the elimination array on contention.
+    * @return The claimed node, or nullptr if the stack is empty.
+    */
+    auto __M_pop_node() noexcept -> Node *
+    {
+        auto expected = this->m_head.load(std::memory_order_acquire);
+
+        while (auto node = __M_pointer(expected))
+        {
+            auto next = node->m_next.load(std::memory_order_relaxed);
+
+            if (this->m_head.compare_exchange_weak(expected, __M_pack(next, __M_next_tag(expected)),
+                                                   std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return node;
+            }
+
+            if (auto offered = this->__M_take())
+            {
+                return offered;
+            }
+
+            expected = this->m_head.load(std::memory_order_acquire);
+        }
+
+        return nullptr;
+    }
+
+    /**
+    * @brief Offer `node` in a random elimination slot and wait briefly for a popper.
+    * @return True if a popper took the node.
+    */
+    auto __M_offer(Node *node) noexcept -> bool
+    {
+        auto &slot = this->m_slots[__M_random() % elimination_slots].m_offer;
+        auto current = slot.load(std::memory_order_relaxed);
+
+        if (__M_pointer(current) != nullptr)
+        {
+            return false;
+        }
+
+        auto offer = __M_pack(node, __M_next_tag(current));
+
+        if (not slot.compare_exchange_strong(current, offer, std::memory_order_release, std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        for (auto spins = elimination_spins; spins; --spins)
+        {
+            if (slot.load(std::memory_order_relaxed) != offer)
+            {
+                return true;
+            }
+            details::cpu_relax();
+        }
+
+        // Withdraw the offer; failing means a popper took it in the meantime
+        return not slot.compare_exchange_strong(offer, __M_pack(nullptr, offer >> tag_shift),
+                                                std::memory_order_relaxed, std::memory_order_relaxed);
+    }
+
+    /**
+    * @brief Take the node offered in a random elimination slot, if any.
+    */
+    auto __M_take() noexcept -> Node *
+    {
+        auto &slot = this->m_slots[__M_random() % elimination_slots].m_offer;
+        auto current = slot.load(std::memory_order_acquire);
+
+        if (__M_pointer(current) == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (slot.compare_exchange_strong(current, __M_pack(nullptr, current >> tag_shift),
+                                         std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return __M_pointer(current);
+        }
+
+        return nullptr;
+    }
+
+    /**
+    * @brief Per-thread xorshift generator spreading threads over the elimination slots.
+    */
+    [[nodiscard]] static auto __M_random() noexcept -> std::uint32_t
+    {
+        thread_local std::uint32_t state = static_cast<std::uint32_t>(reinterpret_cast<word_t>(&state)) | 1U;
+
+        state ^= state << 13U;
+        state ^= state >> 17U;
+        state ^= state << 5U;
+
+        return state;
+    }
+
+    /**
+    * @brief Reuse a recycled node or allocate a new one.
+    */
+    auto __M_acquire_node() -> Node *
+    {
+        if (auto node = __M_pop_word(this->m_free))
+        {
+            return node;
+        }
+
+        auto node = traits::allocate(this->m_alloc, 1UL);
+        traits::construct(this->m_alloc, std::to_address(node));
+
+        return node;
+    }
+
+    /**
+    * @brief Destroy and deallocate a node whose element has been destroyed.
+    */
+    void __M_destroy_node(Node *node) noexcept
+    {
+        traits::destroy(this->m_alloc, std::to_address(node));
+        traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
+    }
+
+private:
+    // An elimination slot, padded to a cache line
+    struct alignas(details::cache_line_size) Slot
+    {
+        std::atomic<word_t> m_offer{0UL};
+    };
+
+private:
+    // Member variables
+    alignas(details::cache_line_size) std::atomic<word_t> m_head{0UL}; // Tagged top of the stack
+    alignas(details::cache_line_size) std::atomic<word_t> m_free{0UL}; // Tagged top of the recycled nodes
+    Slot m_slots[elimination_slots]{};                                 // Elimination array
+    [[no_unique_address]] allocator_t m_alloc{};
+};
+
+
+
+/**
+* @brief A node of a concurrent_stack: a link and raw storage for one element.
+* @tparam Type The type of data held by the node.
+* @tparam Allocator The allocator type of the owning stack.
+*/
+template <class Type, class Allocator>
+    requires std::move_constructible<Type>
+struct concurrent_stack<Type, Allocator>::Node final
+{
+    [[nodiscard]] auto data() noexcept -> Type *
+    {
+        return std::launder(reinterpret_cast<Type *>(this->m_storage));
+    }
+
+    std::atomic<Node *> m_next{nullptr};             // Next node, read racily by poppers
+    alignas(Type) std::byte m_storage[sizeof(Type)]; // Storage of the element
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef __CONTAINER_STATS_HXX__
+#define __CONTAINER_STATS_HXX__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+
+
+// Stats policy recording nothing: the default, compiled out entirely
+struct no_stats final
+{
+};
+
+// Stats policy counting allocator traffic and the structural work of each operation
+struct operation_stats final
+{
+};
+
+/**
+* @brief Counters a container built with operation_stats has gathered since it was constructed
+*        or last reset.
+* @details The counters belong to a container object: copies and moves of a container start
+*          from zero, and nodes handed between containers (splice, node handles, set algebra)
+*          count as relink events on the receiving side rather than as allocations.
+*/
+struct container_stats final
+{
+    std::uint64_t m_allocations{0};        // Calls to the allocator's allocate, batches counting once
+    std::uint64_t m_deallocations{0};      // Calls to the allocator's deallocate
+    std::uint64_t m_bytes_live{0};         // Bytes of the nodes currently held, as reported by stats()
+    std::uint64_t m_comparisons{0};        // Invocations of the comparator
+    std::uint64_t m_searches{0};           // Lookup descents recorded
+    std::uint64_t m_search_depth_total{0}; // Nodes visited over every recorded descent
+    std::uint64_t m_search_depth_max{0};   // Nodes visited by the deepest recorded descent
+    std::uint64_t m_rebalances{0};         // Rotations performed to restore balance
+    std::uint64_t m_relinks{0};            // Node handles, splices and merges: nodes moved, not copied
+    std::uint64_t m_reuses{0};             // Elements assigned into existing nodes instead of reallocated
+
+    /**
+    * @brief The mean number of nodes a recorded descent visited, 0 before any search.
+    */
+    [[nodiscard]] constexpr auto average_search_depth() const noexcept -> double
+    {
+        if (this->m_searches == 0UL)
+            return 0.0;
+
+        return static_cast<double>(this->m_search_depth_total) / static_cast<double>(this->m_searches);
+    }
+
+    friend constexpr auto operator==(const container_stats &, const container_stats &) noexcept -> bool = default;
+};
+
+
+
+namespace details
+{
+    /**
+    * @brief The hooks a container calls as it works, selected by its stats policy.
+    * @details This primary template, used for no_stats, is empty and its hooks do nothing, so
+    *          a [[no_unique_address]] member of it costs neither space nor instructions.
+    * @tparam Stats The stats policy.
+    */
+    template <class Stats>
+    struct stats_recorder final
+    {
+        static constexpr bool enabled = false;
+
+        constexpr void allocated() noexcept {}
+        constexpr void deallocated() noexcept {}
+        constexpr void compared() noexcept {}
+        constexpr void searched(std::size_t) noexcept {}
+        constexpr void rebalanced() noexcept {}
+        constexpr void relinked() noexcept {}
+        constexpr void reused(std::size_t = 1UL) noexcept {}
+    };
+
+    /**
+    * @brief The recording hooks. Lookups on a const container may run on several threads at
+    *        once, as may the parallel bulk operations, so the counters are relaxed atomics.
+    *        Live bytes are not tracked here: the container derives them from the nodes it
+    *        holds when stats() is called.
+    */
+    template <>
+    struct stats_recorder<operation_stats> final
+    {
+        static constexpr bool enabled = true;
+
+        stats_recorder() noexcept = default;
+
+        // A copied or moved-to container starts counting from zero
+        stats_recorder(const stats_recorder &) noexcept {}
+        auto operator=(const stats_recorder &) noexcept -> stats_recorder & { return *this; }
+
+        void allocated() noexcept { __M_add(this->m_allocations); }
+        void deallocated() noexcept { __M_add(this->m_deallocations); }
+        void compared() noexcept { __M_add(this->m_comparisons); }
+
+        void searched(std::size_t depth) noexcept
+        {
+            __M_add(this->m_searches);
+            __M_add(this->m_search_depth_total, depth);
+
+            auto deepest = this->m_search_depth_max.load(std::memory_order_relaxed);
+
+            while ((deepest < depth) &&
+                   not this->m_search_depth_max.compare_exchange_weak(deepest, depth, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void rebalanced() noexcept { __M_add(this->m_rebalances); }
+        void relinked() noexcept { __M_add(this->m_relinks); }
+        void reused(std::size_t count = 1UL) noexcept { __M_add(this->m_reuses, count); }
+
+        // The counters, with live bytes filled in by the container
+        [[nodiscard]] auto snapshot(std::size_t bytes_live) const noexcept -> container_stats
+        {
+            container_stats counters{};
+
+            counters.m_allocations        = this->m_allocations.load(std::memory_order_relaxed);
+            counters.m_deallocations      = this->m_deallocations.load(std::memory_order_relaxed);
+            counters.m_bytes_live         = bytes_live;
+            counters.m_comparisons        = this->m_comparisons.load(std::memory_order_relaxed);
+            counters.m_searches           = this->m_searches.load(std::memory_order_relaxed);
+            counters.m_search_depth_total = this->m_search_depth_total.load(std::memory_order_relaxed);
+            counters.m_search_depth_max   = this->m_search_depth_max.load(std::memory_order_relaxed);
+            counters.m_rebalances         = this->m_rebalances.load(std::memory_order_relaxed);
+            counters.m_relinks            = this->m_relinks.load(std::memory_order_relaxed);
+            counters.m_reuses             = this->m_reuses.load(std::memory_order_relaxed);
+
+            return counters;
+        }
+
+        void reset() noexcept
+        {
+            for (auto counter : {&this->m_allocations, &this->m_deallocations, &this->m_comparisons,
+                                 &this->m_searches, &this->m_search_depth_total, &this->m_search_depth_max,
+                                 &this->m_rebalances, &this->m_relinks, &this->m_reuses})
+            {
+                counter->store(0UL, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        using counter_t = std::atomic<std::uint64_t>;
+
+        static void __M_add(counter_t &counter, std::uint64_t amount = 1UL) noexcept
+        {
+            counter.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        counter_t m_allocations{0UL};
+        counter_t m_deallocations{0UL};
+        counter_t m_comparisons{0UL};
+        counter_t m_searches{0UL};
+        counter_t m_search_depth_total{0UL};
+        counter_t m_search_depth_max{0UL};
+        counter_t m_rebalances{0UL};
+        counter_t m_relinks{0UL};
+        counter_t m_reuses{0UL};
+    };
+} // namespace details
+
+#endif
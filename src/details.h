@@ -0,0 +1,173 @@
+#ifndef __DETAILS_HXX__
+#define __DETAILS_HXX__
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <version>
+
+
+
+// Namespace containing helpers shared by every container
+namespace details
+{
+    /**
+    * @brief Tag selecting the range constructors of the containers.
+    * @details std::from_range_t where the standard library provides it (C++23), so
+    *          `std::from_range` works unchanged; an equivalent tag otherwise.
+    */
+#if defined(__cpp_lib_containers_ranges)
+    using from_range_t = std::from_range_t;
+    inline constexpr from_range_t from_range = std::from_range;
+#else
+    struct from_range_t final
+    {
+        explicit from_range_t() = default;
+    };
+    inline constexpr from_range_t from_range{};
+#endif
+
+    /**
+    * @brief Constant iterator adaptor: std::const_iterator where available (C++23).
+    * @details Older standard libraries fall back to the iterator itself, so the
+    *          containers still build there, without read-only enforcement on cbegin().
+    * @tparam Iterator The iterator type to be adapted.
+    */
+#if defined(__cpp_lib_ranges_as_const)
+    template <std::input_iterator Iterator>
+    using const_iterator = std::const_iterator<Iterator>;
+#else
+    template <std::input_iterator Iterator>
+    using const_iterator = Iterator;
+#endif
+
+    /**
+    * @brief Concept to check if a type is not the same as or derived from another type.
+    * @details Keeps the forwarding range constructors from hijacking copy and move construction.
+    * @tparam T The type to be checked.
+    * @tparam U The type to compare against.
+    */
+    template <class T, class U>
+    concept non_self = std::conjunction<
+        std::negation<std::bool_constant<std::same_as<std::decay_t<T>, U>>>,
+        std::negation<std::bool_constant<std::derived_from<std::decay_t<T>, U>>>>::value;
+
+    /**
+    * @brief Empty placeholder for node members that a policy compiles out.
+    * @details Declared [[no_unique_address]], it occupies no storage in the node.
+    */
+    struct empty_type final
+    {
+    };
+
+    /**
+    * @brief Size in bytes assumed for a cache line.
+    * @details Concurrent containers align independently written indices to this
+    *          boundary so that producers and consumers do not false-share a line.
+    */
+    inline constexpr std::size_t cache_line_size = 64UL;
+
+    /**
+    * @brief Hints the processor to start loading the cache line holding `address`.
+    * @details Used when walking node chains whose next hop is known ahead of time. A null
+    *          or dangling address is harmless: a prefetch never faults. A no-op during
+    *          constant evaluation.
+    */
+    constexpr void prefetch(const void *address) noexcept
+    {
+        if (std::is_constant_evaluated())
+            return;
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        static_cast<void>(address);
+#endif
+    }
+
+    /**
+    * @brief Hints the processor that the calling thread is busy-waiting.
+    */
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield");
+#endif
+    }
+
+    /**
+    * @brief Concept satisfied by comparators that accept any comparable key type.
+    * @details Like std::less<>, such comparators declare a nested is_transparent type;
+    *          ordered containers then take lookup keys without converting them.
+    * @tparam Compare The comparator type to be checked.
+    */
+    template <class Compare>
+    concept transparent_comparator = requires {
+        typename Compare::is_transparent;
+    };
+
+    /**
+    * @brief Concept satisfied by allocators whose deallocate() is a no-op.
+    * @details Such allocators (e.g. arena_allocator) hand out memory from a region that
+    *          is reclaimed as a whole, so a container never has to give nodes back one by one.
+    * @tparam Allocator The allocator type to be checked.
+    */
+    template <class Allocator>
+    concept monotonic_allocator = requires {
+        typename Allocator::is_monotonic;
+    } && Allocator::is_monotonic::value;
+
+    /**
+    * @brief Whether a container may drop all of its nodes without visiting them.
+    * @details True when the nodes need no destructor and their memory is owned by a
+    *          monotonic region, turning clear() and the destructor into O(1) operations.
+    * @tparam Allocator The (rebound) node allocator of the container.
+    * @tparam Type The type of elements stored in the container.
+    */
+    template <class Allocator, class Type>
+    inline constexpr bool trivially_releasable = std::conjunction_v<
+        std::bool_constant<monotonic_allocator<Allocator>>,
+        std::is_trivially_destructible<Type>>;
+
+    /**
+    * @brief The number of elements of a range when it is known up front, 0 otherwise.
+    * @details Batch insertions size their node block with it; single-pass ranges of
+    *          unknown length simply get their nodes one by one.
+    */
+    template <std::ranges::range range_t>
+    [[nodiscard]] constexpr auto size_hint(range_t &&range) -> std::size_t
+    {
+        if constexpr (std::ranges::sized_range<range_t>)
+            return static_cast<std::size_t>(std::ranges::size(range));
+        else
+            return 0UL;
+    }
+
+    /**
+    * @brief Contiguous storage reserved for the nodes of one batch insertion.
+    * @details Only monotonic allocators can serve a batch from one block: they never take
+    *          single nodes back, so the nodes of a block may still be dropped one by one
+    *          later on. An empty batch hands out nothing, and the container falls back to
+    *          allocating its nodes one by one.
+    * @tparam Node The node type of the container.
+    */
+    template <class Node>
+    struct node_batch final
+    {
+        /**
+        * @brief Hands out the next unused node slot, or nullptr once the block is used up.
+        */
+        [[nodiscard]] constexpr auto take() noexcept -> Node *
+        {
+            return (this->m_next != this->m_last) ? this->m_next++ : nullptr;
+        }
+
+        Node *m_next{nullptr}; // The next unused slot
+        Node *m_last{nullptr}; // One past the last slot
+    };
+}
+
+#endif
@@ -4,20 +4,20 @@
 
 #pragma once
 
+#include <cassert>
+#include <functional>
+#include <memory>
 #include <ranges>
 #include <utility>
 
-namespace details
-{
-    // Concept to check if a type is neither the same as U nor derived from U
-    template <class T, class U>
-    concept non_self = std::conjunction<
-        std::negation<std::is_same<std::decay_t<T>, U>>,
-        std::negation<std::is_base_of<U, std::decay_t<T>>>>::value;
-}
+#include "container_stats.h"
+#include "details.h"
+#include "node_handle.h"
+
 
 // Forward List Class Template
-template <class Type>
+// Stats selects whether the list counts its work for stats() (no_stats or operation_stats).
+template <class Type, class Allocator = std::allocator<Type>, class Stats = no_stats>
 struct forward_list final
 {
 private:
@@ -25,13 +25,20 @@ private:
     struct Node;
     struct Iterator;
 
+    // Link shared by the nodes and the list head, so that before_begin() is a real position
+    struct Link
+    {
+        Node *m_next{nullptr};
+    };
+
 private:
-    using allocator_t = std::allocator<Node>;
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
     using traits      = std::allocator_traits<allocator_t>;
 
 public:
     // Type Aliases
-    using value_type = Type;
+    using value_type     = Type;
+    using allocator_type = Allocator;
 
     using reference       = Type &;
     using const_reference = const Type &;
@@ -43,11 +50,18 @@ public:
     using difference_type = std::ptrdiff_t;
 
     using iterator       = Iterator;
-    using const_iterator = std::const_iterator<Iterator>;
+    using const_iterator = details::const_iterator<Iterator>;
+
+    // Owning handle to an extracted node
+    using node_type = node_handle<forward_list, Node>;
 
     using iterator_category = std::forward_iterator_tag;
     using iterator_concept  = std::forward_iterator_tag;
 
+private:
+    // Length of the runs sort() builds by insertion before merging
+    static constexpr size_type sort_run = 8UL;
+
 public:
     // Constructors
 
@@ -56,14 +70,23 @@ public:
     */
     constexpr forward_list() noexcept = default;
 
+    /**
+    * @brief Constructs an empty list using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr forward_list(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
     /**
     * @brief Copy constructor.
     * @param outer The forward_list to copy.
     */
     constexpr forward_list(const forward_list &outer)
-        : m_alloc{traits::select_on_copy_construction(outer.m_alloc)}
+        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
     {
-        this->m_head = this->__M_clone(outer.m_head);
+        this->m_head.m_next = this->__M_clone(outer.m_head.m_next);
     }
 
     /**
@@ -73,15 +96,16 @@ public:
     constexpr forward_list(forward_list &&outer) noexcept
         : m_alloc{std::move(outer.m_alloc)}
     {
-        this->m_head = std::exchange(outer.m_head, nullptr);
+        this->m_head.m_next = std::exchange(outer.m_head.m_next, nullptr);
     }
 
     /**
     * @brief Constructor from initializer list.
     * @param list The initializer list to initialize the forward_list.
+    * @param alloc The allocator used for all node allocations.
     */
-    constexpr forward_list(std::initializer_list<Type> list)
-        : forward_list{std::ranges::begin(list), std::ranges::end(list)}
+    constexpr forward_list(std::initializer_list<Type> list, const Allocator &alloc = Allocator())
+        : forward_list(std::ranges::begin(list), std::ranges::end(list), alloc)
     {
     }
 
@@ -89,13 +113,14 @@ public:
     * @brief Constructor from range.
     * @tparam range_t Type of the range.
     * @param range The range to initialize the forward_list.
+    * @param alloc The allocator used for all node allocations.
     */
     template <typename range_t> requires std::ranges::range<range_t>
-    constexpr forward_list(std::from_range_t, range_t &&range)
+    constexpr forward_list(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
         requires(std::conjunction_v<
                  std::bool_constant<details::non_self<range_t, forward_list>>,
                  std::bool_constant<std::constructible_from<Type, std::ranges::range_value_t<range_t>>>>)
-        : forward_list{std::ranges::begin(range), std::ranges::end(range)}
+        : forward_list(std::ranges::begin(range), std::ranges::end(range), alloc)
     {
     }
 
@@ -105,15 +130,16 @@ public:
     * @tparam Sentinel Type of the sentinel.
     * @param first The beginning of the range.
     * @param last The end of the range.
+    * @param alloc The allocator used for all node allocations.
     */
     template <typename Iterator, typename Sentinel>
         requires std::conjunction<
             std::bool_constant<std::input_iterator<Iterator>>,
             std::bool_constant<std::sentinel_for<Sentinel, Iterator>>
         >::value
-    constexpr forward_list(Iterator first, Sentinel last)
+    constexpr forward_list(Iterator first, Sentinel last, const Allocator &alloc = Allocator())
         requires(std::constructible_from<Type, std::iter_value_t<Iterator>>)
-        : forward_list{}
+        : forward_list(alloc)
     {
         this->__M_range_init(first, last);
     }
@@ -171,7 +197,7 @@ public:
     constexpr void push_front(UType &&data)
         requires(std::constructible_from<Type, UType>)
     {
-        this->m_head = this->__M_create_node(std::forward<UType>(data), this->m_head);
+        this->m_head.m_next = this->__M_create_node(std::forward<UType>(data), this->m_head.m_next);
     }
 
     /**
@@ -183,8 +209,8 @@ public:
     constexpr void emplace_front(ARGS &&...args)
         requires(std::constructible_from<Type, ARGS...>)
     {
-        this->m_head = this->__M_create_node(std::in_place, std::forward_as_tuple(args...),
-                                             this->m_head);
+        this->m_head.m_next = this->__M_create_node(std::in_place, std::forward_as_tuple(args...),
+                                             this->m_head.m_next);
     }
 
     /**
@@ -230,6 +256,8 @@ public:
     
     /**
     * @brief Inserts multiple copies of an element after a specified position.
+    * @details The copies are linked in one pass; with a monotonic allocator their nodes
+    *          come from a single allocation.
     * @tparam _iterator Type of the iterator.
     * @tparam UType Type of the element to be inserted.
     * @param position Iterator pointing to the position after which the elements should be inserted.
@@ -243,14 +271,24 @@ public:
         >::value
     constexpr void insert_after(_iterator position, size_type count, UType &&data)
     {
-        while (count--)
+        auto current = position.m_node;
+
+        if (current == nullptr)
+            return;
+
+        auto batch = this->__M_reserve_batch(count);
+
+        for (; count != 0UL; --count)
         {
-            this->insert_after(position++, data);
+            current->m_next = this->__M_create_batched(batch, data, current->m_next);
+            current = current->m_next;
         }
     }
 
     /**
     * @brief Inserts elements from a range after a specified position.
+    * @details The elements are linked in one pass; with a monotonic allocator and a sized
+    *          range their nodes come from a single allocation.
     * @tparam _iterator Type of the iterator.
     * @tparam Iterator Type of the iterator.
     * @tparam Sentinel Type of the sentinel.
@@ -263,12 +301,67 @@ public:
             std::bool_constant<std::input_iterator<_iterator>>,
             std::bool_constant<std::input_iterator<Iterator>>,
             std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
-            std::constructible_from<Type, std::iter_value_t<Iterator>>
+            std::bool_constant<std::constructible_from<Type, std::iter_value_t<Iterator>>>
         >::value
     constexpr void insert_after(_iterator position, Iterator first, Sentinel last)
     {
-        while (first != last)
-            this->insert_after(position++, *first++);
+        size_type count = 0UL;
+
+        if constexpr (std::sized_sentinel_for<Sentinel, Iterator>)
+            count = static_cast<size_type>(last - first);
+
+        if (auto current = position.m_node)
+            this->__M_link_after(current, std::move(first), last, this->__M_reserve_batch(count));
+    }
+
+    /**
+    * @brief Inserts every element of a range at the front of the list, keeping their order.
+    * @details The elements are linked in one pass; with a monotonic allocator and a sized
+    *          range their nodes come from a single allocation.
+    * @tparam range_t Type of the range.
+    * @param range The range of elements to be inserted.
+    */
+    template <typename range_t>
+        requires std::conjunction<
+            std::bool_constant<std::ranges::input_range<range_t>>,
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_reference_t<range_t>>>
+        >::value
+    constexpr void prepend_range(range_t &&range)
+    {
+        this->__M_link_after(std::addressof(this->m_head), std::ranges::begin(range), std::ranges::end(range),
+                             this->__M_reserve_batch(details::size_hint(range)));
+    }
+
+    /**
+    * @brief Links an extracted node at the front of the list, without allocating.
+    * @param handle The handle to take the node from; left empty.
+    */
+    constexpr void push_front(node_type &&handle) noexcept { this->insert_after(this->before_begin(), std::move(handle)); }
+
+    /**
+    * @brief Links an extracted node after a specified position, without allocating.
+    * @tparam _iterator Type of the iterator.
+    * @param position Iterator pointing to the position after which the node should be linked.
+    * @param handle The handle to take the node from; left empty.
+    * @return iterator The inserted element, or `position` if the handle was empty.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto insert_after(_iterator position, node_type &&handle) noexcept -> iterator
+    {
+        auto current = position.m_node;
+
+        if (handle.empty() || (current == nullptr))
+            return iterator{current};
+
+        assert(handle.__M_compatible(this->m_alloc));
+
+        auto node = handle.__M_release();
+
+        node->m_next = current->m_next;
+        current->m_next = node;
+        this->m_stats.relinked();
+
+        return iterator{node};
     }
 
 public:
@@ -279,21 +372,75 @@ public:
     */
     constexpr void pop_front()
     {
-        if (auto target = this->m_head)
+        if (auto target = this->m_head.m_next)
         {
-            this->m_head = this->m_head->m_next;
+            this->m_head.m_next = this->m_head.m_next->m_next;
 
             traits::destroy(this->m_alloc, target);
             traits::deallocate(this->m_alloc, target, 1UL);
+            this->m_stats.deallocated();
         }
     }
 
+    /**
+    * @brief Removes up to `count` elements from the front, moving each one to `out`.
+    * @details The removed nodes are detached as one chain once every element is moved out,
+    *          then destroyed in a single pass; with a monotonic allocator and a trivially
+    *          destructible Type the chain is simply dropped.
+    * @tparam _iterator Type of the output iterator.
+    * @param out The destination of the removed elements.
+    * @param count The maximum number of elements to remove.
+    * @return _iterator The output iterator past the last element written.
+    */
+    template <typename _iterator> requires std::output_iterator<_iterator, Type &&>
+    constexpr auto pop_n(_iterator out, size_type count) -> _iterator
+    {
+        auto first = this->m_head.m_next;
+
+        if ((first == nullptr) || (count == 0UL))
+            return out;
+
+        auto last = first;
+
+        for (;; last = last->m_next)
+        {
+            *out = std::move(last->m_data);
+            ++out;
+
+            if ((--count == 0UL) || (last->m_next == nullptr))
+                break;
+        }
+
+        this->m_head.m_next = std::exchange(last->m_next, nullptr);
+
+        if constexpr (not details::trivially_releasable<allocator_t, Type>)
+        {
+            while (first != nullptr)
+            {
+                auto target = std::exchange(first, first->m_next);
+
+                traits::destroy(this->m_alloc, target);
+                traits::deallocate(this->m_alloc, target, 1UL);
+                this->m_stats.deallocated();
+            }
+        }
+        return out;
+    }
+
     /**
     * @brief Removes all elements from the list.
+    * @details With a monotonic allocator and a trivially destructible Type the nodes
+    *          are dropped in O(1); their memory is reclaimed when the arena is released.
     */
     constexpr void clear()
     {
-        while (this->m_head != nullptr)
+        if constexpr (details::trivially_releasable<allocator_t, Type>)
+        {
+            this->m_head.m_next = nullptr;
+            return;
+        }
+
+        while (this->m_head.m_next != nullptr)
             this->pop_front();
     }
 
@@ -316,9 +463,33 @@ public:
 
             traits::destroy(this->m_alloc, std::to_address(target));
             traits::deallocate(this->m_alloc,std::to_address(target), 1UL);
+            this->m_stats.deallocated();
         }
     }
 
+    /**
+    * @brief Unlinks the element after a specified position without destroying it.
+    * @tparam _iterator Type of the iterator.
+    * @param prev Iterator pointing to the position before the element to be extracted.
+    * @return node_type The handle owning the node, empty if there is no element after `prev`.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    [[nodiscard]] constexpr auto extract_after(_iterator prev) noexcept -> node_type
+    {
+        auto current = prev.m_node;
+
+        if ((current == nullptr) || (current->m_next == nullptr))
+            return node_type{};
+
+        auto target = current->m_next;
+
+        current->m_next = target->m_next;
+        target->m_next = nullptr;
+        this->m_stats.relinked();
+
+        return node_type{target, std::addressof(target->m_data), this->m_alloc};
+    }
+
     /**
     * @brief Erases elements in the range after a specified position.
     * @tparam _iterator Type of the iterator.
@@ -341,24 +512,24 @@ public:
     */
     constexpr auto front() noexcept -> std::optional<std::reference_wrapper<Type>>
     {
-        if (this->m_head == nullptr)
+        if (this->m_head.m_next == nullptr)
         {
             return std::nullopt;
         }
-        return std::optional{std::ref(this->m_head->m_data)};
+        return std::optional{std::ref(this->m_head.m_next->m_data)};
     }
 
     /**
     * @brief Returns a const reference to the first element of the list.
-    * @return std::optional<const std::reference_wrapper<Type>> Optional const reference to the first element.
+    * @return std::optional<std::reference_wrapper<const Type>> Optional const reference to the first element.
     */
-    constexpr auto front() const noexcept -> std::optional<const std::reference_wrapper<Type>>
+    constexpr auto front() const noexcept -> std::optional<std::reference_wrapper<const Type>>
     {
-        if (this->m_head == nullptr)
+        if (this->m_head.m_next == nullptr)
         {
             return std::nullopt;
         }
-        return std::optional{std::cref(this->m_head->m_data)};
+        return std::optional{std::cref(this->m_head.m_next->m_data)};
     }
 
 public:
@@ -370,7 +541,7 @@ public:
     */
     [[nodiscard]] constexpr auto empty() const noexcept -> bool
     {
-        return (this->m_head == nullptr);
+        return (this->m_head.m_next == nullptr);
     }
 
     /**
@@ -382,6 +553,36 @@ public:
         return std::ranges::distance(begin(), end());
     }
 
+    /**
+    * @brief Returns a copy of the allocator associated with the list.
+    * @return allocator_type The allocator, rebound back to the value type.
+    */
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+    /**
+    * @brief Returns the work counted since construction or the last reset_stats().
+    * @details Node handles, splices and merges count as relinks, elements assign() writes
+    *          over as reuses. Live bytes walk the list, as size() does.
+    * @return container_stats The counters, with the bytes of the nodes currently held.
+    */
+    [[nodiscard]] auto stats() const noexcept -> container_stats
+        requires details::stats_recorder<Stats>::enabled
+    {
+        return this->m_stats.snapshot(this->size() * sizeof(Node));
+    }
+
+    /**
+    * @brief Zeroes the counters behind stats().
+    */
+    void reset_stats() noexcept
+        requires details::stats_recorder<Stats>::enabled
+    {
+        this->m_stats.reset();
+    }
+
 public:
     // Operations
 
@@ -390,29 +591,212 @@ public:
     */
     constexpr void reverse() noexcept
     {
-        this->m_head = this->__M_reverse(this->m_head);
+        this->m_head.m_next = this->__M_reverse(this->m_head.m_next);
+    }
+
+    /**
+    * @brief Moves every element of `other` after `position`, relinking nodes only.
+    * @tparam _iterator Type of the iterator.
+    * @param position Iterator after which the elements are inserted; may be before_begin().
+    * @param other The list to take the elements from; left empty.
+    * @note Linear in the length of `other`, which has to be walked to find its last node.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice_after(_iterator position, forward_list &other) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        if ((this == std::addressof(other)) || (other.m_head.m_next == nullptr))
+            return;
+
+        this->__M_transfer_after(position.m_node, std::addressof(other.m_head), nullptr);
+        this->m_stats.relinked();
+    }
+
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice_after(_iterator position, forward_list &&other) noexcept
+    {
+        this->splice_after(position, other);
+    }
+
+    /**
+    * @brief Moves the element following `prev` in `other` after `position`.
+    * @tparam _iterator Type of the iterators.
+    * @param position Iterator after which the element is inserted; may be before_begin().
+    * @param other The list owning the element; may be *this.
+    * @param prev Iterator preceding the element to be moved; may be other.before_begin().
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice_after(_iterator position, forward_list &other, _iterator prev) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        auto node = prev.m_node->m_next;
+
+        if ((node == nullptr) || (position.m_node == prev.m_node) || (position.m_node == node))
+            return;
+
+        prev.m_node->m_next = node->m_next;
+        node->m_next = position.m_node->m_next;
+        position.m_node->m_next = node;
+        this->m_stats.relinked();
+    }
+
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice_after(_iterator position, forward_list &&other, _iterator prev) noexcept
+    {
+        this->splice_after(position, other, prev);
+    }
+
+    /**
+    * @brief Moves the elements in the open range (first, last) of `other` after `position`.
+    * @tparam _iterator Type of the iterators.
+    * @param position Iterator after which the elements are inserted; must not lie in (first, last).
+    * @param other The list owning the elements; may be *this.
+    * @param first Iterator preceding the first element to be moved.
+    * @param last Iterator following the last element to be moved.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice_after(_iterator position, forward_list &other, _iterator first, _iterator last) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        if ((first.m_node->m_next == last.m_node) || (position.m_node == first.m_node))
+            return;
+
+        this->__M_transfer_after(position.m_node, first.m_node, static_cast<Node *>(last.m_node));
+        this->m_stats.relinked();
+    }
+
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice_after(_iterator position, forward_list &&other, _iterator first, _iterator last) noexcept
+    {
+        this->splice_after(position, other, first, last);
+    }
+
+    /**
+    * @brief Merges the sorted list `other` into this sorted list, relinking nodes only.
+    * @details Stable: for equivalent elements those of *this precede those of `other`.
+    * @tparam Compare Type of the strict weak ordering.
+    * @param other The list to merge from; left empty.
+    * @param comp The ordering both lists are sorted by.
+    */
+    template <class Compare>
+        requires std::strict_weak_order<Compare &, const Type &, const Type &>
+    constexpr void merge(forward_list &other, Compare comp)
+    {
+        assert(this->__M_compatible(other));
+
+        if (this == std::addressof(other))
+            return;
+
+        __M_merge(std::addressof(this->m_head), this->m_head.m_next, std::exchange(other.m_head.m_next, nullptr), comp);
+        this->m_stats.relinked();
+    }
+
+    template <class Compare>
+        requires std::strict_weak_order<Compare &, const Type &, const Type &>
+    constexpr void merge(forward_list &&other, Compare comp)
+    {
+        this->merge(other, comp);
+    }
+
+    /**
+    * @brief Merges the sorted list `other` into this sorted list using operator<.
+    * @param other The list to merge from; left empty.
+    */
+    constexpr void merge(forward_list &other) { this->merge(other, std::less<>{}); }
+
+    constexpr void merge(forward_list &&other) { this->merge(other, std::less<>{}); }
+
+    /**
+    * @brief Sorts the list in place by relinking nodes, in O(n log n) with O(1) extra memory.
+    * @details Stable bottom-up merge sort: runs of sort_run nodes are first sorted by
+    *          insertion, then merged pairwise with doubling width. No element is copied or
+    *          moved. If the comparison throws, every node stays in the list in some order.
+    * @tparam Compare Type of the strict weak ordering.
+    * @param comp The ordering to sort by.
+    */
+    template <class Compare>
+        requires std::strict_weak_order<Compare &, const Type &, const Type &>
+    constexpr void sort(Compare comp)
+    {
+        auto count = this->__M_sort_runs(comp);
+
+        for (size_type width = sort_run; width < count; width = width * 2UL)
+        {
+            Link *tail = std::addressof(this->m_head);
+            Node *rest = this->m_head.m_next;
+
+            try {
+                while (rest != nullptr)
+                {
+                    auto lhs = rest;
+                    auto rhs = __M_cut(lhs, width);
+
+                    rest = __M_cut(rhs, width);
+                    details::prefetch(rest);
+
+                    tail = __M_merge(tail, lhs, rhs, comp);
+                }
+            }
+            catch (...) {
+                for (; tail->m_next != nullptr; tail = tail->m_next)
+                {
+                }
+                tail->m_next = rest;
+                throw;
+            }
+        }
     }
 
+    /**
+    * @brief Sorts the list in place using operator<.
+    */
+    constexpr void sort() { this->sort(std::less<>{}); }
+
 public:
     // Iterators
 
+    /**
+    * @brief Returns an iterator to the position before the first element.
+    * @details It may be passed to the *_after functions but must not be dereferenced.
+    * @return iterator Iterator to the position before the first element.
+    */
+    constexpr auto before_begin() noexcept -> iterator { return iterator{std::addressof(this->m_head)}; }
+
+    /**
+    * @brief Returns a const iterator to the position before the first element.
+    * @return iterator Const iterator to the position before the first element.
+    */
+    constexpr auto before_begin() const noexcept -> iterator
+    {
+        return iterator{const_cast<Link *>(std::addressof(this->m_head))};
+    }
+
+    /**
+    * @brief Returns a const iterator to the position before the first element.
+    * @return const_iterator Const iterator to the position before the first element.
+    */
+    constexpr auto cbefore_begin() const noexcept -> const_iterator { return const_iterator{this->before_begin()}; }
+
     /**
     * @brief Returns an iterator to the beginning of the list.
     * @return iterator Iterator to the beginning of the list.
     */
-    constexpr auto begin() noexcept -> iterator { return iterator{this->m_head}; }
+    constexpr auto begin() noexcept -> iterator { return iterator{this->m_head.m_next}; }
 
     /**
     * @brief Returns a const iterator to the beginning of the list.
     * @return iterator Const iterator to the beginning of the list.
     */
-    constexpr auto begin() const noexcept -> iterator { return iterator{this->m_head}; }
+    constexpr auto begin() const noexcept -> iterator { return iterator{this->m_head.m_next}; }
 
     /**
     * @brief Returns a const iterator to the beginning of the list.
     * @return const_iterator Const iterator to the beginning of the list.
     */
-    constexpr auto cbegin() const noexcept -> const_iterator { return const_iterator{this->m_head}; }
+    constexpr auto cbegin() const noexcept -> const_iterator { return const_iterator{this->m_head.m_next}; }
 
     /**
     * @brief Returns an iterator to the end of the list.
@@ -463,6 +847,161 @@ public:
 private:
     // Private Member Functions
 
+    /**
+    * @brief Whether nodes of `other` may be relinked into this list.
+    */
+    [[nodiscard]] constexpr auto __M_compatible(const forward_list &other) const noexcept -> bool
+    {
+        if constexpr (typename traits::is_always_equal{})
+        {
+            return true;
+        }
+        else
+        {
+            return (this->m_alloc == other.m_alloc);
+        }
+    }
+
+    /**
+    * @brief Relinks the nodes in the open range (first, last) after `position`.
+    * @param position Link after which the nodes are inserted.
+    * @param first Link preceding the first node to be moved.
+    * @param last Node following the last node to be moved, nullptr for the end.
+    */
+    static constexpr void __M_transfer_after(Link *position, Link *first, Node *last) noexcept
+    {
+        auto tail = first;
+
+        while (tail->m_next != last)
+        {
+            tail = tail->m_next;
+        }
+
+        tail->m_next = position->m_next;
+        position->m_next = std::exchange(first->m_next, last);
+    }
+
+    /**
+    * @brief Merges two sorted null-terminated chains into one by relinking, after `out`.
+    * @details Elements of `lhs` precede equivalent elements of `rhs`. If the comparison
+    *          throws, every node is still linked after `out` before the exception propagates.
+    * @return Link* The last link of the merged chain.
+    */
+    template <class Compare>
+    static constexpr auto __M_merge(Link *out, Node *lhs, Node *rhs, Compare &comp) -> Link *
+    {
+        auto tail = out;
+
+        try {
+            while ((lhs != nullptr) && (rhs != nullptr))
+            {
+                if (std::invoke(comp, std::as_const(rhs->m_data), std::as_const(lhs->m_data)))
+                {
+                    tail->m_next = rhs;
+                    rhs = rhs->m_next;
+                }
+                else
+                {
+                    tail->m_next = lhs;
+                    lhs = lhs->m_next;
+                }
+
+                tail = tail->m_next;
+            }
+        }
+        catch (...) {
+            for (tail->m_next = lhs; tail->m_next != nullptr; tail = tail->m_next)
+            {
+            }
+            tail->m_next = rhs;
+            throw;
+        }
+
+        for (tail->m_next = (lhs != nullptr) ? lhs : rhs; tail->m_next != nullptr; tail = tail->m_next)
+        {
+        }
+
+        return tail;
+    }
+
+    /**
+    * @brief Detaches the chain after the first `count` nodes of `head`.
+    * @return Node* Head of the detached rest, nullptr if the chain was not longer.
+    */
+    static constexpr auto __M_cut(Node *head, size_type count) noexcept -> Node *
+    {
+        for (; (head != nullptr) && (count > 1UL); --count)
+        {
+            head = head->m_next;
+        }
+
+        if (head == nullptr)
+            return nullptr;
+
+        return std::exchange(head->m_next, nullptr);
+    }
+
+    /**
+    * @brief First pass of sort(): insertion-sorts consecutive runs of sort_run nodes.
+    * @details A node not less than the run's last node is appended directly, so presorted
+    *          input costs one comparison per node. A node is only unlinked once its place
+    *          is known, so a throwing comparison leaves every node linked.
+    * @return size_type The number of nodes in the list.
+    */
+    template <class Compare>
+    constexpr auto __M_sort_runs(Compare &comp) -> size_type
+    {
+        Link *tail = std::addressof(this->m_head);
+        Node *rest = std::exchange(this->m_head.m_next, nullptr);
+
+        size_type count = 0UL;
+
+        try {
+            while (rest != nullptr)
+            {
+                Link *last = tail;
+
+                for (size_type taken = 0UL; (rest != nullptr) && (taken != sort_run); ++taken)
+                {
+                    Link *prev = last;
+
+                    if ((last != tail) && std::invoke(comp, std::as_const(rest->m_data),
+                                                      std::as_const(static_cast<Node *>(last)->m_data)))
+                    {
+                        for (prev = tail; not std::invoke(comp, std::as_const(rest->m_data),
+                                                          std::as_const(prev->m_next->m_data));)
+                        {
+                            prev = prev->m_next;
+                        }
+                    }
+
+                    auto node = std::exchange(rest, rest->m_next);
+
+                    node->m_next = prev->m_next;
+                    prev->m_next = node;
+
+                    if (prev == last)
+                    {
+                        last = node;
+                    }
+
+                    count = count + 1UL;
+                }
+
+                tail = last;
+            }
+        }
+        catch (...) {
+            for (; tail->m_next != nullptr; tail = tail->m_next)
+            {
+            }
+            tail->m_next = rest;
+            throw;
+        }
+
+        return count;
+    }
+
     /**
     * @brief Reverses the order of nodes in the list.
     * @param head Pointer to the head of the list.
@@ -494,17 +1033,73 @@ private:
     constexpr Node *__M_create_node(ARGS &&...args)
     {
         auto node = traits::allocate(this->m_alloc, 1UL);
+        this->m_stats.allocated();
 
         try {
             traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
         }
         catch (...) {
             traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
+            this->m_stats.deallocated();
             throw;
         }
         return node;
     }
 
+    /**
+    * @brief Reserves one block for the nodes of a batch, when the allocator is monotonic.
+    * @param count The number of nodes in the batch, 0 when unknown.
+    * @return The reserved batch, empty when nodes are to be allocated one by one.
+    */
+    constexpr auto __M_reserve_batch(size_type count) -> details::node_batch<Node>
+    {
+        if constexpr (details::monotonic_allocator<allocator_t>)
+        {
+            if (count > 1UL)
+            {
+                auto block = std::to_address(traits::allocate(this->m_alloc, count));
+                this->m_stats.allocated();
+                return {block, block + count};
+            }
+        }
+        return {};
+    }
+
+    /**
+    * @brief Creates a node in the next slot of a batch, or on its own once the batch is used up.
+    * @details A slot whose construction throws stays unused; the arena reclaims it.
+    * @param batch The batch to take the node storage from.
+    * @param args Arguments for constructing the node.
+    * @return Node* Pointer to the newly created node.
+    */
+    template <class... ARGS>
+    constexpr Node *__M_create_batched(details::node_batch<Node> &batch, ARGS &&...args)
+    {
+        if (auto node = batch.take())
+        {
+            traits::construct(this->m_alloc, node, std::forward<ARGS>(args)...);
+            return node;
+        }
+        return this->__M_create_node(std::forward<ARGS>(args)...);
+    }
+
+    /**
+    * @brief Links the elements of a range after `position` in one pass, keeping their order.
+    * @param position The link after which the elements are inserted.
+    * @param first Iterator pointing to the beginning of the range.
+    * @param last Sentinel indicating the end of the range.
+    * @param batch The storage reserved for the new nodes, if any.
+    */
+    template <typename _iterator, typename _sentinel>
+    constexpr void __M_link_after(Link *position, _iterator first, _sentinel last, details::node_batch<Node> batch)
+    {
+        for (; first != last; ++first)
+        {
+            position->m_next = this->__M_create_batched(batch, *first, position->m_next);
+            position = position->m_next;
+        }
+    }
+
     /**
     * @brief Initializes the list from a range defined by iterators.
     * @tparam _iterator Type of the iterator.
@@ -522,9 +1117,9 @@ private:
         if (first == last)
             return;
 
-        this->m_head = this->__M_create_node(*first);
+        this->m_head.m_next = this->__M_create_node(*first);
 
-        auto cursor = this->m_head;
+        auto cursor = this->m_head.m_next;
 
         first = std::ranges::next(first);
 
@@ -558,6 +1153,8 @@ private:
 
         while (source != nullptr)
         {
+            details::prefetch(source->m_next);
+
             node = this->__M_create_node(source->m_data);
 
             cursor->m_next = node;
@@ -589,7 +1186,7 @@ private:
             return;
         }
 
-        if (this->m_head == nullptr)
+        if (this->m_head.m_next == nullptr)
         {
             this->__M_range_init(first, last);
             return;
@@ -603,6 +1200,7 @@ private:
         while ((first != last) && (begin != end))
         {
             *begin = *first;
+            this->m_stats.reused();
 
             prev = begin;
             begin = std::ranges::next(begin);
@@ -656,8 +1254,11 @@ private:
     {
         this->clear();
 
-        this->m_alloc = std::move(outer.m_alloc);
-        this->m_head = std::exchange(outer.m_head, nullptr);
+        // Equal but non-propagating allocators (std::pmr) are kept: they cannot be assigned
+        if constexpr (typename traits::propagate_on_container_move_assignment{})
+            this->m_alloc = std::move(outer.m_alloc);
+
+        this->m_head.m_next = std::exchange(outer.m_head.m_next, nullptr);
     }
 
     constexpr void __M_move_assign(forward_list &outer, std::false_type)
@@ -668,14 +1269,19 @@ private:
         }
         else
         {
-            this->m_head = std::exchange(outer.m_head, nullptr);
+            // The nodes of `outer` must go back to its own allocator: move the elements
+            this->clear();
+            this->__M_range_init(std::make_move_iterator(std::ranges::begin(outer)),
+                                 std::make_move_iterator(std::ranges::end(outer)));
+            outer.clear();
         }
     }
 
 private:
     // Private Members
-    Node *m_head{nullptr};
+    Link m_head{};  // Link to the first node; before_begin() points here
     [[no_unique_address]] allocator_t m_alloc{};
+    [[no_unique_address]] details::stats_recorder<Stats> m_stats{}; // Counters behind stats()
 };
 
 
@@ -687,7 +1293,7 @@ private:
 * @tparam range_t Type of the range.
 */
 template <class range_t>
-forward_list(std::from_range_t, range_t &&) -> forward_list<std::ranges::range_value_t<range_t>>;
+forward_list(details::from_range_t, range_t &&) -> forward_list<std::ranges::range_value_t<range_t>>;
 
 /**
 * @brief Deduction guide for forward_list from iterators and sentinels.
@@ -700,9 +1306,14 @@ forward_list(Iterator, Sentinel) -> forward_list<std::iter_value_t<Iterator>>;
 
 
 // Node Struct
-template <class Type>
-struct forward_list<Type>::Node final
+template <class Type, class Allocator, class Stats>
+struct forward_list<Type, Allocator, Stats>::Node final : Link
 {
+public:
+    // Grant access to the list and its iterator
+    friend struct forward_list;
+    friend struct Iterator;
+
 public:
     // Public Member Functions
 
@@ -720,7 +1331,7 @@ public:
     */
     constexpr Node(const Type &data, Node *next = nullptr) noexcept(std::is_nothrow_copy_constructible_v<Type>)
         requires(std::copy_constructible<Type>)
-        : m_data{data}, m_next{next}
+        : Link{next}, m_data{data}
     {
     }
 
@@ -731,7 +1342,7 @@ public:
     */
     constexpr Node(Type &&data, Node *next = nullptr) noexcept(std::is_nothrow_move_constructible_v<Type>)
         requires(std::move_constructible<Type>)
-        : m_data{std::move(data)}, m_next{next}
+        : Link{next}, m_data{std::move(data)}
     {
     }
 
@@ -746,20 +1357,22 @@ public:
     constexpr Node(std::in_place_t, const Tuple<ARGS...> &tuple, Node *next = nullptr)
         noexcept(std::is_nothrow_constructible_v<Type, ARGS...>)
         requires std::constructible_from<Type, ARGS...>
-        : m_data{std::make_from_tuple<Type>(tuple)}, m_next{next}
+        : Link{next}, m_data{std::make_from_tuple<Type>(tuple)}
     {
     }
 
 private:
     Type m_data{};
-    Node *m_next{nullptr};
 };
 
 
 // Iterator Struct
-template <class Type>
-struct forward_list<Type>::Iterator final
+template <class Type, class Allocator, class Stats>
+struct forward_list<Type, Allocator, Stats>::Iterator final
 {
+public:
+    friend struct forward_list;
+
 public:
     using value_type = Type;
 
@@ -767,7 +1380,7 @@ public:
     using const_reference = const Type&;
 
     using pointer       = Type*;
-    using const_pointer = const Type*
+    using const_pointer = const Type*;
 
     using difference_type = std::ptrdiff_t;
 
@@ -784,33 +1397,33 @@ public:
 
     /**
     * @brief Constructor with node.
-    * @param node Pointer to the node.
+    * @param node Pointer to the node, or to the list head for before_begin().
     */
-    constexpr Iterator(Node *node) noexcept : m_node{node} {}
+    constexpr Iterator(Link *node) noexcept : m_node{node} {}
 
     /**
     * @brief Dereference operator.
     * @return reference Reference to the data of the node.
     */
-    constexpr auto operator*() noexcept -> reference { return this->m_node->m_data; }
+    constexpr auto operator*() noexcept -> reference { return static_cast<Node *>(this->m_node)->m_data; }
 
     /**
     * @brief Dereference operator.
     * @return reference Const reference to the data of the node.
     */
-    constexpr auto operator*() const noexcept -> reference { return this->m_node->m_data }
+    constexpr auto operator*() const noexcept -> reference { return static_cast<Node *>(this->m_node)->m_data; }
 
     /**
     * @brief Arrow operator.
     * @return pointer Pointer to the data of the node.
     */
-    constexpr auto operator->() noexcept -> pointer { return std::addressof(this->m_node->m_data); }
+    constexpr auto operator->() noexcept -> pointer { return std::addressof(static_cast<Node *>(this->m_node)->m_data); }
 
     /**
     * @brief Arrow operator.
     * @return pointer Const pointer to the data of the node.
     */
-    constexpr auto operator->() const noexcept -> pointer { return std::addressof(this->m_node->m_data); }
+    constexpr auto operator->() const noexcept -> pointer { return std::addressof(static_cast<Node *>(this->m_node)->m_data); }
 
     /**
     * @brief Pre-increment operator.
@@ -819,6 +1432,10 @@ public:
     constexpr auto operator++() noexcept -> Iterator &
     {
         this->m_node = this->m_node->m_next;
+
+        if (this->m_node != nullptr)
+            details::prefetch(this->m_node->m_next);
+
         return *this;
     }
 
@@ -848,7 +1465,7 @@ public:
 
 private:
     // Private Member
-    Node *m_node{nullptr};
+    Link *m_node{nullptr};
 };
 
 
@@ -0,0 +1,379 @@
+#ifndef __INTRUSIVE_FORWARD_LIST_HXX__
+#define __INTRUSIVE_FORWARD_LIST_HXX__
+
+
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "details.h"
+
+
+/**
+* @brief Hook embedded in the elements of an intrusive_forward_list.
+* @details The element type derives from the hook, so linking an element only rewires
+*          m_next: nothing is allocated, copied or moved. Like the Link of forward_list,
+*          the same hook type serves as the list head, so before_begin() is a real position.
+*          Copying an element never copies its link: the copy starts unlinked.
+* @tparam Tag Distinguishes several hooks in one type, so it can sit in several lists at once.
+*/
+template <class Tag = void>
+struct forward_list_hook
+{
+public:
+    template <class Type, class OtherTag>
+        requires std::derived_from<Type, forward_list_hook<OtherTag>>
+    friend struct intrusive_forward_list;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Constructs an unlinked hook.
+    */
+    constexpr forward_list_hook() noexcept = default;
+
+    /**
+    * @brief Copy constructor: the copy is unlinked, the source keeps its position.
+    */
+    constexpr forward_list_hook(const forward_list_hook &) noexcept {}
+
+    /**
+    * @brief Copy assignment: a no-op, both hooks keep their own position.
+    */
+    constexpr auto operator=(const forward_list_hook &) noexcept -> forward_list_hook & { return *this; }
+
+private:
+    forward_list_hook *m_next{nullptr}; // Pointer to the next hook, null at the end of the list
+};
+
+
+/**
+* @brief A singly linked list of elements it does not own.
+* @details Elements embed a forward_list_hook<Tag> and stay wherever the user put them; the
+*          list only relinks them, so every operation is allocation-free and noexcept.
+*          Without a back link an element cannot unlink itself: use erase_after, with
+*          before_begin() for the first element. The list never destroys an element.
+* @tparam Type The type of the elements, deriving from forward_list_hook<Tag>.
+* @tparam Tag The hook of Type this list links through.
+*/
+template <class Type, class Tag = void>
+    requires std::derived_from<Type, forward_list_hook<Tag>>
+struct intrusive_forward_list final
+{
+private:
+    struct Iterator;
+
+    using hook_type = forward_list_hook<Tag>;
+
+public:
+    // Type Aliases
+
+    using value_type = Type;
+
+    using reference       = Type &;
+    using const_reference = const Type &;
+
+    using pointer       = Type *;
+    using const_pointer = const Type *;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using iterator       = Iterator;
+    using const_iterator = details::const_iterator<Iterator>;
+
+public:
+    // Constructors and Destructor
+
+    /**
+    * @brief Constructs an empty list; nothing is allocated.
+    */
+    constexpr intrusive_forward_list() noexcept = default;
+
+    /**
+    * @brief Constructs the list by linking every element of a range, keeping their order.
+    * @param first The beginning of the range of elements (lvalues) to be linked.
+    * @param last The end of the range.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<Iterator>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
+            std::bool_constant<std::same_as<std::iter_reference_t<Iterator>, Type &>>
+        >::value
+    constexpr intrusive_forward_list(Iterator first, Sentinel last) noexcept
+    {
+        for (auto position = this->before_begin(); first != last; ++first)
+            position = this->insert_after(position, *first);
+    }
+
+    // Elements cannot be in two lists through the same hook
+    intrusive_forward_list(const intrusive_forward_list &) = delete;
+    auto operator=(const intrusive_forward_list &) -> intrusive_forward_list & = delete;
+
+    /**
+    * @brief Move constructor: takes over the elements of `outer`, leaving it empty.
+    */
+    constexpr intrusive_forward_list(intrusive_forward_list &&outer) noexcept
+        : m_head{}
+    {
+        this->m_head.m_next = std::exchange(outer.m_head.m_next, nullptr);
+    }
+
+    /**
+    * @brief Move assignment: unlinks the current elements, then takes over those of `rhs`.
+    */
+    constexpr auto operator=(intrusive_forward_list &&rhs) noexcept -> intrusive_forward_list &
+    {
+        if (this != std::addressof(rhs))
+        {
+            this->clear();
+            this->m_head.m_next = std::exchange(rhs.m_head.m_next, nullptr);
+        }
+        return *this;
+    }
+
+    /**
+    * @brief Destructor. Unlinks every element; none is destroyed.
+    */
+    constexpr ~intrusive_forward_list() { this->clear(); }
+
+public:
+    // Element Insertion
+
+    /**
+    * @brief Links an unlinked element at the front of the list.
+    */
+    constexpr void push_front(Type &element) noexcept { this->insert_after(this->before_begin(), element); }
+
+    /**
+    * @brief Links an unlinked element after a specified position.
+    * @param position Iterator pointing to the position after which the element is linked.
+    * @param element The element to be linked.
+    * @return iterator The position of the linked element.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto insert_after(_iterator position, Type &element) noexcept -> iterator
+    {
+        auto current = position.m_node;
+        auto hook = static_cast<hook_type *>(std::addressof(element));
+
+        assert(hook->m_next == nullptr);
+
+        hook->m_next = current->m_next;
+        current->m_next = hook;
+
+        return iterator{hook};
+    }
+
+public:
+    // Element Removal
+
+    /**
+    * @brief Unlinks the first element, if any.
+    */
+    constexpr void pop_front() noexcept { this->erase_after(this->before_begin()); }
+
+    /**
+    * @brief Unlinks the element after a specified position, if any.
+    * @param prev Iterator pointing to the position before the element to be unlinked.
+    * @return iterator The element following the unlinked one.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto erase_after(_iterator prev) noexcept -> iterator
+    {
+        auto current = prev.m_node;
+        auto target = current->m_next;
+
+        if (target == nullptr)
+            return iterator{};
+
+        current->m_next = std::exchange(target->m_next, nullptr);
+
+        return iterator{current->m_next};
+    }
+
+    /**
+    * @brief Unlinks every element, leaving each one ready to be linked again.
+    */
+    constexpr void clear() noexcept
+    {
+        while (this->m_head.m_next != nullptr)
+            this->pop_front();
+    }
+
+public:
+    // Element Access
+
+    /**
+    * @brief Returns the first element of the list.
+    * @return std::optional<std::reference_wrapper<Type>> The element, or std::nullopt when empty.
+    */
+    constexpr auto front() noexcept -> std::optional<std::reference_wrapper<Type>>
+    {
+        if (this->m_head.m_next == nullptr)
+            return std::nullopt;
+
+        return std::optional{std::ref(static_cast<Type &>(*this->m_head.m_next))};
+    }
+
+    /**
+    * @brief Returns the first element of the list (const version).
+    */
+    constexpr auto front() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (this->m_head.m_next == nullptr)
+            return std::nullopt;
+
+        return std::optional{std::cref(static_cast<const Type &>(*this->m_head.m_next))};
+    }
+
+public:
+    // Capacity
+
+    /**
+    * @brief Checks if the list is empty.
+    */
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return (this->m_head.m_next == nullptr); }
+
+    /**
+    * @brief Returns the number of elements, by walking the list.
+    */
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type
+    {
+        return static_cast<size_type>(std::ranges::distance(this->begin(), this->end()));
+    }
+
+public:
+    // Iterator Support
+
+    constexpr auto before_begin() noexcept -> iterator { return iterator{std::addressof(this->m_head)}; }
+    constexpr auto before_begin() const noexcept -> iterator { return iterator{std::addressof(this->m_head)}; }
+    constexpr auto cbefore_begin() const noexcept -> const_iterator { return const_iterator{this->before_begin()}; }
+
+    constexpr auto begin() noexcept -> iterator { return iterator{this->m_head.m_next}; }
+    constexpr auto begin() const noexcept -> iterator { return iterator{this->m_head.m_next}; }
+    constexpr auto cbegin() const noexcept -> const_iterator { return const_iterator{this->begin()}; }
+
+    constexpr auto end() noexcept -> iterator { return iterator{}; }
+    constexpr auto end() const noexcept -> iterator { return iterator{}; }
+    constexpr auto cend() const noexcept -> const_iterator { return const_iterator{this->end()}; }
+
+    /**
+    * @brief Returns an iterator to an element of this list, in O(1).
+    * @param element An element of this list.
+    */
+    static constexpr auto iterator_to(Type &element) noexcept -> iterator
+    {
+        return iterator{static_cast<hook_type *>(std::addressof(element))};
+    }
+
+public:
+    // Operations
+
+    /**
+    * @brief Moves every element of `other` after `position`.
+    * @param position Iterator after which the elements are inserted.
+    * @param other The list to take the elements from; left empty.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice_after(_iterator position, intrusive_forward_list &other) noexcept
+    {
+        if ((this == std::addressof(other)) || other.empty())
+            return;
+
+        auto first = std::exchange(other.m_head.m_next, nullptr);
+        auto last = first;
+
+        while (last->m_next != nullptr)
+            last = last->m_next;
+
+        last->m_next = position.m_node->m_next;
+        position.m_node->m_next = first;
+    }
+
+    /**
+    * @brief Swaps the contents of two lists.
+    */
+    friend constexpr void swap(intrusive_forward_list &lhs, intrusive_forward_list &rhs) noexcept
+    {
+        std::swap(lhs.m_head.m_next, rhs.m_head.m_next);
+    }
+
+private:
+    hook_type m_head{}; // Head link: m_next is the first element
+};
+
+
+/**
+* @brief Forward iterator over an intrusive_forward_list.
+* @tparam Type The type of the elements.
+* @tparam Tag The hook the list links through.
+*/
+template <class Type, class Tag>
+    requires std::derived_from<Type, forward_list_hook<Tag>>
+struct intrusive_forward_list<Type, Tag>::Iterator final
+{
+public:
+    friend struct intrusive_forward_list;
+
+public:
+    using value_type = Type;
+
+    using reference       = Type &;
+    using const_reference = const Type &;
+
+    using pointer       = Type *;
+    using const_pointer = const Type *;
+
+    using difference_type = std::ptrdiff_t;
+
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept  = std::forward_iterator_tag;
+
+public:
+    // Constructors
+
+    constexpr Iterator() noexcept = default;
+
+    /**
+    * @brief Constructs an iterator on a hook (the list head for before_begin()).
+    * @param node Pointer to the hook.
+    */
+    explicit constexpr Iterator(const hook_type *node) noexcept : m_node{const_cast<hook_type *>(node)} {}
+
+public:
+    // Operators
+
+    constexpr auto operator*() const noexcept -> reference { return static_cast<Type &>(*this->m_node); }
+
+    constexpr auto operator->() const noexcept -> pointer { return std::addressof(static_cast<Type &>(*this->m_node)); }
+
+    constexpr auto operator++() noexcept -> Iterator &
+    {
+        this->m_node = this->m_node->m_next;
+        return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    friend constexpr auto operator==(const Iterator &lhs, const Iterator &rhs) noexcept -> bool
+    {
+        return (lhs.m_node == rhs.m_node);
+    }
+
+private:
+    hook_type *m_node{nullptr}; // The current hook
+};
+
+#endif
@@ -0,0 +1,552 @@
+#ifndef __INTRUSIVE_LIST_HXX__
+#define __INTRUSIVE_LIST_HXX__
+
+
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "details.h"
+
+
+/**
+* @brief Hook embedded in the elements of an intrusive_list.
+* @details The element type derives from the hook, so linking an element only rewires the
+*          two pointers below: nothing is allocated, copied or moved. An unlinked hook points
+*          to itself, exactly like the sentinel of list, which lets the hook unlink itself in
+*          O(1) from whatever list holds it, and it does so on destruction.
+*          Copying an element never copies its links: the copy starts unlinked.
+* @tparam Tag Distinguishes several hooks in one type, so it can sit in several lists at once.
+*/
+template <class Tag = void>
+struct list_hook
+{
+public:
+    template <class Type, class OtherTag>
+        requires std::derived_from<Type, list_hook<OtherTag>>
+    friend struct intrusive_list;
+
+public:
+    // Constructors and Destructor
+
+    /**
+    * @brief Constructs an unlinked hook.
+    */
+    constexpr list_hook() noexcept = default;
+
+    /**
+    * @brief Copy constructor: the copy is unlinked, the source keeps its position.
+    */
+    constexpr list_hook(const list_hook &) noexcept {}
+
+    /**
+    * @brief Copy assignment: a no-op, both hooks keep their own position.
+    */
+    constexpr auto operator=(const list_hook &) noexcept -> list_hook & { return *this; }
+
+    /**
+    * @brief Destructor. Unlinks the element from its list, if any.
+    */
+    constexpr ~list_hook() { this->unlink(); }
+
+public:
+    // Linking
+
+    /**
+    * @brief Checks whether the element is currently in a list.
+    */
+    [[nodiscard]] constexpr auto is_linked() const noexcept -> bool { return (this->m_next != this); }
+
+    /**
+    * @brief Removes the element from the list holding it, if any, in O(1).
+    */
+    constexpr void unlink() noexcept
+    {
+        this->m_prev->m_next = this->m_next;
+        this->m_next->m_prev = this->m_prev;
+
+        this->m_prev = this->m_next = this;
+    }
+
+private:
+    /**
+    * @brief Links `hook` right after this one.
+    * @param hook The unlinked hook to be inserted.
+    */
+    constexpr void push_front(list_hook *hook) noexcept
+    {
+        hook->m_next = this->m_next;
+        hook->m_prev = this;
+        this->m_next->m_prev = hook;
+        this->m_next = hook;
+    }
+
+    /**
+    * @brief Links `hook` right before this one.
+    * @param hook The unlinked hook to be inserted.
+    */
+    constexpr void push_back(list_hook *hook) noexcept
+    {
+        hook->m_prev = this->m_prev;
+        hook->m_next = this;
+        this->m_prev->m_next = hook;
+        this->m_prev = hook;
+    }
+
+private:
+    list_hook *m_prev{this}; // Pointer to the previous hook
+    list_hook *m_next{this}; // Pointer to the next hook
+};
+
+
+/**
+* @brief A doubly linked list of elements it does not own.
+* @details Elements embed a list_hook<Tag> and stay wherever the user put them; the list
+*          only relinks them, so every operation is allocation-free and noexcept. The sentinel
+*          is a hook inside the list object itself. Elements must outlive their membership
+*          (or simply be destroyed, which unlinks them); the list never destroys an element.
+* @tparam Type The type of the elements, deriving from list_hook<Tag>.
+* @tparam Tag The hook of Type this list links through.
+*/
+template <class Type, class Tag = void>
+    requires std::derived_from<Type, list_hook<Tag>>
+struct intrusive_list final
+{
+private:
+    struct Iterator;
+
+    using hook_type = list_hook<Tag>;
+
+public:
+    // Member type aliases
+
+    using value_type = Type;
+
+    using reference       = Type &;
+    using const_reference = const Type &;
+
+    using pointer       = Type *;
+    using const_pointer = const Type *;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using iterator       = Iterator;
+    using const_iterator = details::const_iterator<iterator>;
+
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+    // Constructors and Destructor
+
+    /**
+    * @brief Constructs an empty list; the sentinel is embedded, nothing is allocated.
+    */
+    constexpr intrusive_list() noexcept = default;
+
+    /**
+    * @brief Constructs the list by linking every element of a range, in order.
+    * @param first The beginning of the range of elements (lvalues) to be linked.
+    * @param last The end of the range.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<Iterator>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
+            std::bool_constant<std::same_as<std::iter_reference_t<Iterator>, Type &>>
+        >::value
+    constexpr intrusive_list(Iterator first, Sentinel last) noexcept
+    {
+        while (first != last)
+            this->push_back(*first++);
+    }
+
+    // Elements cannot be in two lists through the same hook
+    intrusive_list(const intrusive_list &) = delete;
+    auto operator=(const intrusive_list &) -> intrusive_list & = delete;
+
+    /**
+    * @brief Move constructor: takes over the elements of `outer`, leaving it empty.
+    */
+    constexpr intrusive_list(intrusive_list &&outer) noexcept { this->__M_take(outer); }
+
+    /**
+    * @brief Move assignment: unlinks the current elements, then takes over those of `rhs`.
+    */
+    constexpr auto operator=(intrusive_list &&rhs) noexcept -> intrusive_list &
+    {
+        if (this != std::addressof(rhs))
+        {
+            this->clear();
+            this->__M_take(rhs);
+        }
+        return *this;
+    }
+
+    /**
+    * @brief Destructor. Unlinks every element; none is destroyed.
+    */
+    constexpr ~intrusive_list() { this->clear(); }
+
+public:
+    // Element Insertion
+
+    /**
+    * @brief Links an unlinked element at the end of the list.
+    */
+    constexpr void push_back(Type &element) noexcept { this->insert_before(this->end(), element); }
+
+    /**
+    * @brief Links an unlinked element at the front of the list.
+    */
+    constexpr void push_front(Type &element) noexcept { this->insert_after(this->end(), element); }
+
+    /**
+    * @brief Links an unlinked element before a specified position.
+    * @param position The iterator specifying the position to insert before.
+    * @param element The element to be linked.
+    * @return iterator The position of the linked element.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto insert_before(_iterator position, Type &element) noexcept -> iterator
+    {
+        auto hook = static_cast<hook_type *>(std::addressof(element));
+
+        assert(not hook->is_linked());
+
+        position.m_cursor->push_back(hook);
+
+        return iterator{hook};
+    }
+
+    /**
+    * @brief Links an unlinked element after a specified position.
+    * @param position The iterator specifying the position to insert after.
+    * @param element The element to be linked.
+    * @return iterator The position of the linked element.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto insert_after(_iterator position, Type &element) noexcept -> iterator
+    {
+        auto hook = static_cast<hook_type *>(std::addressof(element));
+
+        assert(not hook->is_linked());
+
+        position.m_cursor->push_front(hook);
+
+        return iterator{hook};
+    }
+
+public:
+    // Element Removal
+
+    /**
+    * @brief Unlinks the first element; the list must not be empty.
+    */
+    constexpr void pop_front() noexcept
+    {
+        assert(not this->empty());
+
+        this->m_head.m_next->unlink();
+    }
+
+    /**
+    * @brief Unlinks the last element; the list must not be empty.
+    */
+    constexpr void pop_back() noexcept
+    {
+        assert(not this->empty());
+
+        this->m_head.m_prev->unlink();
+    }
+
+    /**
+    * @brief Unlinks the element at the specified position.
+    * @param position Iterator pointing to the element to be unlinked.
+    * @return iterator The element following the unlinked one.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto erase(_iterator position) noexcept -> iterator
+    {
+        auto target = position.m_cursor;
+        auto next = target->m_next;
+
+        target->unlink();
+
+        return iterator{next};
+    }
+
+    /**
+    * @brief Unlinks the elements in the range [first, last).
+    * @return iterator The position following the last unlinked element.
+    */
+    template <typename _iterator, typename _sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<_iterator>>,
+            std::bool_constant<std::sentinel_for<_sentinel, _iterator>>
+        >::value
+    constexpr auto erase(_iterator first, _sentinel last) noexcept -> iterator
+    {
+        while (first != last)
+            first = this->erase(first);
+
+        return first;
+    }
+
+    /**
+    * @brief Unlinks an element from this list in O(1), without looking for it.
+    * @param element An element of this list.
+    */
+    constexpr void remove(Type &element) noexcept { static_cast<hook_type &>(element).unlink(); }
+
+    /**
+    * @brief Unlinks every element, leaving each one ready to be linked again.
+    */
+    constexpr void clear() noexcept
+    {
+        while (not this->empty())
+            this->pop_front();
+    }
+
+public:
+    // Element Access
+
+    /**
+    * @brief Returns the first element of the list.
+    * @return std::optional<std::reference_wrapper<Type>> The element, or std::nullopt when empty.
+    */
+    constexpr auto front() noexcept -> std::optional<std::reference_wrapper<Type>>
+    {
+        if (this->empty())
+            return std::nullopt;
+
+        return std::optional{std::ref(__M_element(this->m_head.m_next))};
+    }
+
+    /**
+    * @brief Returns the first element of the list (const version).
+    */
+    constexpr auto front() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (this->empty())
+            return std::nullopt;
+
+        return std::optional{std::cref(__M_element(this->m_head.m_next))};
+    }
+
+    /**
+    * @brief Returns the last element of the list.
+    * @return std::optional<std::reference_wrapper<Type>> The element, or std::nullopt when empty.
+    */
+    constexpr auto back() noexcept -> std::optional<std::reference_wrapper<Type>>
+    {
+        if (this->empty())
+            return std::nullopt;
+
+        return std::optional{std::ref(__M_element(this->m_head.m_prev))};
+    }
+
+    /**
+    * @brief Returns the last element of the list (const version).
+    */
+    constexpr auto back() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (this->empty())
+            return std::nullopt;
+
+        return std::optional{std::cref(__M_element(this->m_head.m_prev))};
+    }
+
+public:
+    // Capacity
+
+    /**
+    * @brief Checks if the list is empty.
+    */
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return (not this->m_head.is_linked()); }
+
+    /**
+    * @brief Returns the number of elements, by walking the list.
+    * @details No counter is kept, since elements can unlink themselves behind the list's back.
+    */
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type
+    {
+        return static_cast<size_type>(std::distance(this->begin(), this->end()));
+    }
+
+public:
+    // Iterator Support
+
+    constexpr auto begin() noexcept -> iterator { return iterator{this->m_head.m_next}; }
+    constexpr auto begin() const noexcept -> iterator { return iterator{this->m_head.m_next}; }
+    constexpr auto cbegin() const noexcept -> const_iterator { return const_iterator{this->begin()}; }
+
+    constexpr auto end() noexcept -> iterator { return iterator{std::addressof(this->m_head)}; }
+    constexpr auto end() const noexcept -> iterator { return iterator{std::addressof(this->m_head)}; }
+    constexpr auto cend() const noexcept -> const_iterator { return const_iterator{this->end()}; }
+
+    constexpr auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{this->end()}; }
+    constexpr auto rbegin() const noexcept -> reverse_iterator { return reverse_iterator{this->end()}; }
+    constexpr auto crbegin() const noexcept -> const_reverse_iterator { return const_reverse_iterator{this->cend()}; }
+
+    constexpr auto rend() noexcept -> reverse_iterator { return reverse_iterator{this->begin()}; }
+    constexpr auto rend() const noexcept -> reverse_iterator { return reverse_iterator{this->begin()}; }
+    constexpr auto crend() const noexcept -> const_reverse_iterator { return const_reverse_iterator{this->cbegin()}; }
+
+    /**
+    * @brief Returns an iterator to an element of this list, in O(1).
+    * @param element An element of this list.
+    */
+    static constexpr auto iterator_to(Type &element) noexcept -> iterator
+    {
+        return iterator{static_cast<hook_type *>(std::addressof(element))};
+    }
+
+public:
+    // Node Relinking
+
+    /**
+    * @brief Moves every element of `other` before `position`.
+    * @param position Iterator before which the elements are inserted.
+    * @param other The list to take the elements from; left empty.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice(_iterator position, intrusive_list &other) noexcept
+    {
+        if ((this == std::addressof(other)) || other.empty())
+            return;
+
+        auto first = other.m_head.m_next;
+        auto last = other.m_head.m_prev;
+        auto next = position.m_cursor;
+
+        other.m_head.m_prev = other.m_head.m_next = std::addressof(other.m_head);
+
+        first->m_prev = next->m_prev;
+        next->m_prev->m_next = first;
+        last->m_next = next;
+        next->m_prev = last;
+    }
+
+    /**
+    * @brief Swaps the contents of two lists, relinking the neighbours of both sentinels.
+    */
+    friend constexpr void swap(intrusive_list &lhs, intrusive_list &rhs) noexcept
+    {
+        intrusive_list temp{std::move(lhs)};
+
+        lhs.__M_take(rhs);
+        rhs.__M_take(temp);
+    }
+
+private:
+    // Private member functions
+
+    /**
+    * @brief Returns the element a (non-sentinel) hook is embedded in.
+    */
+    static constexpr auto __M_element(hook_type *hook) noexcept -> Type &
+    {
+        return static_cast<Type &>(*hook);
+    }
+
+    /**
+    * @brief Moves the elements of `other` into this empty list, leaving `other` empty.
+    */
+    constexpr void __M_take(intrusive_list &other) noexcept
+    {
+        assert(this->empty());
+
+        this->splice(this->end(), other);
+    }
+
+private:
+    hook_type m_head{}; // Embedded sentinel: m_next is the first element, m_prev the last
+};
+
+
+/**
+* @brief Bidirectional iterator over an intrusive_list.
+* @tparam Type The type of the elements.
+* @tparam Tag The hook the list links through.
+*/
+template <class Type, class Tag>
+    requires std::derived_from<Type, list_hook<Tag>>
+struct intrusive_list<Type, Tag>::Iterator final
+{
+public:
+    friend struct intrusive_list;
+
+public:
+    using value_type = Type;
+
+    using reference       = Type &;
+    using const_reference = const Type &;
+
+    using pointer       = Type *;
+    using const_pointer = const Type *;
+
+    using difference_type = std::ptrdiff_t;
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using iterator_concept  = std::bidirectional_iterator_tag;
+
+public:
+    // Constructors
+
+    constexpr Iterator() noexcept = default;
+
+    /**
+    * @brief Constructs an iterator on a hook (the sentinel for end()).
+    * @param cursor Pointer to the hook.
+    */
+    explicit constexpr Iterator(const hook_type *cursor) noexcept : m_cursor{const_cast<hook_type *>(cursor)} {}
+
+public:
+    // Operators
+
+    constexpr auto operator*() const noexcept -> reference { return __M_element(this->m_cursor); }
+
+    constexpr auto operator->() const noexcept -> pointer { return std::addressof(__M_element(this->m_cursor)); }
+
+    constexpr auto operator++() noexcept -> Iterator &
+    {
+        this->m_cursor = this->m_cursor->m_next;
+        return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    constexpr auto operator--() noexcept -> Iterator &
+    {
+        this->m_cursor = this->m_cursor->m_prev;
+        return *this;
+    }
+
+    constexpr auto operator--(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        --(*this);
+        return copy;
+    }
+
+    friend constexpr auto operator==(const Iterator &lhs, const Iterator &rhs) noexcept -> bool
+    {
+        return (lhs.m_cursor == rhs.m_cursor);
+    }
+
+private:
+    hook_type *m_cursor{nullptr}; // The current hook
+};
+
+#endif
@@ -3,25 +3,23 @@
 
 
 #include <cassert>
+#include <functional>
+#include <memory>
 #include <ranges>
 #include <utility>
 
-namespace details
-{
-    /**
-    * @brief Concept ensuring two types are not the same or related through inheritance.
-    */
-    template <class T, class U>
-    concept non_self = std::conjunction_v<
-        std::negation<std::bool_constant<std::same_as<std::decay_t<T>, U>>>,
-        std::negation<std::bool_constant<std::derived_from<std::decay_t<T>, U>>>>;
-} // namespace details
+#include "container_stats.h"
+#include "details.h"
+#include "node_handle.h"
+
 
 /**
 * @brief A doubly linked list implementation.
 * @tparam Type The type of elements stored in the list.
+* @tparam Allocator The allocator used for the nodes, rebound to the node type.
+* @tparam Stats Whether the list counts its work for stats() (no_stats or operation_stats).
 */
-template <typename Type>
+template <typename Type, typename Allocator = std::allocator<Type>, typename Stats = no_stats>
 struct list final
 {
 
@@ -29,14 +27,46 @@ private:
     struct Node;
     struct Iterator;
 
+    // Links shared by the nodes and the sentinel, which is embedded in the list object
+    struct Link
+    {
+        constexpr Link() noexcept = default;
+
+        // A link is an address in a ring: it is never copied
+        Link(const Link &) = delete;
+        auto operator=(const Link &) -> Link & = delete;
+
+        // Inserts `link` right after this one
+        constexpr void push_front(Link *link) noexcept
+        {
+            link->m_next = this->m_next;
+            link->m_prev = this;
+            this->m_next->m_prev = link;
+            this->m_next = link;
+        }
+
+        // Inserts `link` right before this one
+        constexpr void push_back(Link *link) noexcept
+        {
+            link->m_prev = this->m_prev;
+            link->m_next = this;
+            this->m_prev->m_next = link;
+            this->m_prev = link;
+        }
+
+        Link *m_prev{this}; // Pointer to the previous link
+        Link *m_next{this}; // Pointer to the next link
+    };
+
 private:
-    using allocator_t = std::allocator<Node>;
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
     using traits      = std::allocator_traits<allocator_t>;
 
 public:
     // Member type aliases
 
-    using value_type = Type;
+    using value_type     = Type;
+    using allocator_type = Allocator;
 
     using reference       = Type &;
     using const_reference = const Type &;
@@ -48,11 +78,18 @@ public:
     using difference_type = std::ptrdiff_t;
 
     using iterator       = Iterator;
-    using const_iterator = std::const_iterator<iterator>;
+    using const_iterator = details::const_iterator<iterator>;
 
     using reverse_iterator       = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+    // Owning handle to an extracted node
+    using node_type = node_handle<list, Node>;
+
+private:
+    // Length of the runs sort() builds by insertion before merging
+    static constexpr size_type sort_run = 8UL;
+
     using iterator_category = std::bidirectional_iterator_tag;
     using iterator_concept  = std::bidirectional_iterator_tag;
 
@@ -60,18 +97,24 @@ public:
     // Constructors and Destructor
     /**
     * @brief Constructs an empty list.
-    * @details Requires that the stored type is default initializable.
+    * @details The sentinel is embedded in the list object: nothing is allocated.
     */
-    constexpr list()
-        requires std::default_initializable<Type>
+    constexpr list() noexcept = default;
+
+    /**
+    * @brief Constructs an empty list using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr list(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
     {
-        this->m_head = this->__M_create_node();
     }
 
     /**
     * @brief Constructs the list with elements from a range.
     * @param first The beginning of the range.
     * @param last The end of the range.
+    * @param alloc The allocator used for all node allocations.
     * @tparam Iterator The type of iterator representing the range.
     * @tparam Sentinel The type of sentinel indicating the end of the range.
     * @details Requires that the stored type is constructible from the value type of the iterator.
@@ -81,9 +124,9 @@ public:
             std::bool_constant<std::input_iterator<Iterator>>,
             std::bool_constant<std::sentinel_for<Sentinel, Iterator>>
         >::value
-    explicit constexpr list(Iterator first, Sentinel last)
+    explicit constexpr list(Iterator first, Sentinel last, const Allocator &alloc = Allocator())
         requires std::constructible_from<Type, std::iter_value_t<Iterator>>
-        : list{}
+        : list(alloc)
     {
         this->__M_range_init(first, last);
     }
@@ -91,9 +134,10 @@ public:
     /**
     * @brief Constructs the list with elements from an initializer list.
     * @param lst The initializer list.
+    * @param alloc The allocator used for all node allocations.
     */
-    constexpr list(std::initializer_list<Type> lst)
-        : list(std::ranges::begin(lst), std::ranges::end(lst))
+    constexpr list(std::initializer_list<Type> lst, const Allocator &alloc = Allocator())
+        : list(std::ranges::begin(lst), std::ranges::end(lst), alloc)
     {
     }
 
@@ -101,15 +145,16 @@ public:
     * @brief Constructs the list with elements from a range with concept constraints.
     * @param from_range_t Tag type to disambiguate from the iterator constructor.
     * @param range The range to initialize the list.
+    * @param alloc The allocator used for all node allocations.
     * @tparam range_t The type of range.
     * @details Requires that the range type is not related to the list and the stored type is constructible from the value type of the range.
     */
     template <typename range_t> requires std::ranges::range<range_t>
-    constexpr list(std::from_range_t, range_t &&range)
+    constexpr list(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
         requires(std::conjunction<
                  std::bool_constant<details::non_self<range_t, list>>,
                  std::bool_constant<std::constructible_from<Type, std::ranges::range_value_t<range_t>>>>::value)
-        : list(std::ranges::begin(range), std::ranges::end(range))
+        : list(std::ranges::begin(range), std::ranges::end(range), alloc)
     {
     }
 
@@ -118,21 +163,21 @@ public:
     * @param outer The list to copy.
     * @details Uses the allocator to copy nodes from the source list.
     */
-    constexpr list(const list &outer) noexcept(std::is_nothrow_copy_constructible<allocator_t>{})
-        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
+    constexpr list(const list &outer)
+        : list(Allocator(traits::select_on_container_copy_construction(outer.m_alloc)))
     {
-        this->m_head = this->__M_clone(outer.m_head->m_next);
+        this->__M_range_init(std::ranges::begin(outer), std::ranges::end(outer));
     }
 
     /**
     * @brief Move constructor.
     * @param outer The list to move.
-    * @details Moves the allocator and head pointer from the source list.
+    * @details Moves the allocator and relinks the nodes of `outer` to this sentinel; nothing is allocated.
     */
     constexpr list(list &&outer) noexcept(std::is_nothrow_move_constructible<allocator_t>{})
         : m_alloc{std::move(outer.m_alloc)}
     {
-        this->m_head = std::exchange(outer.m_head, this->__M_create_node());
+        __M_transfer(this->__M_sentinel(), outer.m_head.m_next, outer.__M_sentinel());
     }
 
     /**
@@ -193,9 +238,7 @@ public:
     template <class UType>
     constexpr void push_back(UType &&data)
     {
-        assert(this->m_head != nullptr);
-
-        this->m_head->push_back(this->__M_create_node(std::forward<UType>(data)));
+        this->m_head.push_back(this->__M_create_node(std::forward<UType>(data)));
     }
 
     /**
@@ -206,9 +249,7 @@ public:
     template <class UType>
     constexpr void push_front(UType &&data)
     {
-        assert(this->m_head != nullptr);
-
-        this->m_head->push_front(this->__M_create_node(std::forward<UType>(data)));
+        this->m_head.push_front(this->__M_create_node(std::forward<UType>(data)));
     }
 
     /**
@@ -225,7 +266,7 @@ public:
         >::value
     constexpr void insert_after(_iterator position, UType &&data)
     {
-        Node *node = position.m_cursor;
+        Link *node = position.m_cursor;
         node->push_front(this->__M_create_node(std::forward<UType>(data)));
     }
 
@@ -262,7 +303,7 @@ public:
             std::bool_constant<std::input_iterator<_iterator>>,
             std::bool_constant<std::input_iterator<_Iterator>>,
             std::bool_constant<std::sentinel_for<_Sentinel, _Iterator>>,
-            std::bool_constant<std::constructible_from<Type, std::iter_value_t<_Iterator>>
+            std::bool_constant<std::constructible_from<Type, std::iter_value_t<_Iterator>>>
         >::value
     constexpr void insert_after(_iterator position, _Iterator first, _Sentinel last)
     {
@@ -288,7 +329,7 @@ public:
         >::value
     constexpr void insert_before(_iterator position, UType &&data)
     {
-        Node *node = position.m_cursor;
+        Link *node = position.m_cursor;
         node->push_back(this->__M_create_node(std::forward<UType>(data)));
     }
 
@@ -325,7 +366,7 @@ public:
             std::bool_constant<std::input_iterator<_iterator>>,
             std::bool_constant<std::input_iterator<_Iterator>>,
             std::bool_constant<std::sentinel_for<_Sentinel, _Iterator>>,
-            std::bool_constant<std::constructible_from<Type, std::iter_value_t<_Iterator>>
+            std::bool_constant<std::constructible_from<Type, std::iter_value_t<_Iterator>>>
         >::value
     constexpr void insert_before(_iterator position, _Iterator first, _Sentinel last)
     {
@@ -340,9 +381,7 @@ public:
     template <class... ARGS>
     constexpr void emplace_back(ARGS &&...args)
     {
-        assert(this->m_head != nullptr);
-
-        this->m_head->push_back(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
+        this->m_head.push_back(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
     }
 
     /**
@@ -352,9 +391,7 @@ public:
     template <class... ARGS>
     constexpr void emplace_front(ARGS &&...args)
     {
-        assert(this->m_head != nullptr);
-
-        this->m_head->push_front(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
+        this->m_head.push_front(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
     }
 
     /**
@@ -364,9 +401,7 @@ public:
     template <typename _iterator, class... ARGS> requires std::input_iterator<_iterator>
     constexpr void emplace_after(_iterator position, ARGS &&...args)
     {
-        assert(this->m_head != nullptr);
-
-        Node *node = position.m_cursor;
+        Link *node = position.m_cursor;
 
         node->push_front(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
     }
@@ -378,13 +413,67 @@ public:
     template <typename _iterator, class... ARGS> requires std::input_iterator<_iterator>
     constexpr void emplace_before(_iterator position, ARGS &&...args)
     {
-        assert(this->m_head != nullptr);
-
-        Node *node = position.m_cursor;
+        Link *node = position.m_cursor;
 
         node->push_back(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
     }
 
+    /**
+    * @brief Links an extracted node at the end of the list, without allocating.
+    * @param handle The handle to take the node from; left empty.
+    */
+    constexpr void push_back(node_type &&handle) noexcept { this->insert_before(this->end(), std::move(handle)); }
+
+    /**
+    * @brief Links an extracted node at the front of the list, without allocating.
+    * @param handle The handle to take the node from; left empty.
+    */
+    constexpr void push_front(node_type &&handle) noexcept { this->insert_after(this->end(), std::move(handle)); }
+
+    /**
+    * @brief Links an extracted node after a specified position, without allocating.
+    * @param position The iterator specifying the position to insert after.
+    * @param handle The handle to take the node from; left empty.
+    * @return iterator The inserted element, or `position` if the handle was empty.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto insert_after(_iterator position, node_type &&handle) noexcept -> iterator
+    {
+        if (handle.empty())
+            return iterator{position.m_cursor};
+
+        assert(handle.__M_compatible(this->m_alloc));
+
+        auto node = handle.__M_release();
+
+        position.m_cursor->push_front(node);
+        this->m_stats.relinked();
+
+        return iterator{node};
+    }
+
+    /**
+    * @brief Links an extracted node before a specified position, without allocating.
+    * @param position The iterator specifying the position to insert before.
+    * @param handle The handle to take the node from; left empty.
+    * @return iterator The inserted element, or `position` if the handle was empty.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr auto insert_before(_iterator position, node_type &&handle) noexcept -> iterator
+    {
+        if (handle.empty())
+            return iterator{position.m_cursor};
+
+        assert(handle.__M_compatible(this->m_alloc));
+
+        auto node = handle.__M_release();
+
+        position.m_cursor->push_back(node);
+        this->m_stats.relinked();
+
+        return iterator{node};
+    }
+
 public:
     // Element Removal
     // (methods for popping elements, erasing elements, and clearing the list)
@@ -394,7 +483,7 @@ public:
     */
     constexpr void pop_front()
     {
-        this->erase(iterator{this->m_head->m_next});
+        this->erase(iterator{this->m_head.m_next});
     }
 
     /**
@@ -402,7 +491,7 @@ public:
     */
     constexpr void pop_back()
     {
-        this->erase(iterator{this->m_head->m_prev});
+        this->erase(iterator{this->m_head.m_prev});
     }
 
     /**
@@ -414,7 +503,7 @@ public:
     template <typename _iterator> requires std::input_iterator<_iterator>
     constexpr iterator erase(_iterator position)
     {
-        auto target = position.m_cursor;
+        auto target = static_cast<Node *>(position.m_cursor);
 
         target->m_prev->m_next = target->m_next;
         target->m_next->m_prev = target->m_prev;
@@ -423,6 +512,7 @@ public:
 
         traits::destroy(this->m_alloc, std::to_address(target));
         traits::deallocate(this->m_alloc, std::to_address(target), 1UL);
+        this->m_stats.deallocated();
 
         target = nullptr;
 
@@ -450,18 +540,41 @@ public:
         return last;
     }
 
+    /**
+    * @brief Unlinks the element at the specified position without destroying it.
+    * @param position Iterator pointing to the element to be extracted.
+    * @tparam _iterator Type of the iterator.
+    * @return node_type The handle owning the node, to be linked back with insert_before/insert_after.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    [[nodiscard]] constexpr auto extract(_iterator position) noexcept -> node_type
+    {
+        auto target = static_cast<Node *>(position.m_cursor);
+
+        target->m_prev->m_next = target->m_next;
+        target->m_next->m_prev = target->m_prev;
+
+        target->m_prev = target->m_next = target;
+        this->m_stats.relinked();
+
+        return node_type{target, std::addressof(target->m_data), this->m_alloc};
+    }
+
     /**
     * @brief Clears the entire list, deallocating all nodes.
+    * @details With a monotonic allocator and a trivially destructible Type the nodes
+    *          are dropped in O(1); their memory is reclaimed when the arena is released.
     */
     constexpr void clear()
     {
+        if constexpr (details::trivially_releasable<allocator_t, Type>)
+        {
+            this->m_head.m_prev = this->m_head.m_next = this->__M_sentinel();
+            return;
+        }
+
         while (not this->empty())
             this->pop_front();
-
-        traits::destroy(this->m_alloc, std::to_address(this->m_head));
-        traits::deallocate(this->m_alloc, std::to_address(this->m_head), 1UL);
-
-        this->m_head = nullptr;
     }
 
 public:
@@ -478,20 +591,20 @@ public:
         {
             return std::nullopt;
         }
-        return std::optional{std::ref(this->m_head->m_next->m_data)};
+        return std::optional{std::ref(__M_value(this->m_head.m_next))};
     }
 
     /**
     * @brief Returns the first element of the list (const version), if any.
     * @return An optional constant reference to the first element of the list.
     */
-    constexpr auto front() const noexcept -> std::optional<const std::reference_wrapper<Type>>
+    constexpr auto front() const noexcept -> std::optional<std::reference_wrapper<const Type>>
     {
         if (this->empty())
         {
             return std::nullopt;
         }
-        return std::optional{std::cref(this->m_head->m_next->m_data)};
+        return std::optional{std::cref(__M_value(this->m_head.m_next))};
     }
 
     /**
@@ -504,20 +617,20 @@ public:
         {
             return std::nullopt;
         }
-        return std::optional{std::ref(this->m_head->m_prev->m_data)};
+        return std::optional{std::ref(__M_value(this->m_head.m_prev))};
     }
 
     /**
     * @brief Returns the last element of the list (const version), if any.
     * @return An optional constant reference to the last element of the list.
     */
-    constexpr auto back() const noexcept -> std::optional<const std::reference_wrapper<Type>>
+    constexpr auto back() const noexcept -> std::optional<std::reference_wrapper<const Type>>
     {
         if (this->empty())
         {
             return std::nullopt;
         }
-        return std::optional{std::cref(this->m_head->m_prev->m_data)};
+        return std::optional{std::cref(__M_value(this->m_head.m_prev))};
     }
 
 public:
@@ -539,7 +652,37 @@ public:
     */
     constexpr auto empty() const noexcept -> bool
     {
-        return (this->m_head != nullptr) || ((this->m_head->m_prev == this->m_head) && (this->m_head->m_next == this->m_head));
+        return (this->m_head.m_next == std::addressof(this->m_head));
+    }
+
+    /**
+    * @brief Returns a copy of the allocator associated with the list.
+    * @return The allocator, rebound back to the value type.
+    */
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+    /**
+    * @brief Returns the work counted since construction or the last reset_stats().
+    * @details Node handles, splices and each run merge() moves count as relinks, elements
+    *          assign() writes over as reuses. Live bytes walk the list, as size() does.
+    * @return The counters, with the bytes of the nodes currently held.
+    */
+    [[nodiscard]] auto stats() const noexcept -> container_stats
+        requires details::stats_recorder<Stats>::enabled
+    {
+        return this->m_stats.snapshot(this->size() * sizeof(Node));
+    }
+
+    /**
+    * @brief Zeroes the counters behind stats().
+    */
+    void reset_stats() noexcept
+        requires details::stats_recorder<Stats>::enabled
+    {
+        this->m_stats.reset();
     }
 
 public:
@@ -550,31 +693,31 @@ public:
     * @brief Returns an iterator to the beginning of the list.
     * @return An iterator to the beginning of the list.
     */
-    constexpr auto begin() noexcept -> iterator { return iterator{this->m_head->m_next}; }
+    constexpr auto begin() noexcept -> iterator { return iterator{this->m_head.m_next}; }
 
     /**
     * @brief Returns a constant iterator to the beginning of the list.
     * @return A constant iterator to the beginning of the list.
     */
-    constexpr auto begin() const noexcept -> iterator { return iterator{this->m_head->m_next}; }
+    constexpr auto begin() const noexcept -> iterator { return iterator{this->m_head.m_next}; }
 
     /**
     * @brief Returns a constant iterator to the beginning of the list.
     * @return A constant iterator to the beginning of the list.
     */
-    constexpr auto cbegin() const noexcept -> const_iterator { return const_iterator{this->m_head->m_next}; }
+    constexpr auto cbegin() const noexcept -> const_iterator { return const_iterator{this->begin()}; }
 
     /**
     * @brief Returns a reverse iterator to the beginning of the list.
     * @return A reverse iterator to the beginning of the list.
     */
-    constexpr auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{this->m_head}; }
+    constexpr auto rbegin() noexcept -> reverse_iterator { return reverse_iterator{this->end()}; }
 
     /**
     * @brief Returns a reverse iterator to the beginning of the list (const version).
     * @return A reverse iterator to the beginning of the list (const version).
     */
-    constexpr auto rbegin() const noexcept -> reverse_iterator { return reverse_iterator{this->m_head}; }
+    constexpr auto rbegin() const noexcept -> reverse_iterator { return reverse_iterator{this->end()}; }
 
     /**
     * @brief Returns a constant reverse iterator to the beginning of the list.
@@ -582,26 +725,26 @@ public:
     */
     constexpr auto crbegin() const noexcept -> const_reverse_iterator
     {
-        return const_reverse_iterator{this->m_head};
+        return const_reverse_iterator{this->cend()};
     }
 
     /**
     * @brief Returns an iterator to the end of the list.
     * @return An iterator to the end of the list.
     */
-    constexpr auto end() noexcept -> iterator { return iterator{this->m_head}; }
+    constexpr auto end() noexcept -> iterator { return iterator{this->__M_sentinel()}; }
 
     /**
     * @brief Returns an iterator to the end of the list (const version).
     * @return An iterator to the end of the list (const version).
     */
-    constexpr auto end() const noexcept -> iterator { return iterator{this->m_head}; }
+    constexpr auto end() const noexcept -> iterator { return iterator{this->__M_sentinel()}; }
 
     /**
     * @brief Returns a constant iterator to the end of the list.
     * @return A constant iterator to the end of the list.
     */
-    constexpr auto cend() const noexcept -> const_iterator { return const_iterator{this->m_head}; }
+    constexpr auto cend() const noexcept -> const_iterator { return const_iterator{this->end()}; }
 
     /**
     * @brief Returns a reverse iterator to the end of the list.
@@ -609,7 +752,7 @@ public:
     */
     constexpr auto rend() noexcept -> reverse_iterator
     {
-        return reverse_iterator{this->m_head->m_next};
+        return reverse_iterator{this->begin()};
     }
 
     /**
@@ -618,7 +761,7 @@ public:
     */
     constexpr auto rend() const noexcept -> reverse_iterator
     {
-        return reverse_iterator{this->m_head->m_next};
+        return reverse_iterator{this->begin()};
     }
 
     /**
@@ -627,9 +770,206 @@ public:
     */
     constexpr auto crend() const noexcept -> const_reverse_iterator
     {
-        return const_reverse_iterator{this->m_head->m_next};
+        return const_reverse_iterator{this->cbegin()};
+    }
+
+public:
+    // Node Relinking
+    // (methods moving nodes between lists without allocating or moving elements)
+
+    /**
+    * @brief Moves every element of `other` before `position`.
+    * @param position Iterator before which the elements are inserted.
+    * @param other The list to take the elements from; left empty.
+    * @tparam _iterator The type of iterator.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice(_iterator position, list &other) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        if (this == std::addressof(other))
+            return;
+
+        __M_transfer(position.m_cursor, other.m_head.m_next, other.__M_sentinel());
+        this->m_stats.relinked();
+    }
+
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice(_iterator position, list &&other) noexcept
+    {
+        this->splice(position, other);
+    }
+
+    /**
+    * @brief Moves the element at `element` in `other` before `position`.
+    * @param position Iterator before which the element is inserted.
+    * @param other The list owning the element; may be *this.
+    * @param element Iterator to the element to be moved.
+    * @tparam _iterator The type of iterator.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice(_iterator position, list &other, _iterator element) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        __M_transfer(position.m_cursor, element.m_cursor, element.m_cursor->m_next);
+        this->m_stats.relinked();
+    }
+
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice(_iterator position, list &&other, _iterator element) noexcept
+    {
+        this->splice(position, other, element);
+    }
+
+    /**
+    * @brief Moves the elements in [first, last) of `other` before `position`.
+    * @param position Iterator before which the elements are inserted; must not lie in [first, last).
+    * @param other The list owning the elements; may be *this.
+    * @param first Iterator to the first element to be moved.
+    * @param last Iterator following the last element to be moved.
+    * @tparam _iterator The type of iterator.
+    */
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice(_iterator position, list &other, _iterator first, _iterator last) noexcept
+    {
+        assert(this->__M_compatible(other));
+
+        __M_transfer(position.m_cursor, first.m_cursor, last.m_cursor);
+        this->m_stats.relinked();
+    }
+
+    template <typename _iterator> requires std::input_iterator<_iterator>
+    constexpr void splice(_iterator position, list &&other, _iterator first, _iterator last) noexcept
+    {
+        this->splice(position, other, first, last);
+    }
+
+    /**
+    * @brief Merges the sorted list `other` into this sorted list.
+    * @details Stable: for equivalent elements those of *this precede those of `other`.
+    *          Runs of `other` that belong before the same element are relinked at once.
+    * @param other The list to merge from; left empty.
+    * @param comp The ordering both lists are sorted by.
+    * @tparam Compare The type of the strict weak ordering.
+    */
+    template <class Compare>
+        requires std::strict_weak_order<Compare &, const Type &, const Type &>
+    constexpr void merge(list &other, Compare comp)
+    {
+        assert(this->__M_compatible(other));
+
+        if ((this == std::addressof(other)) || other.empty())
+            return;
+
+        auto first = this->m_head.m_next;
+        auto source = other.m_head.m_next;
+
+        while ((first != this->__M_sentinel()) && (source != other.__M_sentinel()))
+        {
+            if (std::invoke(comp, std::as_const(__M_value(source)), std::as_const(__M_value(first))))
+            {
+                auto run = source->m_next;
+
+                while ((run != other.__M_sentinel()) &&
+                       std::invoke(comp, std::as_const(__M_value(run)), std::as_const(__M_value(first))))
+                {
+                    run = run->m_next;
+                }
+
+                __M_transfer(first, source, run);
+                this->m_stats.relinked();
+                source = run;
+            }
+            else
+            {
+                first = first->m_next;
+            }
+        }
+
+        if (source != other.__M_sentinel())
+        {
+            __M_transfer(this->__M_sentinel(), source, other.__M_sentinel());
+            this->m_stats.relinked();
+        }
+    }
+
+    template <class Compare>
+        requires std::strict_weak_order<Compare &, const Type &, const Type &>
+    constexpr void merge(list &&other, Compare comp)
+    {
+        this->merge(other, comp);
+    }
+
+    /**
+    * @brief Merges the sorted list `other` into this sorted list using operator<.
+    * @param other The list to merge from; left empty.
+    */
+    constexpr void merge(list &other) { this->merge(other, std::less<>{}); }
+
+    constexpr void merge(list &&other) { this->merge(other, std::less<>{}); }
+
+    /**
+    * @brief Sorts the list in place by relinking nodes, in O(n log n) with O(1) extra memory.
+    * @details Stable bottom-up merge sort over the `m_next` links only: runs of sort_run
+    *          nodes are first sorted by insertion, then merged pairwise with doubling width,
+    *          and the `m_prev` links are rebuilt in a final pass. No element is copied or
+    *          moved. If the comparison throws, every node stays in the list in some order.
+    * @param comp The ordering to sort by.
+    * @tparam Compare The type of the strict weak ordering.
+    */
+    template <class Compare>
+        requires std::strict_weak_order<Compare &, const Type &, const Type &>
+    constexpr void sort(Compare comp)
+    {
+        if (this->m_head.m_next == this->m_head.m_prev)
+            return;
+
+        this->m_head.m_prev->m_next = nullptr;
+
+        try {
+            auto count = this->__M_sort_runs(comp);
+
+            for (size_type width = sort_run; width < count; width = width * 2UL)
+            {
+                Link *tail = this->__M_sentinel();
+                Link *rest = this->m_head.m_next;
+
+                try {
+                    while (rest != nullptr)
+                    {
+                        auto lhs = rest;
+                        auto rhs = __M_cut(lhs, width);
+
+                        rest = __M_cut(rhs, width);
+                        details::prefetch(rest);
+
+                        tail = __M_merge(tail, lhs, rhs, comp);
+                    }
+                }
+                catch (...) {
+                    for (; tail->m_next != nullptr; tail = tail->m_next)
+                    {
+                    }
+                    tail->m_next = rest;
+                    throw;
+                }
+            }
+        }
+        catch (...) {
+            this->__M_relink_prev();
+            throw;
+        }
+
+        this->__M_relink_prev();
     }
 
+    /**
+    * @brief Sorts the list in place using operator<.
+    */
+    constexpr void sort() { this->sort(std::less<>{}); }
+
 public:
     // Friend Function
 
@@ -642,7 +982,7 @@ public:
     * @param lhs First list to swap.
     * @param rhs Second list to swap.
     */
-    friend constexpr void swap(forward_list &lhs, forward_list &rhs)
+    friend constexpr void swap(list &lhs, list &rhs)
             noexcept(std::disjunction<typename traits::propagate_on_container_swap,
                                         typename traits::is_always_equal>{})
     {
@@ -651,7 +991,11 @@ public:
             std::swap(lhs.m_alloc, rhs.m_alloc);
         }
 
-        std::swap(lhs.m_head, rhs.m_head);
+        Link temp{};
+
+        __M_transfer(std::addressof(temp), lhs.m_head.m_next, lhs.__M_sentinel());
+        __M_transfer(lhs.__M_sentinel(), rhs.m_head.m_next, rhs.__M_sentinel());
+        __M_transfer(rhs.__M_sentinel(), temp.m_next, std::addressof(temp));
     }
 
 private:
@@ -659,51 +1003,222 @@ private:
     // (helper functions for memory management and list operations)
 
     /**
-    * @brief Helper function to create a new node.
-    * @tparam ARGS Types of arguments for constructing the node.
-    * @param args Arguments forwarded to the node constructor.
-    * @return Pointer to the newly created node.
+    * @brief Returns the embedded sentinel, as used by end().
     */
-    template <class... ARGS>
-    constexpr Node *__M_create_node(ARGS &&...args)
+    [[nodiscard]] constexpr auto __M_sentinel() const noexcept -> Link *
     {
-        auto node = traits::allocate(this->m_alloc, 1UL);
+        return const_cast<Link *>(std::addressof(this->m_head));
+    }
+
+    /**
+    * @brief Returns the element stored in the node behind a (non-sentinel) link.
+    */
+    [[nodiscard]] static constexpr auto __M_value(Link *link) noexcept -> Type &
+    {
+        return static_cast<Node *>(link)->m_data;
+    }
+
+    /**
+    * @brief Whether nodes of `other` may be relinked into this list.
+    */
+    [[nodiscard]] constexpr auto __M_compatible(const list &other) const noexcept -> bool
+    {
+        if constexpr (typename traits::is_always_equal{})
+        {
+            return true;
+        }
+        else
+        {
+            return (this->m_alloc == other.m_alloc);
+        }
+    }
+
+    /**
+    * @brief Detaches the `m_next` chain after the first `count` nodes of `head`.
+    * @return Link* Head of the detached rest, nullptr if the chain was not longer.
+    */
+    static constexpr auto __M_cut(Link *head, size_type count) noexcept -> Link *
+    {
+        for (; (head != nullptr) && (count > 1UL); --count)
+        {
+            head = head->m_next;
+        }
+
+        if (head == nullptr)
+            return nullptr;
+
+        return std::exchange(head->m_next, nullptr);
+    }
+
+    /**
+    * @brief Merges two sorted null-terminated `m_next` chains after `out`.
+    * @details Elements of `lhs` precede equivalent elements of `rhs`. If the comparison
+    *          throws, every node is still chained after `out` before the exception propagates.
+    * @return Link* The last node of the merged chain.
+    */
+    template <class Compare>
+    static constexpr auto __M_merge(Link *out, Link *lhs, Link *rhs, Compare &comp) -> Link *
+    {
+        auto tail = out;
 
         try {
-            traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
+            while ((lhs != nullptr) && (rhs != nullptr))
+            {
+                if (std::invoke(comp, std::as_const(__M_value(rhs)), std::as_const(__M_value(lhs))))
+                {
+                    tail->m_next = rhs;
+                    rhs = rhs->m_next;
+                }
+                else
+                {
+                    tail->m_next = lhs;
+                    lhs = lhs->m_next;
+                }
+
+                tail = tail->m_next;
+            }
         }
         catch (...) {
-            traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
+            for (tail->m_next = lhs; tail->m_next != nullptr; tail = tail->m_next)
+            {
+            }
+            tail->m_next = rhs;
             throw;
         }
-        return node;
+
+        for (tail->m_next = (lhs != nullptr) ? lhs : rhs; tail->m_next != nullptr; tail = tail->m_next)
+        {
+        }
+
+        return tail;
     }
 
     /**
-    * @brief Helper function to clone nodes from another list.
-    * @param source Pointer to the node from which to start cloning.
-    * @return Pointer to the cloned list.
+    * @brief First pass of sort(): insertion-sorts consecutive runs of sort_run nodes.
+    * @details A node not less than the run's last node is appended directly, so presorted
+    *          input costs one comparison per node. A node is only unlinked once its place
+    *          is known, so a throwing comparison leaves every node chained.
+    * @return size_type The number of nodes in the list.
     */
-    constexpr Node *__M_clone(Node *source)
+    template <class Compare>
+    constexpr auto __M_sort_runs(Compare &comp) -> size_type
     {
-        if (source == nullptr)
-        {
-            this->clear();
-            return source;
+        Link *tail = this->__M_sentinel();
+        Link *rest = std::exchange(this->m_head.m_next, nullptr);
+
+        size_type count = 0UL;
+
+        try {
+            while (rest != nullptr)
+            {
+                Link *last = tail;
+
+                for (size_type taken = 0UL; (rest != nullptr) && (taken != sort_run); ++taken)
+                {
+                    Link *prev = last;
+
+                    if ((last != tail) && std::invoke(comp, std::as_const(__M_value(rest)), std::as_const(__M_value(last))))
+                    {
+                        for (prev = tail; not std::invoke(comp, std::as_const(__M_value(rest)),
+                                                          std::as_const(__M_value(prev->m_next)));)
+                        {
+                            prev = prev->m_next;
+                        }
+                    }
+
+                    auto node = std::exchange(rest, rest->m_next);
+
+                    node->m_next = prev->m_next;
+                    prev->m_next = node;
+
+                    if (prev == last)
+                    {
+                        last = node;
+                    }
+
+                    count = count + 1UL;
+                }
+
+                tail = last;
+            }
+        }
+        catch (...) {
+            for (; tail->m_next != nullptr; tail = tail->m_next)
+            {
+            }
+            tail->m_next = rest;
+            throw;
         }
 
-        auto cursor = this->__M_create_node();
+        return count;
+    }
 
-        auto end = source->m_prev;
+    /**
+    * @brief Closes the null-terminated `m_next` chain starting at the sentinel back into
+    *        a circular list and rebuilds every `m_prev` link.
+    */
+    constexpr void __M_relink_prev() noexcept
+    {
+        auto prev = this->__M_sentinel();
 
-        while (source != end)
+        for (auto node = this->m_head.m_next; node != nullptr; node = node->m_next)
         {
-            cursor->push_back(this->__M_create_node(source->m_data));
-            source = source->m_next;
+            node->m_prev = prev;
+            prev = node;
+        }
+
+        prev->m_next = this->__M_sentinel();
+        this->m_head.m_prev = prev;
+    }
+
+    /**
+    * @brief Relinks the nodes in [first, last) before `position`, in O(1).
+    * @param position Node before which the nodes are inserted; must not lie in [first, last).
+    * @param first First node to be moved.
+    * @param last Node following the last node to be moved.
+    */
+    static constexpr void __M_transfer(Link *position, Link *first, Link *last) noexcept
+    {
+        if ((first == last) || (position == last))
+            return;
+
+        auto tail = last->m_prev;
+
+        first->m_prev->m_next = last;
+        last->m_prev = first->m_prev;
+
+        auto before = position->m_prev;
+
+        before->m_next = first;
+        first->m_prev = before;
+        tail->m_next = position;
+        position->m_prev = tail;
+    }
+
+    /**
+    * @brief Helper function to create a new node.
+    * @tparam ARGS Types of arguments for constructing the node.
+    * @param args Arguments forwarded to the node constructor.
+    * @return Pointer to the newly created node.
+    */
+    template <class... ARGS>
+    constexpr Node *__M_create_node(ARGS &&...args)
+    {
+        auto node = traits::allocate(this->m_alloc, 1UL);
+        this->m_stats.allocated();
+
+        try {
+            traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
         }
-        return cursor;
+        catch (...) {
+            traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
+            this->m_stats.deallocated();
+            throw;
+        }
+        return node;
     }
 
+
     /**
     * @brief Helper function to initialize the list with elements from a range.
     * @tparam _iterator Type of the iterator.
@@ -720,7 +1235,7 @@ private:
     {
         for (; first != last; first = std::ranges::next(first))
         {
-            this->m_head->push_back(this->__M_create_node(*first));
+            this->m_head.push_back(this->__M_create_node(*first));
         }
     }
 
@@ -756,6 +1271,7 @@ private:
         while ((first != last) && (begin != end))
         {
             *begin = *first;
+            this->m_stats.reused();
             begin = std::ranges::next(begin);
             first = std::ranges::next(first);
         }
@@ -806,8 +1322,11 @@ private:
     {
         this->clear();
 
-        this->m_alloc = std::move(outer.m_alloc);
-        this->m_head  = std::exchange(outer.m_head, this->__M_create_node());
+        // Equal but non-propagating allocators (std::pmr) are kept: they cannot be assigned
+        if constexpr (typename traits::propagate_on_container_move_assignment{})
+            this->m_alloc = std::move(outer.m_alloc);
+
+        __M_transfer(this->__M_sentinel(), outer.m_head.m_next, outer.__M_sentinel());
     }
 
     /**
@@ -822,13 +1341,17 @@ private:
             this->__M_move_assign(outer, std::true_type{});
         }
         else {
-            this->m_head = std::exchange(outer.m_head, this->__M_create_node());
+            this->__M_assign(std::make_move_iterator(std::ranges::begin(outer)),
+                             std::make_move_iterator(std::ranges::end(outer)));
+            outer.clear();
         }
     }
 
 private:
-    Node *m_head;                              // Pointer to the head of the list
-    [[no_unique_address]] allocator_t m_alloc; // Allocator
+    Link m_head{};                               // Embedded sentinel: m_next is the first node, m_prev the last
+    [[no_unique_address]] allocator_t m_alloc{}; // Allocator
+
+    [[no_unique_address]] details::stats_recorder<Stats> m_stats{}; // Counters behind stats()
 };
 
 // Deduction guides
@@ -838,7 +1361,7 @@ private:
 * @tparam range_t Type of the range.
 */
 template <typename range_t>
-list(std::from_range_t, range_t &&) -> list<std::ranges::range_value_t<range_t>>;
+list(details::from_range_t, range_t &&) -> list<std::ranges::range_value_t<range_t>>;
 
 /**
 * @brief Deduction guide for list from iterators and sentinels.
@@ -855,9 +1378,10 @@ list(iterator, sentinel) -> list<std::iter_value_t<iterator>>;
 * of type Type and pointers to the previous and next nodes in the list.
 * @brief Represents an individual node in a linked list.
 * @tparam Type The type of data held by the node.
+* @tparam Allocator The allocator type of the owning list.
 */
-template <typename Type>
-struct list<Type>::Node final
+template <typename Type, typename Allocator, typename Stats>
+struct list<Type, Allocator, Stats>::Node final : Link
 {
 public:
     // Grant access to the list class
@@ -909,36 +1433,7 @@ public:
     }
 
 private:
-    /**
-    * This function inserts the given node in front of the current node in the linked list.
-    * @brief Inserts a node in front of the current node.
-    * @param node Pointer to the node to be inserted.
-    */
-    constexpr void push_front(Node *node) noexcept
-    {
-        node->m_next = this->m_next;
-        node->m_prev = this;
-        this->m_next->m_prev = node;
-        this->m_next = node;
-    }
-
-    /**
-    * This function inserts the given node behind the current node in the linked list.
-    * @brief Inserts a node behind the current node.
-    * @param node Pointer to the node to be inserted.
-    */
-    constexpr void push_back(Node *node) noexcept
-    {
-        node->m_prev = this->m_prev;
-        node->m_next = this;
-        this->m_prev->m_next = node;
-        this->m_prev = node;
-    }
-
-private:
-    Type m_data{};      // Data stored in the node
-    Node *m_prev{this}; // Pointer to the previous node
-    Node *m_next{this}; // Pointer to the next node
+    Type m_data{}; // Data stored in the node
 };
 
 /**
@@ -946,9 +1441,10 @@ private:
 * It provides bidirectional traversal capabilities.
 * @brief Represents an iterator for traversing a linked list.
 * @tparam Type The type of data stored in the linked list.
+* @tparam Allocator The allocator type of the owning list.
 */
-template <class Type>
-struct list<Type>::Iterator final
+template <class Type, class Allocator, class Stats>
+struct list<Type, Allocator, Stats>::Iterator final
 {
 public:
     friend struct list;
@@ -980,7 +1476,7 @@ public:
     * @brief Constructs an iterator with a given node pointer.
     * @param cursor Pointer to the node.
     */
-    constexpr Iterator(Node *cursor) noexcept
+    constexpr Iterator(Link *cursor) noexcept
         : m_cursor{cursor}
     {
     }
@@ -999,14 +1495,14 @@ public:
     * @brief Dereference operator.
     * @return Reference to the data.
     */
-    constexpr auto operator*() noexcept -> reference { return this->m_cursor->m_data; }
+    constexpr auto operator*() noexcept -> reference { return static_cast<Node *>(this->m_cursor)->m_data; }
 
     /**
     * Returns a const reference to the data stored in the current node.
     * @brief Dereference operator (const version).
     * @return Const reference to the data.
     */
-    constexpr auto operator*() const noexcept -> reference { return this->m_cursor->m_data; }
+    constexpr auto operator*() const noexcept -> reference { return static_cast<Node *>(this->m_cursor)->m_data; }
 
 public:
     // Member access operators
@@ -1015,14 +1511,14 @@ public:
     * @brief Member access operator.
     * @return Pointer to the data.
     */
-    constexpr auto operator->() noexcept { return std::addressof(this->m_cursor->m_data); }
+    constexpr auto operator->() noexcept { return std::addressof(static_cast<Node *>(this->m_cursor)->m_data); }
 
     /**
     * Returns a const pointer to the data stored in the current node.
     * @brief Member access operator (const version).
     * @return Const pointer to the data.
     */
-    constexpr auto operator->() const noexcept { return std::addressof(this->m_cursor->m_data); }
+    constexpr auto operator->() const noexcept { return std::addressof(static_cast<Node *>(this->m_cursor)->m_data); }
 
 public:
     // Increment and decrement operators
@@ -1034,6 +1530,7 @@ public:
     constexpr auto operator++() noexcept -> iterator &
     {
         this->m_cursor = this->m_cursor->m_next;
+        details::prefetch(this->m_cursor->m_next);
         return *this;
     }
 
@@ -1045,6 +1542,7 @@ public:
     constexpr auto operator--() noexcept -> iterator &
     {
         this->m_cursor = this->m_cursor->m_prev;
+        details::prefetch(this->m_cursor->m_prev);
         return *this;
     }
 
@@ -1091,7 +1589,7 @@ public:
     }
 
 private:
-    Node *m_cursor{nullptr}; ///< Pointer to the current node.
+    Link *m_cursor{nullptr}; ///< Pointer to the current node, or to the sentinel for end().
 };
 
 #endif /* LIST_HPP */
@@ -0,0 +1,212 @@
+#ifndef __NODE_HANDLE_HXX__
+#define __NODE_HANDLE_HXX__
+
+
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <utility>
+
+
+/**
+* @brief Owning handle to a node extracted from a node-based container.
+* @details Returned by the containers' extract() and consumed by their node-taking
+*          insertions, it lets an element be modified (e.g. rekeyed) or moved to another
+*          container of the same type without destroying, freeing or allocating anything.
+*          The handle carries the allocator the node came from; a handle still holding a
+*          node when destroyed destroys the element and gives the node back to it.
+* @tparam Container The container type the node belongs to.
+* @tparam Node The container's node type.
+*/
+template <class Container, class Node>
+struct node_handle final
+{
+public:
+    friend Container;
+
+public:
+    // Public typedefs
+    using value_type     = typename Container::value_type;
+    using allocator_type = typename Container::allocator_type;
+
+private:
+    // Type aliases for the node allocator and its traits
+    using allocator_t = typename std::allocator_traits<allocator_type>::template rebind_alloc<Node>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+public:
+    // Constructors and Destructor
+    /**
+    * @brief Constructs an empty handle.
+    */
+    constexpr node_handle() noexcept = default;
+
+    node_handle(const node_handle &) = delete;
+
+    /**
+    * @brief Move constructor, taking over the node and its allocator.
+    * @param other The handle to move from; left empty.
+    */
+    constexpr node_handle(node_handle &&other) noexcept
+        : m_node{std::exchange(other.m_node, nullptr)},
+          m_value{std::exchange(other.m_value, nullptr)},
+          m_alloc{std::move(other.m_alloc)}
+    {
+        other.m_alloc.reset();
+    }
+
+    auto operator=(const node_handle &) -> node_handle & = delete;
+
+    /**
+    * @brief Move assignment: releases the current node, then takes over the other one.
+    * @param other The handle to move from; left empty.
+    * @return node_handle& Reference to this handle.
+    */
+    constexpr auto operator=(node_handle &&other) noexcept -> node_handle &
+    {
+        if (this != std::addressof(other))
+        {
+            this->__M_reset();
+
+            this->m_node = std::exchange(other.m_node, nullptr);
+            this->m_value = std::exchange(other.m_value, nullptr);
+
+            // Re-emplaced rather than assigned: std::pmr allocators cannot be assigned
+            this->m_alloc.reset();
+
+            if (other.m_alloc.has_value())
+                this->m_alloc.emplace(std::move(*other.m_alloc));
+
+            other.m_alloc.reset();
+        }
+        return *this;
+    }
+
+    /**
+    * @brief Destructor. Destroys the element still held, if any.
+    */
+    constexpr ~node_handle() { this->__M_reset(); }
+
+public:
+    // Observers
+
+    // Check if the handle holds no node
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return (this->m_node == nullptr); }
+
+    // Check if the handle holds a node
+    explicit constexpr operator bool() const noexcept { return (this->m_node != nullptr); }
+
+    /**
+    * @brief Returns the element held; the handle must not be empty.
+    * @return value_type& A mutable reference, so a key can be changed before reinsertion.
+    */
+    [[nodiscard]] constexpr auto value() const noexcept -> value_type &
+    {
+        assert(not this->empty());
+
+        return *this->m_value;
+    }
+
+    /**
+    * @brief Returns a copy of the allocator the node came from; the handle must not be empty.
+    */
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        assert(not this->empty());
+
+        return allocator_type(*this->m_alloc);
+    }
+
+public:
+    // Swap function
+
+    /**
+    * @brief Swaps the nodes and allocators of two handles.
+    */
+    friend constexpr void swap(node_handle &lhs, node_handle &rhs) noexcept
+    {
+        std::swap(lhs.m_node, rhs.m_node);
+        std::swap(lhs.m_value, rhs.m_value);
+
+        // Allocators are re-emplaced, as in the move assignment
+        std::optional<allocator_t> temp{};
+
+        if (lhs.m_alloc.has_value())
+            temp.emplace(std::move(*lhs.m_alloc));
+
+        lhs.m_alloc.reset();
+
+        if (rhs.m_alloc.has_value())
+            lhs.m_alloc.emplace(std::move(*rhs.m_alloc));
+
+        rhs.m_alloc.reset();
+
+        if (temp.has_value())
+            rhs.m_alloc.emplace(std::move(*temp));
+    }
+
+private:
+    // Private member functions, used by the owning container
+
+    /**
+    * @brief Wraps a node already unlinked from its container.
+    * @param node The node.
+    * @param value The element stored in the node.
+    * @param alloc The allocator the node was allocated with.
+    */
+    constexpr node_handle(Node *node, value_type *value, const allocator_t &alloc) noexcept
+        : m_node{node}, m_value{value}, m_alloc{alloc}
+    {
+    }
+
+    /**
+    * @brief Whether the node may be linked into a container using `alloc`.
+    */
+    [[nodiscard]] constexpr auto __M_compatible(const allocator_t &alloc) const noexcept -> bool
+    {
+        if constexpr (typename traits::is_always_equal{})
+        {
+            return true;
+        }
+        else
+        {
+            return (*this->m_alloc == alloc);
+        }
+    }
+
+    /**
+    * @brief Gives up ownership of the node, leaving the handle empty.
+    * @return Node* The node, for the container to link.
+    */
+    constexpr auto __M_release() noexcept -> Node *
+    {
+        this->m_alloc.reset();
+        this->m_value = nullptr;
+
+        return std::exchange(this->m_node, nullptr);
+    }
+
+    /**
+    * @brief Destroys and deallocates the node held, if any.
+    */
+    constexpr void __M_reset() noexcept
+    {
+        if (this->m_node != nullptr)
+        {
+            traits::destroy(*this->m_alloc, std::to_address(this->m_node));
+            traits::deallocate(*this->m_alloc, std::to_address(this->m_node), 1UL);
+
+            this->m_node = nullptr;
+            this->m_value = nullptr;
+        }
+        this->m_alloc.reset();
+    }
+
+private:
+    // Private data members
+    Node *m_node{nullptr};                // The node owned, null when empty
+    value_type *m_value{nullptr};         // The element stored in the node
+    std::optional<allocator_t> m_alloc{}; // The allocator the node came from, engaged when not empty
+};
+
+#endif
@@ -0,0 +1,400 @@
+#ifndef __NODE_POOL_HXX__
+#define __NODE_POOL_HXX__
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+
+/**
+* @brief A single-threaded pool of fixed-size blocks carved out of slab chunks.
+* @details Blocks are handed out contiguously from the newest chunk and recycled
+*          through an intrusive free list, so push/pop churn never reaches malloc.
+*          Chunks are only returned to the system by release() or the destructor.
+* @tparam BlockSize The size in bytes of every block.
+* @tparam BlockAlign The alignment in bytes of every block.
+* @tparam ChunkBlocks The number of blocks allocated per slab chunk.
+*/
+template <std::size_t BlockSize, std::size_t BlockAlign, std::size_t ChunkBlocks>
+    requires (ChunkBlocks > 0UL)
+struct node_pool final
+{
+private:
+    // Forward declarations of the block and chunk layouts
+    union Block;
+    struct Chunk;
+
+public:
+    using size_type = std::size_t;
+
+public:
+    /**
+    * @brief Default constructor. No memory is reserved until the first allocation.
+    */
+    constexpr node_pool() noexcept = default;
+
+    node_pool(const node_pool &) = delete;
+    node_pool &operator=(const node_pool &) = delete;
+
+    /**
+    * @brief Move constructor. Takes ownership of every chunk of `outer`.
+    * @param outer The pool to be moved from.
+    */
+    constexpr node_pool(node_pool &&outer) noexcept
+    {
+        this->m_free   = std::exchange(outer.m_free, nullptr);
+        this->m_chunks = std::exchange(outer.m_chunks, nullptr);
+        this->m_bump   = std::exchange(outer.m_bump, ChunkBlocks);
+    }
+
+    /**
+    * @brief Destructor. Returns every chunk to the system.
+    */
+    ~node_pool() { this->release(); }
+
+public:
+    /**
+    * @brief Hands out one block, preferring recycled blocks over fresh ones.
+    * @return Pointer to uninitialized storage of BlockSize bytes.
+    */
+    [[nodiscard]] auto allocate() -> void *
+    {
+        if (auto block = this->m_free)
+        {
+            this->m_free = block->m_next;
+            return block->m_storage;
+        }
+
+        if (this->m_bump == ChunkBlocks)
+        {
+            this->__M_grow();
+        }
+
+        return this->m_chunks->m_blocks[this->m_bump++].m_storage;
+    }
+
+    /**
+    * @brief Gives a block back to the pool for reuse.
+    * @param pointer A block previously obtained from allocate().
+    */
+    void deallocate(void *pointer) noexcept
+    {
+        auto block = ::new (pointer) Block;
+
+        block->m_next = this->m_free;
+        this->m_free  = block;
+    }
+
+    /**
+    * @brief Returns every chunk to the system, invalidating all outstanding blocks.
+    */
+    void release() noexcept
+    {
+        while (auto chunk = this->m_chunks)
+        {
+            this->m_chunks = chunk->m_next;
+
+            chunk->~Chunk();
+            ::operator delete(chunk, std::align_val_t{alignof(Chunk)});
+        }
+
+        this->m_free = nullptr;
+        this->m_bump = ChunkBlocks;
+    }
+
+private:
+    /**
+    * @brief Allocates a new slab chunk and makes it the bump-allocation source.
+    */
+    void __M_grow()
+    {
+        auto memory = ::operator new(sizeof(Chunk), std::align_val_t{alignof(Chunk)});
+        auto chunk  = ::new (memory) Chunk;
+
+        chunk->m_next  = this->m_chunks;
+        this->m_chunks = chunk;
+        this->m_bump   = 0UL;
+    }
+
+private:
+    // Storage of a single block, overlaid with the free-list link while unused
+    union Block
+    {
+        Block *m_next;
+        alignas(BlockAlign) std::byte m_storage[BlockSize];
+    };
+
+    // A slab of contiguous blocks, linked to the previously allocated chunk
+    struct Chunk
+    {
+        Chunk *m_next{nullptr};
+        Block m_blocks[ChunkBlocks];
+    };
+
+private:
+    Block *m_free{nullptr};        // Head of the intrusive free list
+    Chunk *m_chunks{nullptr};      // Most recently allocated chunk
+    size_type m_bump{ChunkBlocks}; // Next untouched block of the newest chunk
+};
+
+
+
+namespace details
+{
+    /**
+    * @brief Process-wide pool shared by every pool_allocator with the same block geometry.
+    * @details The instance is intentionally immortal so that containers with static
+    *          storage duration can still return their nodes during program exit.
+    */
+    template <std::size_t BlockSize, std::size_t BlockAlign, std::size_t ChunkBlocks>
+    struct shared_node_pool final
+    {
+        using pool_type = node_pool<BlockSize, BlockAlign, ChunkBlocks>;
+
+        // Number of blocks moved between a thread cache and the shared pool at once
+        static constexpr std::size_t batch_size = (ChunkBlocks < 32UL) ? ChunkBlocks : 32UL;
+
+        [[nodiscard]] static auto instance() -> shared_node_pool &
+        {
+            alignas(shared_node_pool) static std::byte storage[sizeof(shared_node_pool)];
+            static auto pool = ::new (static_cast<void *>(storage)) shared_node_pool{};
+
+            return *pool;
+        }
+
+        [[nodiscard]] auto allocate() -> void *
+        {
+            std::scoped_lock lock{this->m_mutex};
+            return this->m_pool.allocate();
+        }
+
+        void deallocate(void *pointer) noexcept
+        {
+            std::scoped_lock lock{this->m_mutex};
+            this->m_pool.deallocate(pointer);
+        }
+
+        std::mutex m_mutex{};
+        pool_type m_pool{};
+    };
+
+    /**
+    * @brief Per-thread cache of free blocks in front of a shared_node_pool.
+    * @details Refills and flushes in batches, so the shared mutex is taken once
+    *          per batch_size allocations instead of once per allocation. The cache is
+    *          destroyed at thread exit, before the containers with static storage duration
+    *          of the main thread: from then on instance() is null and the shared pool,
+    *          which is immortal, serves that thread directly.
+    */
+    template <std::size_t BlockSize, std::size_t BlockAlign, std::size_t ChunkBlocks>
+    struct thread_node_cache final
+    {
+        using shared_type = shared_node_pool<BlockSize, BlockAlign, ChunkBlocks>;
+
+        // Upper bound of cached blocks before half of them are flushed back
+        static constexpr std::size_t cache_limit = 2UL * shared_type::batch_size;
+
+        struct Link
+        {
+            Link *m_next;
+        };
+
+        /**
+        * @brief The cache of the calling thread, or null once it has been destroyed.
+        */
+        [[nodiscard]] static auto instance() -> thread_node_cache *
+        {
+            // Trivially destructible, so still readable after the cache is gone
+            thread_local bool destroyed = false;
+
+            if (destroyed)
+                return nullptr;
+
+            thread_local thread_node_cache cache{&destroyed};
+            return &cache;
+        }
+
+        [[nodiscard]] auto allocate() -> void *
+        {
+            if (this->m_head == nullptr)
+            {
+                this->__M_refill();
+            }
+
+            auto link = this->m_head;
+
+            this->m_head  = link->m_next;
+            this->m_count = this->m_count - 1UL;
+
+            return link;
+        }
+
+        void deallocate(void *pointer) noexcept
+        {
+            if (this->m_count == cache_limit)
+            {
+                this->__M_flush(shared_type::batch_size);
+            }
+
+            auto link = ::new (pointer) Link{this->m_head};
+
+            this->m_head  = link;
+            this->m_count = this->m_count + 1UL;
+        }
+
+        ~thread_node_cache()
+        {
+            this->__M_flush(this->m_count);
+            *this->m_destroyed = true;
+        }
+
+    private:
+        explicit thread_node_cache(bool *destroyed) noexcept : m_destroyed{destroyed} {}
+
+        void __M_refill()
+        {
+            auto &shared = shared_type::instance();
+
+            std::scoped_lock lock{shared.m_mutex};
+
+            for (auto count = shared_type::batch_size; count; --count)
+            {
+                this->m_head  = ::new (shared.m_pool.allocate()) Link{this->m_head};
+                this->m_count = this->m_count + 1UL;
+            }
+        }
+
+        void __M_flush(std::size_t count) noexcept
+        {
+            auto &shared = shared_type::instance();
+
+            std::scoped_lock lock{shared.m_mutex};
+
+            for (; count && (this->m_head != nullptr); --count)
+            {
+                auto link = this->m_head;
+
+                this->m_head  = link->m_next;
+                this->m_count = this->m_count - 1UL;
+
+                shared.m_pool.deallocate(link);
+            }
+        }
+
+    private:
+        Link *m_head{nullptr};
+        std::size_t m_count{0UL};
+        bool *m_destroyed{nullptr}; // Set as the cache is destroyed
+    };
+}
+
+
+
+/**
+* @brief Stateless allocator serving single-object requests from a shared slab pool.
+* @details Node-based containers rebind it to their node type, so every allocation
+*          they make (one node at a time) is recycled through the pool. Requests for
+*          more than one object fall back to the global operator new.
+* @tparam Type The type of objects allocated.
+* @tparam ChunkBlocks The number of nodes allocated per slab chunk.
+* @tparam ThreadCache Whether a per-thread cache sits in front of the shared pool.
+*/
+template <class Type, std::size_t ChunkBlocks = 256UL, bool ThreadCache = true>
+struct pool_allocator
+{
+public:
+    using value_type      = Type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    template <class UType>
+    struct rebind
+    {
+        using other = pool_allocator<UType, ChunkBlocks, ThreadCache>;
+    };
+
+private:
+    using shared_type = details::shared_node_pool<sizeof(Type), alignof(Type), ChunkBlocks>;
+    using cache_type  = details::thread_node_cache<sizeof(Type), alignof(Type), ChunkBlocks>;
+
+public:
+    /**
+    * @brief Default constructor.
+    */
+    constexpr pool_allocator() noexcept = default;
+
+    /**
+    * @brief Converting constructor used for rebinding.
+    */
+    template <class UType>
+    constexpr pool_allocator(const pool_allocator<UType, ChunkBlocks, ThreadCache> &) noexcept
+    {
+    }
+
+public:
+    /**
+    * @brief Allocates storage for `count` objects.
+    * @param count The number of objects.
+    * @return Pointer to uninitialized storage.
+    */
+    [[nodiscard]] auto allocate(size_type count) -> Type *
+    {
+        if (count != 1UL)
+        {
+            return static_cast<Type *>(::operator new(count * sizeof(Type), std::align_val_t{alignof(Type)}));
+        }
+
+        if constexpr (ThreadCache)
+        {
+            if (auto cache = cache_type::instance())
+                return static_cast<Type *>(cache->allocate());
+        }
+
+        return static_cast<Type *>(shared_type::instance().allocate());
+    }
+
+    /**
+    * @brief Releases storage previously obtained from allocate().
+    * @param pointer The storage to release.
+    * @param count The number of objects it was allocated for.
+    */
+    void deallocate(Type *pointer, size_type count) noexcept
+    {
+        if (count != 1UL)
+        {
+            ::operator delete(pointer, std::align_val_t{alignof(Type)});
+            return;
+        }
+
+        if constexpr (ThreadCache)
+        {
+            if (auto cache = cache_type::instance())
+            {
+                cache->deallocate(pointer);
+                return;
+            }
+        }
+
+        shared_type::instance().deallocate(pointer);
+    }
+
+public:
+    /**
+    * @brief All pool allocators of the same geometry share one pool and compare equal.
+    */
+    template <class UType>
+    friend constexpr auto operator==(const pool_allocator &,
+                                     const pool_allocator<UType, ChunkBlocks, ThreadCache> &) noexcept -> bool
+    {
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,487 @@
+#ifndef __PERSISTENT_FORWARD_LIST_HXX__
+#define __PERSISTENT_FORWARD_LIST_HXX__
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "details.h"
+
+
+
+/**
+* @brief An immutable singly linked list whose versions share their common suffix.
+* @details Every modifier is const and returns a new version in O(1): push_front links one
+*          new node in front of the shared nodes, pop_front shares all but the first. Nodes
+*          are reference counted, so a version is a head pointer and copying it (taking a
+*          snapshot) is O(1) in time and memory; a node is freed with the last version that
+*          reaches it. The counts are atomic, so versions can be shared between threads.
+* @tparam Type The type of elements stored in the list; they are never modified.
+* @tparam Allocator The allocator used for the nodes, rebound to the node type.
+*/
+template <class Type, class Allocator = std::allocator<Type>>
+struct persistent_forward_list final
+{
+
+private:
+    // Forward declaration of the Node structure
+    struct Node;
+
+    // Forward declaration of the Iterator structure
+    struct Iterator;
+
+private:
+    // Type aliases for allocator and allocator traits
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+public:
+    // Type aliases for readability and standard conformance
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using reference       = const Type &;
+    using const_reference = const Type &;
+
+    using pointer       = const Type *;
+    using const_pointer = const Type *;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    // Elements are shared between versions, so both iterators are constant iterators
+    using iterator       = Iterator;
+    using const_iterator = Iterator;
+
+public:
+    // Constructors and Destructor
+
+    /**
+    * @brief Default constructor: the empty version.
+    */
+    persistent_forward_list() noexcept = default;
+
+    /**
+    * @brief Constructs the empty version using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit persistent_forward_list(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
+    /**
+    * @brief Constructs a version holding the elements of a range, in order.
+    * @param first The beginning of the range.
+    * @param last The end of the range.
+    * @param alloc The allocator used for all node allocations.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<Iterator>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
+            std::bool_constant<std::constructible_from<Type, std::iter_reference_t<Iterator>>>
+        >::value
+    persistent_forward_list(Iterator first, Sentinel last, const Allocator &alloc = Allocator())
+        : m_alloc{alloc}
+    {
+        // The nodes are private until construction ends, so they are linked in place
+        const Node **tail = std::addressof(this->m_head);
+
+        try {
+            for (; first != last; ++first)
+            {
+                auto node = this->__M_create_node(nullptr, *first);
+
+                *tail = node;
+                tail = std::addressof(node->m_next);
+
+                this->m_size = this->m_size + 1UL;
+            }
+        }
+        catch (...) {
+            this->__M_release(this->m_head);
+            throw;
+        }
+    }
+
+    /**
+    * @brief Constructs a version holding the elements of a range, in order.
+    */
+    template <typename range_t>
+        requires std::conjunction<
+            std::bool_constant<std::ranges::input_range<range_t>>,
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_reference_t<range_t>>>
+        >::value
+    persistent_forward_list(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
+        : persistent_forward_list(std::ranges::begin(range), std::ranges::end(range), alloc)
+    {
+    }
+
+    /**
+    * @brief Constructs a version holding the elements of an initializer list, in order.
+    */
+    persistent_forward_list(std::initializer_list<Type> init, const Allocator &alloc = Allocator())
+        : persistent_forward_list(init.begin(), init.end(), alloc)
+    {
+    }
+
+    /**
+    * @brief Copy constructor: shares every node of `other`, in O(1).
+    */
+    persistent_forward_list(const persistent_forward_list &other) noexcept
+        : m_head{__M_acquire(other.m_head)}, m_size{other.m_size}, m_alloc{other.m_alloc}
+    {
+    }
+
+    /**
+    * @brief Move constructor: takes over the nodes of `outer`, leaving it empty.
+    */
+    persistent_forward_list(persistent_forward_list &&outer) noexcept
+        : m_head{std::exchange(outer.m_head, nullptr)}, m_size{std::exchange(outer.m_size, 0UL)},
+          m_alloc{outer.m_alloc}
+    {
+    }
+
+    /**
+    * @brief Copy assignment: shares the nodes of `rhs`, releasing the current ones.
+    * @note The allocator is taken from `rhs`: nodes are freed by whichever version releases
+    *       them last, which must be able to deallocate them. Allocators that cannot be
+    *       assigned, such as std::pmr::polymorphic_allocator, must compare equal.
+    */
+    auto operator=(const persistent_forward_list &rhs) noexcept -> persistent_forward_list &
+    {
+        if (this != std::addressof(rhs))
+        {
+            auto head = __M_acquire(rhs.m_head);
+
+            this->__M_release(this->m_head);
+
+            this->m_head = head;
+            this->m_size = rhs.m_size;
+            this->__M_adopt_allocator(rhs.m_alloc);
+        }
+        return *this;
+    }
+
+    /**
+    * @brief Move assignment: takes over the nodes of `rhs`, releasing the current ones.
+    */
+    auto operator=(persistent_forward_list &&rhs) noexcept -> persistent_forward_list &
+    {
+        if (this != std::addressof(rhs))
+        {
+            this->__M_release(this->m_head);
+
+            this->m_head = std::exchange(rhs.m_head, nullptr);
+            this->m_size = std::exchange(rhs.m_size, 0UL);
+            this->__M_adopt_allocator(rhs.m_alloc);
+        }
+        return *this;
+    }
+
+    /**
+    * @brief Destructor. Frees the nodes no other version reaches.
+    */
+    ~persistent_forward_list() { this->__M_release(this->m_head); }
+
+public:
+    // New versions
+
+    /**
+    * @brief Returns this version with `data` in front, sharing every current node.
+    * @tparam UType The type of the element to be pushed.
+    * @param data The data of the element to be pushed.
+    */
+    template <class UType>
+    [[nodiscard]] auto push_front(UType &&data) const -> persistent_forward_list
+        requires std::constructible_from<Type, UType>
+    {
+        return this->emplace_front(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Returns this version with an element constructed in place in front.
+    * @tparam ARGS The types of arguments to construct the element.
+    * @param args The arguments to construct the element.
+    */
+    template <class... ARGS>
+    [[nodiscard]] auto emplace_front(ARGS &&...args) const -> persistent_forward_list
+        requires std::constructible_from<Type, ARGS...>
+    {
+        persistent_forward_list result(nullptr, 0UL, this->m_alloc);
+
+        result.m_head = result.__M_create_node(this->m_head, std::forward<ARGS>(args)...);
+        result.m_size = this->m_size + 1UL;
+
+        __M_acquire(this->m_head);
+
+        return result;
+    }
+
+    /**
+    * @brief Returns this version without its first element; the empty version stays empty.
+    */
+    [[nodiscard]] auto pop_front() const noexcept -> persistent_forward_list
+    {
+        if (this->m_head == nullptr)
+            return *this;
+
+        return persistent_forward_list(__M_acquire(this->m_head->m_next), this->m_size - 1UL, this->m_alloc);
+    }
+
+public:
+    // Element Access
+
+    /**
+    * @brief Returns the first element.
+    * @return std::optional<std::reference_wrapper<const Type>> The element, or std::nullopt
+    *         when empty. It stays valid as long as a version holding it exists.
+    */
+    [[nodiscard]] auto front() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (this->m_head == nullptr)
+            return std::nullopt;
+
+        return std::optional{std::cref(this->m_head->m_data)};
+    }
+
+public:
+    // Capacity
+
+    /**
+    * @brief Checks if the version is empty.
+    */
+    [[nodiscard]] auto empty() const noexcept -> bool { return (this->m_head == nullptr); }
+
+    /**
+    * @brief Returns the number of elements, in O(1).
+    */
+    [[nodiscard]] auto size() const noexcept -> size_type { return this->m_size; }
+
+    /**
+    * @brief Returns a copy of the allocator, rebound back to the value type.
+    */
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type { return allocator_type(this->m_alloc); }
+
+public:
+    // Iterator Support
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator { return const_iterator{this->m_head}; }
+    [[nodiscard]] auto end() const noexcept -> const_iterator { return const_iterator{}; }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator { return this->begin(); }
+    [[nodiscard]] auto cend() const noexcept -> const_iterator { return this->end(); }
+
+public:
+    // Comparison
+
+    /**
+    * @brief Whether both versions hold equal elements. Shared suffixes are not walked.
+    */
+    friend auto operator==(const persistent_forward_list &lhs, const persistent_forward_list &rhs) -> bool
+        requires std::equality_comparable<Type>
+    {
+        if (lhs.m_size != rhs.m_size)
+            return false;
+
+        for (auto left = lhs.m_head, right = rhs.m_head; left != right; left = left->m_next, right = right->m_next)
+        {
+            if (not (left->m_data == right->m_data))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+    * @brief Whether both versions are the same nodes, in O(1).
+    */
+    [[nodiscard]] auto shares(const persistent_forward_list &other) const noexcept -> bool
+    {
+        return (this->m_head == other.m_head);
+    }
+
+    friend void swap(persistent_forward_list &lhs, persistent_forward_list &rhs) noexcept
+    {
+        std::swap(lhs.m_head, rhs.m_head);
+        std::swap(lhs.m_size, rhs.m_size);
+
+        if constexpr (std::is_swappable_v<allocator_t>)
+        {
+            using std::swap;
+            swap(lhs.m_alloc, rhs.m_alloc);
+        }
+        else
+        {
+            assert(lhs.m_alloc == rhs.m_alloc);
+        }
+    }
+
+private:
+    // Adopts a head whose reference the caller already took
+    persistent_forward_list(const Node *head, size_type size, const allocator_t &alloc) noexcept
+        : m_head{head}, m_size{size}, m_alloc{alloc}
+    {
+    }
+
+    // Versions sharing nodes must agree on the allocator that frees them
+    void __M_adopt_allocator(const allocator_t &alloc) noexcept
+    {
+        if constexpr (std::is_copy_assignable_v<allocator_t>)
+            this->m_alloc = alloc;
+        else
+            assert(this->m_alloc == alloc);
+    }
+
+    /**
+    * @brief Takes one more reference to `node`, if any.
+    */
+    static auto __M_acquire(const Node *node) noexcept -> const Node *
+    {
+        if (node != nullptr)
+            node->m_refs.fetch_add(1UL, std::memory_order_relaxed);
+
+        return node;
+    }
+
+    /**
+    * @brief Drops a reference to `node`, freeing it and, in turn, the successors it owned
+    *        last: iterative, so releasing a long unshared chain does not recurse.
+    */
+    void __M_release(const Node *node) noexcept
+    {
+        while ((node != nullptr) && (node->m_refs.fetch_sub(1UL, std::memory_order_acq_rel) == 1UL))
+        {
+            auto next = node->m_next;
+
+            details::prefetch(next);
+
+            auto mutable_node = const_cast<Node *>(node);
+
+            traits::destroy(this->m_alloc, mutable_node);
+            traits::deallocate(this->m_alloc, mutable_node, 1UL);
+
+            node = next;
+        }
+    }
+
+    /**
+    * @brief Allocates a node holding one reference, linked in front of `next`.
+    * @note `next` is not acquired here: the caller transfers or takes that reference.
+    */
+    template <class... ARGS>
+    auto __M_create_node(const Node *next, ARGS &&...args) -> Node *
+    {
+        auto node = traits::allocate(this->m_alloc, 1UL);
+
+        try {
+            traits::construct(this->m_alloc, std::to_address(node), next, std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            traits::deallocate(this->m_alloc, node, 1UL);
+            throw;
+        }
+
+        return node;
+    }
+
+private:
+    // Member variables
+    const Node *m_head{nullptr}; // First node of this version, shared with other versions
+    size_type m_size{0UL};       // Number of elements
+    [[no_unique_address]] allocator_t m_alloc{};
+};
+
+
+
+/**
+* @brief A node of a persistent_forward_list: a reference count, a link and the element.
+* @tparam Type The type of data held by the node.
+* @tparam Allocator The allocator type of the owning list.
+*/
+template <class Type, class Allocator>
+struct persistent_forward_list<Type, Allocator>::Node final
+{
+    template <class... ARGS>
+    explicit Node(const Node *next, ARGS &&...args) : m_next{next}, m_data(std::forward<ARGS>(args)...)
+    {
+    }
+
+    mutable std::atomic<size_type> m_refs{1UL}; // Versions and nodes linking to this node
+    const Node *m_next{nullptr};                 // The rest of the list, owned through one reference
+    const Type m_data;                          // The element, immutable once linked
+};
+
+
+
+/**
+* @brief Forward iterator over a persistent_forward_list version.
+* @details Valid as long as a version reaching its node exists.
+*/
+template <class Type, class Allocator>
+struct persistent_forward_list<Type, Allocator>::Iterator final
+{
+public:
+    friend struct persistent_forward_list;
+
+public:
+    using value_type = Type;
+
+    using reference = const Type &;
+    using pointer   = const Type *;
+
+    using difference_type = std::ptrdiff_t;
+
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept  = std::forward_iterator_tag;
+
+public:
+    // Constructors
+
+    Iterator() noexcept = default;
+
+    explicit Iterator(const Node *node) noexcept : m_node{node} {}
+
+public:
+    // Operators
+
+    auto operator*() const noexcept -> reference { return this->m_node->m_data; }
+
+    auto operator->() const noexcept -> pointer { return std::addressof(this->m_node->m_data); }
+
+    auto operator++() noexcept -> Iterator &
+    {
+        this->m_node = this->m_node->m_next;
+
+        if (this->m_node != nullptr)
+            details::prefetch(this->m_node->m_next);
+
+        return *this;
+    }
+
+    auto operator++(int) noexcept -> Iterator
+    {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+    }
+
+    friend auto operator==(const Iterator &lhs, const Iterator &rhs) noexcept -> bool
+    {
+        return (lhs.m_node == rhs.m_node);
+    }
+
+private:
+    const Node *m_node{nullptr}; // The current node
+};
+
+#endif
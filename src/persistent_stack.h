@@ -0,0 +1,162 @@
+#ifndef __PERSISTENT_STACK_HXX__
+#define __PERSISTENT_STACK_HXX__
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "persistent_forward_list.h"
+
+
+
+/**
+* @brief An immutable stack whose versions share the elements below their top.
+* @details A view of persistent_forward_list with the top of the stack at its front: push
+*          and pop are const and return a new version in O(1), and copying a version (taking
+*          a snapshot) is O(1) in time and memory.
+* @tparam Type The type of elements stored in the stack; they are never modified.
+* @tparam Allocator The allocator used for the nodes, rebound to the node type.
+*/
+template <class Type, class Allocator = std::allocator<Type>>
+struct persistent_stack final
+{
+
+private:
+    // The nodes, top first
+    using list_t = persistent_forward_list<Type, Allocator>;
+
+public:
+    // Type aliases for readability and standard conformance
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using reference       = const Type &;
+    using const_reference = const Type &;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    // Iterates from the top down
+    using iterator       = typename list_t::iterator;
+    using const_iterator = typename list_t::const_iterator;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Default constructor: the empty version.
+    */
+    persistent_stack() noexcept = default;
+
+    /**
+    * @brief Constructs the empty version using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit persistent_stack(const Allocator &alloc) noexcept
+        : m_list{alloc}
+    {
+    }
+
+    /**
+    * @brief Constructs a version holding the elements of an initializer list, top first.
+    */
+    persistent_stack(std::initializer_list<Type> init, const Allocator &alloc = Allocator())
+        : m_list{init, alloc}
+    {
+    }
+
+public:
+    // New versions
+
+    /**
+    * @brief Returns this version with `data` on top, sharing every current element.
+    * @tparam UType The type of the element to be pushed.
+    * @param data The data of the element to be pushed.
+    */
+    template <class UType>
+    [[nodiscard]] auto push(UType &&data) const -> persistent_stack
+        requires std::constructible_from<Type, UType>
+    {
+        return persistent_stack(this->m_list.push_front(std::forward<UType>(data)));
+    }
+
+    /**
+    * @brief Returns this version with an element constructed in place on top.
+    * @tparam ARGS The types of arguments to construct the element.
+    * @param args The arguments to construct the element.
+    */
+    template <class... ARGS>
+    [[nodiscard]] auto emplace(ARGS &&...args) const -> persistent_stack
+        requires std::constructible_from<Type, ARGS...>
+    {
+        return persistent_stack(this->m_list.emplace_front(std::forward<ARGS>(args)...));
+    }
+
+    /**
+    * @brief Returns this version without its top element; the empty version stays empty.
+    */
+    [[nodiscard]] auto pop() const noexcept -> persistent_stack { return persistent_stack(this->m_list.pop_front()); }
+
+public:
+    // Element Access
+
+    /**
+    * @brief Returns the top element.
+    * @return std::optional<std::reference_wrapper<const Type>> The element, or std::nullopt
+    *         when empty. It stays valid as long as a version holding it exists.
+    */
+    [[nodiscard]] auto top() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        return this->m_list.front();
+    }
+
+public:
+    // Capacity
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return this->m_list.empty(); }
+
+    [[nodiscard]] auto size() const noexcept -> size_type { return this->m_list.size(); }
+
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type { return this->m_list.get_allocator(); }
+
+public:
+    // Iterator Support (top to bottom)
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator { return this->m_list.begin(); }
+    [[nodiscard]] auto end() const noexcept -> const_iterator { return this->m_list.end(); }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator { return this->m_list.cbegin(); }
+    [[nodiscard]] auto cend() const noexcept -> const_iterator { return this->m_list.cend(); }
+
+public:
+    // Comparison
+
+    friend auto operator==(const persistent_stack &lhs, const persistent_stack &rhs) -> bool
+        requires std::equality_comparable<Type>
+    {
+        return (lhs.m_list == rhs.m_list);
+    }
+
+    /**
+    * @brief Whether both versions are the same nodes, in O(1).
+    */
+    [[nodiscard]] auto shares(const persistent_stack &other) const noexcept -> bool
+    {
+        return this->m_list.shares(other.m_list);
+    }
+
+    friend void swap(persistent_stack &lhs, persistent_stack &rhs) noexcept { swap(lhs.m_list, rhs.m_list); }
+
+private:
+    explicit persistent_stack(list_t &&list) noexcept : m_list{std::move(list)} {}
+
+private:
+    // Member variables
+    list_t m_list{}; // Top of the stack first
+};
+
+#endif
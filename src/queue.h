@@ -3,14 +3,31 @@
 
 
 #include <cassert>
+#include <concepts>
+#include <functional>
+#include <memory>
 #include <ranges>
 #include <utility>
 
+#include "container_stats.h"
+#include "details.h"
+#include "small_buffer.h"
+
 /**
 * @brief A generic queue implemented as a doubly linked list.
+* @details The sentinel is embedded in the queue object, so an empty queue owns no node and
+*          constructing or moving one never allocates. With InlineCapacity > 0 the first nodes
+*          also live in a buffer inside the queue object and only the overflow goes to the
+*          allocator: a queue that never holds more than InlineCapacity elements never
+*          allocates. Moving such a queue moves its inline elements one by one, hence the
+*          nothrow-move requirement on Type.
 * @tparam Type The type of elements stored in the queue.
+* @tparam Allocator The allocator used for the nodes, rebound to the node type.
+* @tparam InlineCapacity The number of elements kept inside the queue object.
+* @tparam Stats Whether the queue counts its work for stats() (no_stats or operation_stats).
 */
-template <class Type>
+template <class Type, class Allocator = std::allocator<Type>, std::size_t InlineCapacity = 0UL, class Stats = no_stats>
+    requires((InlineCapacity == 0UL) || std::is_nothrow_move_constructible_v<Type>)
 struct queue final
 {
 
@@ -20,9 +37,32 @@ private:
     */
     struct Node;
 
+    // Links shared by the nodes and the sentinel embedded in the queue
+    struct Link
+    {
+        constexpr Link() noexcept = default;
+
+        // A link is an address in a ring: it is never copied
+        Link(const Link &) = delete;
+        auto operator=(const Link &) -> Link & = delete;
+
+        // Inserts `link` right before this one
+        constexpr void push_back(Link *link) noexcept
+        {
+            link->m_prev = this->m_prev;
+            link->m_next = this;
+            this->m_prev->m_next = link;
+            this->m_prev = link;
+        }
+
+        Link *m_prev{this}; // Pointer to the previous link
+        Link *m_next{this}; // Pointer to the next link
+    };
+
 public:
     // Public member type aliases
-    using value_type = Type;
+    using value_type     = Type;
+    using allocator_type = Allocator;
 
     using reference       = Type &;
     using const_reference = const Type &;
@@ -35,7 +75,7 @@ public:
 
 private:
     // Allocator and allocator traits
-    using allocator_t = std::allocator<Node>;
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
     using traits      = std::allocator_traits<allocator_t>;
 
 public:
@@ -43,12 +83,18 @@ public:
 
     /**
     * @brief Default constructor.
-    * Constructs an empty queue.
+    * Constructs an empty queue; nothing is allocated.
     */
-    constexpr queue()
-        requires std::default_initializable<Type>
+    constexpr queue() noexcept = default;
+
+    /**
+    * @brief Allocator-extended default constructor.
+    * Constructs an empty queue whose nodes are obtained from `alloc`; nothing is allocated.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr queue(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
     {
-        this->m_head = this->__M_create_node();
     }
 
     /**
@@ -56,32 +102,31 @@ public:
     * Constructs the queue with the contents of `other`.
     * @param outer The queue to be copied.
     */
-    constexpr queue(const queue &outer) noexcept(std::is_nothrow_copy_constructible<allocator_t>{})
-        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
+    constexpr queue(const queue &outer)
+        : queue(Allocator(traits::select_on_container_copy_construction(outer.m_alloc)))
     {
-        this->m_head = this->__M_clone(outer.m_head->m_next);
-        this->m_size = outer.m_size;
+        this->__M_assign(outer);
     }
 
     /**
     * @brief Move constructor.
-    * Constructs the queue by moving the contents of `other`.
+    * Constructs the queue by relinking the nodes of `other`; nothing is allocated.
     * @param outer The queue to be moved.
     */
     constexpr queue(queue &&outer) noexcept
         : m_alloc{std::move(outer.m_alloc)}
     {
-        this->m_head = std::exchange(outer.m_head, this->__M_create_node());
-        this->m_size = std::exchange(outer.m_size, 0UL);
+        this->__M_steal(outer);
     }
 
     /**
     * @brief Initializer list constructor.
     * Constructs the queue with elements from an initializer list.
     * @param list The initializer list containing elements.
+    * @param alloc The allocator used for all node allocations.
     */
-    constexpr queue(std::initializer_list<Type> list)
-        : queue{std::ranges::begin(list), std::ranges::end(list)}
+    constexpr queue(std::initializer_list<Type> list, const Allocator &alloc = Allocator())
+        : queue(std::ranges::begin(list), std::ranges::end(list), alloc)
     {
     }
 
@@ -91,14 +136,15 @@ public:
     * @tparam range_t Type of the range.
     * @param from_range_t Tag type for disambiguation.
     * @param range The range to construct the queue from.
+    * @param alloc The allocator used for all node allocations.
     */
     template <typename range_t>
         requires std::conjunction<
             std::bool_constant<std::ranges::range<range_t>>,
-            std::bool_constant<std::constructible_from<Type, std::ranges::range_value_t<range_t>>
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_value_t<range_t>>>
         >::value
-    constexpr queue(std::from_range_t, range_t &&range)
-        : queue{std::ranges::begin(range), std::ranges::end(range)}
+    constexpr queue(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
+        : queue(std::ranges::begin(range), std::ranges::end(range), alloc)
     {
     }
 
@@ -109,18 +155,18 @@ public:
     * @tparam Sentinel Type of the sentinel.
     * @param first The beginning of the range.
     * @param last The end of the range.
+    * @param alloc The allocator used for all node allocations.
     */
     template <typename Iterator, typename Sentinel>
         requires std::conjunction<
             std::bool_constant<std::input_iterator<Iterator>>,
             std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
-            std::bool_constant<std::constructible_from<Type, std::iter_value_t<Iterator>>
+            std::bool_constant<std::constructible_from<Type, std::iter_value_t<Iterator>>>
         >::value
-    constexpr queue(Iterator first, Sentinel last)
-        : queue{}
+    constexpr queue(Iterator first, Sentinel last, const Allocator &alloc = Allocator())
+        : queue(alloc)
     {
         this->__M_range_init(first, last);
-        this->m_size = std::ranges::distance(first, last);
     }
 
     // Assignment operators
@@ -176,9 +222,7 @@ public:
     constexpr void push_back(UType &&data)
         requires std::constructible_from<Type, UType>
     {
-        assert(this->m_head != nullptr);
-
-        this->m_head->push_back(this->__M_create_node(std::forward<UType>(data)));
+        this->m_head.push_back(this->__M_create_node(std::forward<UType>(data)));
         this->m_size = this->m_size + 1UL;
     }
 
@@ -191,12 +235,33 @@ public:
     constexpr void emplace_back(ARGS &&...args)
         requires std::constructible_from<Type, ARGS...>
     {
-        assert(this->m_head != nullptr);
-
-        this->m_head->push_back(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
+        this->m_head.push_back(this->__M_create_node(std::in_place, std::forward<ARGS>(args)...));
         this->m_size = this->m_size + 1UL;
     }
 
+    /**
+    * @brief Adds every element of a range to the back of the queue, in order.
+    * @details When the allocator is monotonic and the size of the range is known, the
+    *          nodes of the whole batch come from a single allocation.
+    * @tparam range_t Type of the range.
+    * @param range The range of elements to be added.
+    */
+    template <typename range_t>
+        requires std::conjunction<
+            std::bool_constant<std::ranges::input_range<range_t>>,
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_reference_t<range_t>>>
+        >::value
+    constexpr void append_range(range_t &&range)
+    {
+        auto batch = this->__M_reserve_batch(details::size_hint(range));
+
+        for (auto &&data : range)
+        {
+            this->m_head.push_back(this->__M_create_batched(batch, std::forward<decltype(data)>(data)));
+            this->m_size = this->m_size + 1UL;
+        }
+    }
+
 
 public:
     // Modifiers
@@ -209,22 +274,75 @@ public:
     {
         assert(not this->empty());
 
-        auto target = this->m_head->m_next;
+        auto target = static_cast<Node *>(this->m_head.m_next);
 
         target->m_prev->m_next = target->m_next;
         target->m_next->m_prev = target->m_prev;
 
-        traits::destroy(this->m_alloc, std::to_address(target));
-        traits::deallocate(this->m_alloc, std::to_address(target), 1UL);
+        this->__M_destroy_node(target);
 
         this->m_size = this->m_size - 1UL;
     }
 
+    /**
+    * @brief Removes up to `count` elements from the front, moving each one to `out`.
+    * @details The removed nodes are unlinked as one run once every element is moved out,
+    *          then destroyed in a single pass; with a monotonic allocator and a trivially
+    *          destructible Type the run is simply dropped.
+    * @tparam _iterator Type of the output iterator.
+    * @param out The destination of the removed elements.
+    * @param count The maximum number of elements to remove.
+    * @return _iterator The output iterator past the last element written.
+    */
+    template <typename _iterator> requires std::output_iterator<_iterator, Type &&>
+    constexpr auto pop_n(_iterator out, size_type count) -> _iterator
+    {
+        count = (count < this->m_size) ? count : this->m_size;
+
+        if (count == 0UL)
+            return out;
+
+        auto first = this->m_head.m_next;
+        auto last = first;
+
+        for (auto remaining = count;; last = last->m_next)
+        {
+            *out = std::move(__M_value(last));
+            ++out;
+
+            if (--remaining == 0UL)
+                break;
+        }
+
+        this->m_head.m_next = last->m_next;
+        last->m_next->m_prev = this->__M_sentinel();
+        last->m_next = nullptr;
+
+        this->m_size = this->m_size - count;
+
+        if constexpr (not (details::trivially_releasable<allocator_t, Type> && (InlineCapacity == 0UL)))
+        {
+            while (first != nullptr)
+                this->__M_destroy_node(static_cast<Node *>(std::exchange(first, first->m_next)));
+        }
+        return out;
+    }
+
     /**
     * @brief Removes all elements from the queue.
+    * @details With a monotonic allocator and a trivially destructible Type the nodes
+    *          are dropped in O(1); their memory is reclaimed when the arena is released.
+    *          Inline nodes are always walked, as their slots must be given back.
     */
     constexpr void clear()
     {
+        if constexpr (details::trivially_releasable<allocator_t, Type> && (InlineCapacity == 0UL))
+        {
+            this->m_head.m_prev = this->m_head.m_next = this->__M_sentinel();
+            this->m_size = 0UL;
+            return;
+        }
+
         while (not this->empty())
             this->pop_front();
     }
@@ -241,19 +359,19 @@ public:
         if (this->empty()) {
             return std::nullopt;
         }
-        return std::optional{std::ref(this->m_head->m_next->m_data)};
+        return std::optional{std::ref(__M_value(this->m_head.m_next))};
     }
 
     /**
     * @brief Returns a const optional reference to the first element.
     * @return Const optional reference to the first element.
     */
-    constexpr auto front() const noexcept -> std::optional<const std::reference_wrapper<Type>>
+    constexpr auto front() const noexcept -> std::optional<std::reference_wrapper<const Type>>
     {
         if (this->empty()) {
             return std::nullopt;
         }
-        return std::optional{std::cref(this->m_head->m_next->m_data)};
+        return std::optional{std::cref(__M_value(this->m_head.m_next))};
     }
 
     /**
@@ -265,19 +383,34 @@ public:
         if (this->empty()) {
             return std::nullopt;
         }
-        return std::optional{std::ref(this->m_head->m_prev->m_data)};
+        return std::optional{std::ref(__M_value(this->m_head.m_prev))};
     }
 
     /**
     * @brief Returns a const optional reference to the last element.
     * @return Const optional reference to the last element.
     */
-    constexpr auto back() const noexcept -> std::optional<const std::reference_wrapper<Type>>
+    constexpr auto back() const noexcept -> std::optional<std::reference_wrapper<const Type>>
     {
         if (this->empty()) {
             return std::nullopt;
         }
-        return std::optional{std::cref(this->m_head->m_prev->m_data)};
+        return std::optional{std::cref(__M_value(this->m_head.m_prev))};
+    }
+
+    /**
+    * @brief Visits every element, from the front to the back.
+    * @param visitor The callable invoked with each element.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    constexpr void for_each(Visitor visitor) const
+    {
+        for (auto current = this->m_head.m_next; current != std::addressof(this->m_head); current = current->m_next)
+        {
+            details::prefetch(current->m_next);
+            std::invoke(visitor, std::as_const(__M_value(current)));
+        }
     }
 
 public:
@@ -289,8 +422,7 @@ public:
      */
     [[nodiscard]] constexpr auto empty() const noexcept -> bool
     {
-        return ((this->m_head != nullptr) || ((this->m_head == this->m_head->m_prev) && 
-                                              (this->m_head == this->m_head->m_next)));
+        return (this->m_head.m_next == std::addressof(this->m_head));
     }
 
     /**
@@ -299,6 +431,36 @@ public:
     */
     [[nodiscard]] constexpr auto size() const noexcept -> size_type { return this->m_size; }
 
+    /**
+    * @brief Returns a copy of the allocator associated with the queue.
+    * @return The allocator, rebound back to the value type.
+    */
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+    /**
+    * @brief Returns the work counted since construction or the last reset_stats().
+    * @details Allocations count only the nodes that overflow the inline buffer; elements
+    *          assignment writes over existing nodes count as reuses.
+    * @return The counters, with the bytes of the heap nodes currently held.
+    */
+    [[nodiscard]] auto stats() const noexcept -> container_stats
+        requires details::stats_recorder<Stats>::enabled
+    {
+        return this->m_stats.snapshot(this->__M_heap_nodes() * sizeof(Node));
+    }
+
+    /**
+    * @brief Zeroes the counters behind stats().
+    */
+    void reset_stats() noexcept
+        requires details::stats_recorder<Stats>::enabled
+    {
+        this->m_stats.reset();
+    }
+
 public:
     // Friend Function
 
@@ -315,8 +477,11 @@ public:
             std::swap(lhs.m_alloc, rhs.m_alloc);
         }
 
-        std::swap(lhs.m_head, rhs.m_head);
-        std::swap(lhs.m_size, rhs.m_size);
+        queue temp{allocator_type(lhs.m_alloc)};
+
+        temp.__M_steal(lhs);
+        lhs.__M_steal(rhs);
+        rhs.__M_steal(temp);
     }
 
 public:
@@ -328,9 +493,6 @@ public:
     constexpr ~queue()
     {
         this->clear();
-        traits::destroy(this->m_alloc, std::to_address(this->m_head));
-        traits::deallocate(this->m_alloc, std::to_address(this->m_head), 1UL);
-        this->m_head = nullptr;
     }
 
 private:
@@ -345,41 +507,167 @@ private:
     template <class... ARGS>
     constexpr Node *__M_create_node(ARGS &&...args)
     {
-        auto node = traits::allocate(this->m_alloc, 1UL);
+        auto node = this->__M_allocate_node();
 
         try {
             traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
         }
         catch (...) {
-            traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
+            this->__M_deallocate_node(node);
             throw;
         }
         return node;
     }
 
     /**
-    * @brief Clones the nodes from the provided source.
-    * @param source Pointer to the source node.
-    * @return Pointer to the cloned nodes.
+    * @brief Reserves one block for the nodes of a batch.
+    * @details Only monotonic allocators qualify, and only without inline storage, which
+    *          the batch would otherwise bypass.
+    * @param count The number of nodes in the batch, 0 when unknown.
+    * @return The reserved batch, empty when nodes are to be allocated one by one.
     */
-    constexpr Node *__M_clone(Node *source)
+    constexpr auto __M_reserve_batch(size_type count) -> details::node_batch<Node>
     {
-        if (source == nullptr)
+        if constexpr (details::monotonic_allocator<allocator_t> && (InlineCapacity == 0UL))
         {
-            this->clear();
-            return source;
+            if (count > 1UL)
+            {
+                auto block = std::to_address(traits::allocate(this->m_alloc, count));
+                this->m_stats.allocated();
+                return {block, block + count};
+            }
+        }
+        return {};
+    }
+
+    /**
+    * @brief Creates a node in the next slot of a batch, or on its own once the batch is used up.
+    * @details A slot whose construction throws stays unused; the arena reclaims it.
+    * @param batch The batch to take the node storage from.
+    * @param args Arguments to construct the node.
+    * @return Pointer to the created node.
+    */
+    template <class... ARGS>
+    constexpr Node *__M_create_batched(details::node_batch<Node> &batch, ARGS &&...args)
+    {
+        if (auto node = batch.take())
+        {
+            traits::construct(this->m_alloc, node, std::forward<ARGS>(args)...);
+            return node;
+        }
+        return this->__M_create_node(std::forward<ARGS>(args)...);
+    }
+
+    /**
+    * @brief Obtains storage for one node, from the inline buffer while it lasts.
+    * @return Pointer to uninitialized node storage.
+    */
+    constexpr Node *__M_allocate_node()
+    {
+        if (auto node = this->m_buffer.allocate()) {
+            return node;
         }
+        auto node = std::to_address(traits::allocate(this->m_alloc, 1UL));
+        this->m_stats.allocated();
+        return node;
+    }
+
+    /**
+    * @brief Gives node storage back to where it came from.
+    * @param node The storage of an already destroyed node.
+    */
+    constexpr void __M_deallocate_node(Node *node) noexcept
+    {
+        if (this->m_buffer.owns(node)) {
+            this->m_buffer.deallocate(node);
+        }
+        else {
+            traits::deallocate(this->m_alloc, node, 1UL);
+            this->m_stats.deallocated();
+        }
+    }
+
+    /**
+    * @brief Destroys a node and releases its storage.
+    * @param node The node to be destroyed.
+    */
+    constexpr void __M_destroy_node(Node *node) noexcept
+    {
+        traits::destroy(this->m_alloc, std::to_address(node));
+        this->__M_deallocate_node(node);
+    }
+
+    /**
+    * @brief The number of elements held outside the inline buffer.
+    */
+    [[nodiscard]] constexpr auto __M_heap_nodes() const noexcept -> size_type
+    {
+        return this->m_size - this->m_buffer.in_use();
+    }
 
-        auto cursor = this->__M_create_node();
+    /**
+    * @brief Returns the embedded sentinel.
+    */
+    [[nodiscard]] constexpr auto __M_sentinel() const noexcept -> Link *
+    {
+        return const_cast<Link *>(std::addressof(this->m_head));
+    }
 
-        auto end = source->m_prev;
+    /**
+    * @brief Returns the element stored in the node behind a (non-sentinel) link.
+    */
+    [[nodiscard]] static constexpr auto __M_value(Link *link) noexcept -> Type &
+    {
+        return static_cast<Node *>(link)->m_data;
+    }
+
+    /**
+    * @brief Takes over the elements of `outer`, which is left empty.
+    * @details This queue must be empty. Heap nodes are relinked to this sentinel as they
+    *          are; nodes in the inline buffer of `outer` are moved into the (then empty)
+    *          buffer of this queue, which always has room for them.
+    * @param outer The queue to take the elements from.
+    */
+    constexpr void __M_steal(queue &outer) noexcept
+    {
+        this->m_size = std::exchange(outer.m_size, 0UL);
+
+        if (outer.empty())
+            return;
 
-        while (source != end)
+        this->m_head.m_next = std::exchange(outer.m_head.m_next, outer.__M_sentinel());
+        this->m_head.m_prev = std::exchange(outer.m_head.m_prev, outer.__M_sentinel());
+        this->m_head.m_next->m_prev = this->__M_sentinel();
+        this->m_head.m_prev->m_next = this->__M_sentinel();
+
+        if constexpr (InlineCapacity != 0UL)
         {
-            cursor->push_back(this->__M_create_node(source->m_data));
-            source = source->m_next;
+            auto link = this->m_head.m_next;
+
+            for (auto remaining = outer.m_buffer.in_use(); remaining != 0UL;)
+            {
+                auto node = static_cast<Node *>(link);
+
+                link = link->m_next;
+
+                if (outer.m_buffer.owns(node))
+                {
+                    auto slot = this->m_buffer.allocate();
+
+                    traits::construct(this->m_alloc, slot, std::move(node->m_data));
+
+                    slot->m_prev = node->m_prev;
+                    slot->m_next = node->m_next;
+                    slot->m_prev->m_next = slot;
+                    slot->m_next->m_prev = slot;
+
+                    traits::destroy(outer.m_alloc, node);
+                    outer.m_buffer.deallocate(node);
+
+                    remaining = remaining - 1UL;
+                }
+            }
         }
-        return cursor;
     }
 
     /**
@@ -398,75 +686,45 @@ private:
     {
         for (; first != last; first = std::ranges::next(first))
         {
-            this->m_head->push_back(this->__M_create_node(*first));
+            this->m_head.push_back(this->__M_create_node(*first));
+            this->m_size = this->m_size + 1UL;
         }
     }
 
     /**
-    * @brief Assigns the nodes from the provided source to the queue.
-    * @param source Pointer to the source node.
-    * @param size Size of the source.
+    * @brief Assigns the elements of `outer` to the queue.
+    * @details Existing nodes are reused for the common prefix; the rest is appended or trimmed.
+    * @param outer The queue to be copied.
     */
-    constexpr void __M_assign(Node *source, size_type size)
+    constexpr void __M_assign(const queue &outer)
     {
-        if (source == nullptr)
-        {
-            this->clear();
-            return;
-        }
-
-        if (this->empty())
-        {
-            if (this->m_head != nullptr)
-            {
-                traits::destroy(this->m_alloc, std::to_address(this->m_head));
-                traits::deallocate(this->m_alloc, std::to_address(this->m_head), 1UL);
-                this->m_head = nullptr;
-            }
-
-            this->m_head = this->__M_clone(source->m_next);
-            return;
-        }
-
-        auto cursor = this->m_head->m_next;
+        auto source = outer.m_head.m_next;
+        auto cursor = this->m_head.m_next;
 
-        for (auto count = std::min(this->m_size, size); count; --count)
+        for (; (cursor != this->__M_sentinel()) && (source != outer.__M_sentinel()); source = source->m_next)
         {
-            cursor->m_data = source->m_data;
-
+            __M_value(cursor) = __M_value(source);
+            this->m_stats.reused();
             cursor = cursor->m_next;
-            source = source->m_next;
         }
 
-        if (this->m_size == size)
-            return;
-
-        if (this->m_size < size)
+        for (; source != outer.__M_sentinel(); source = source->m_next)
         {
-            for (auto count = size - this->m_size; count; --count)
-            {
-                cursor->push_back(this->__M_create_node(source->m_data));
-
-                source = source->m_next;
-            }
+            details::prefetch(source->m_next);
 
-            return;
+            this->m_head.push_back(this->__M_create_node(std::as_const(__M_value(source))));
+            this->m_size = this->m_size + 1UL;
         }
 
-        if (this->m_size > size)
+        while (cursor != this->__M_sentinel())
         {
-            for (auto count = this->m_size - size; count; --count)
-            {
-                auto target = cursor;
-
-                cursor->m_prev->m_next = cursor->m_next;
-                cursor->m_next->m_prev = cursor->m_prev;
+            auto target = static_cast<Node *>(std::exchange(cursor, cursor->m_next));
 
-                cursor = cursor->m_next;
+            target->m_prev->m_next = target->m_next;
+            target->m_next->m_prev = target->m_prev;
 
-                traits::destroy(this->m_alloc, std::to_address(target));
-                traits::deallocate(this->m_alloc, std::to_address(target), 1UL);
-            }
+            this->__M_destroy_node(target);
+            this->m_size = this->m_size - 1UL;
         }
     }
 
@@ -485,8 +743,7 @@ private:
             this->m_alloc = outer.m_alloc;
         }
 
-        this->__M_assign(outer.m_head, outer.m_size);
-        this->m_size = outer.m_size;
+        this->__M_assign(outer);
     }
 
     /**
@@ -498,8 +755,7 @@ private:
     constexpr void __M_copy_assign(const queue &outer, std::false_type)
     {
         this->clear();
-        this->__M_assign(outer.m_head, outer.m_size);
-        this->m_size = outer.m_size;
+        this->__M_assign(outer);
     }
 
     /**
@@ -512,9 +768,11 @@ private:
     {
         this->clear();
 
-        this->m_alloc = std::move(outer.m_alloc);
-        this->m_head = std::exchange(outer.m_head, this->__M_create_node());
-        this->m_size = std::exchange(outer.m_size, 0UL);
+        // Equal but non-propagating allocators (std::pmr) are kept: they cannot be assigned
+        if constexpr (typename traits::propagate_on_container_move_assignment{})
+            this->m_alloc = std::move(outer.m_alloc);
+
+        this->__M_steal(outer);
     }
 
     /**
@@ -529,16 +787,26 @@ private:
             this->__M_move_assign(outer, std::true_type{});
         }
         else {
-            this->m_head = std::exchange(outer.m_head, this->__M_create_node());
-            this->m_size = std::exchange(outer.m_size, 0UL);
+            this->clear();
+
+            for (auto link = outer.m_head.m_next; link != outer.__M_sentinel(); link = link->m_next)
+                this->push_back(std::move(__M_value(link)));
+
+            outer.clear();
         }
     }
 
 private:
     // Member variables
-    Node*     m_head{nullptr};
+    Link      m_head{};        // Embedded sentinel: m_next is the front, m_prev the back
     size_type m_size{0UL};
     [[no_unique_address]] allocator_t m_alloc{};
+
+    // Inline storage for the first InlineCapacity nodes
+    [[no_unique_address]] details::small_buffer<Node, InlineCapacity> m_buffer{};
+
+    // Counters behind stats()
+    [[no_unique_address]] details::stats_recorder<Stats> m_stats{};
 };
 
 // Deduction guides
@@ -548,7 +816,7 @@ private:
 * @tparam range_t Type of the range.
 */
 template <class range_t>
-queue(std::from_range_t, range_t &&) -> queue<std::ranges::range_value_t<range_t>>;
+queue(details::from_range_t, range_t &&) -> queue<std::ranges::range_value_t<range_t>>;
 
 /**
 * @brief Deduction guide for queue from iterators and sentinels.
@@ -565,9 +833,11 @@ queue(Iterator, Sentinel) -> queue<std::iter_value_t<Iterator>>;
 * of type Type and pointers to the previous and next nodes in the queue.
 * @brief Represents an individual node in a queue.
 * @tparam Type The type of data held by the node.
+* @tparam Allocator The allocator type of the owning queue.
 */
-template <class Type>
-struct queue<Type>::Node final
+template <class Type, class Allocator, std::size_t InlineCapacity, class Stats>
+    requires((InlineCapacity == 0UL) || std::is_nothrow_move_constructible_v<Type>)
+struct queue<Type, Allocator, InlineCapacity, Stats>::Node final : Link
 {
 
 public:
@@ -618,21 +888,9 @@ public:
     {
     }
 
-private:
-    // Helper function to add a node after the current node.
-    constexpr void push_back(Node *node) noexcept
-    {
-        node->m_prev = this->m_prev;
-        node->m_next = this;
-        this->m_prev->m_next = node;
-        this->m_prev = node;
-    }
-
 private:
     // Member variables
-    Type m_data{};      // Data stored in the node
-    Node *m_prev{this}; // Pointer to the previous node
-    Node *m_next{this}; // Pointer to the next node
+    Type m_data{}; // Data stored in the node
 };
 
 #endif
\ No newline at end of file
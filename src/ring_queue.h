@@ -0,0 +1,676 @@
+#ifndef __RING_QUEUE_HXX__
+#define __RING_QUEUE_HXX__
+
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+#include "details.h"
+
+/**
+* @brief A queue stored in a contiguous power-of-two ring buffer.
+* @details Offers the same interface as queue without one allocation per element:
+*          elements live in a single buffer addressed by `(head + index) & (capacity - 1)`,
+*          so draining the queue reads memory sequentially. A growable ring doubles its
+*          buffer when full, moving the elements across; a fixed ring never reallocates.
+* @tparam Type The type of elements stored in the queue.
+* @tparam Allocator The allocator used for the element buffer.
+* @tparam Capacity The fixed capacity, a power of two, or 0 for a growable ring.
+*/
+template <class Type, class Allocator = std::allocator<Type>, std::size_t Capacity = 0UL>
+    requires ((Capacity == 0UL) || std::has_single_bit(Capacity))
+struct ring_queue final
+{
+
+public:
+    // Public member type aliases
+    using value_type     = Type;
+    using allocator_type = Allocator;
+
+    using reference       = Type &;
+    using const_reference = const Type &;
+
+    using pointer       = Type *;
+    using const_pointer = const Type *;
+
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    // Allocator and allocator traits
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Type>;
+    using traits      = std::allocator_traits<allocator_t>;
+
+    // Whether the ring never reallocates
+    static constexpr bool is_fixed = (Capacity != 0UL);
+
+    // Capacity of the first buffer of a growable ring
+    static constexpr size_type initial_capacity = 8UL;
+
+public:
+    // Constructors
+
+    /**
+    * @brief Default constructor.
+    * Constructs an empty queue. No memory is allocated until the first push.
+    */
+    constexpr ring_queue() noexcept = default;
+
+    /**
+    * @brief Allocator-extended default constructor.
+    * @param alloc The allocator used for the element buffer.
+    */
+    explicit constexpr ring_queue(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
+    /**
+    * @brief Copy constructor.
+    * Constructs the queue with the contents of `other`, in a buffer just large enough.
+    * @param outer The queue to be copied.
+    */
+    constexpr ring_queue(const ring_queue &outer)
+        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
+    {
+        this->__M_copy_from(outer);
+    }
+
+    /**
+    * @brief Move constructor.
+    * Constructs the queue by taking over the buffer of `other`.
+    * @param outer The queue to be moved.
+    */
+    constexpr ring_queue(ring_queue &&outer) noexcept
+        : m_alloc{std::move(outer.m_alloc)}
+    {
+        this->m_buffer   = std::exchange(outer.m_buffer, nullptr);
+        this->m_capacity = std::exchange(outer.m_capacity, 0UL);
+        this->m_head     = std::exchange(outer.m_head, 0UL);
+        this->m_size     = std::exchange(outer.m_size, 0UL);
+    }
+
+    /**
+    * @brief Initializer list constructor.
+    * @param list The initializer list containing elements.
+    * @param alloc The allocator used for the element buffer.
+    */
+    constexpr ring_queue(std::initializer_list<Type> list, const Allocator &alloc = Allocator())
+        : ring_queue(std::ranges::begin(list), std::ranges::end(list), alloc)
+    {
+    }
+
+    /**
+    * @brief Range constructor.
+    * @tparam range_t Type of the range.
+    * @param from_range_t Tag type for disambiguation.
+    * @param range The range to construct the queue from.
+    * @param alloc The allocator used for the element buffer.
+    */
+    template <typename range_t>
+        requires std::conjunction<
+            std::bool_constant<std::ranges::range<range_t>>,
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_reference_t<range_t>>>
+        >::value
+    constexpr ring_queue(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
+        : ring_queue(std::ranges::begin(range), std::ranges::end(range), alloc)
+    {
+    }
+
+    /**
+    * @brief Iterator range constructor.
+    * @tparam Iterator Type of the iterator.
+    * @tparam Sentinel Type of the sentinel.
+    * @param first The beginning of the range.
+    * @param last The end of the range.
+    * @param alloc The allocator used for the element buffer.
+    */
+    template <typename Iterator, typename Sentinel>
+        requires std::conjunction<
+            std::bool_constant<std::input_iterator<Iterator>>,
+            std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
+            std::bool_constant<std::constructible_from<Type, std::iter_reference_t<Iterator>>>
+        >::value
+    constexpr ring_queue(Iterator first, Sentinel last, const Allocator &alloc = Allocator())
+        : ring_queue(alloc)
+    {
+        if constexpr (std::sized_sentinel_for<Sentinel, Iterator>)
+        {
+            this->reserve(static_cast<size_type>(last - first));
+        }
+
+        try {
+            for (; first != last; first = std::ranges::next(first))
+            {
+                this->emplace_back(*first);
+            }
+        }
+        catch (...) {
+            this->__M_release();
+            throw;
+        }
+    }
+
+    // Assignment operators
+
+    /**
+    * @brief Copy assignment operator.
+    * @param rhs The queue to be copied.
+    * @return Reference to the assigned queue.
+    */
+    constexpr ring_queue &operator=(const ring_queue &rhs)
+    {
+        if (this == std::addressof(rhs)) {
+            return *this;
+        }
+
+        this->__M_release();
+
+        if constexpr (typename traits::propagate_on_container_copy_assignment{}) {
+            this->m_alloc = rhs.m_alloc;
+        }
+
+        this->__M_copy_from(rhs);
+        return *this;
+    }
+
+    /**
+    * @brief Move assignment operator.
+    * The buffer is taken over when the allocators allow it, its elements are moved otherwise.
+    * @param rhs The queue to be moved.
+    * @return Reference to the moved queue.
+    */
+    constexpr ring_queue &operator=(ring_queue &&rhs)
+                noexcept(std::disjunction<typename traits::propagate_on_container_move_assignment,
+                                            typename traits::is_always_equal>{})
+    {
+        if (this == std::addressof(rhs)) {
+            return *this;
+        }
+
+        this->__M_release();
+
+        if constexpr (typename traits::propagate_on_container_move_assignment{}) {
+            this->m_alloc = std::move(rhs.m_alloc);
+        }
+        else if constexpr (not typename traits::is_always_equal{}) {
+
+            if (this->m_alloc != rhs.m_alloc) {
+                this->reserve(rhs.m_size);
+
+                for (; not rhs.empty(); rhs.pop_front()) {
+                    this->emplace_back(std::move(rhs.__M_at(0UL)));
+                }
+                return *this;
+            }
+        }
+
+        this->m_buffer   = std::exchange(rhs.m_buffer, nullptr);
+        this->m_capacity = std::exchange(rhs.m_capacity, 0UL);
+        this->m_head     = std::exchange(rhs.m_head, 0UL);
+        this->m_size     = std::exchange(rhs.m_size, 0UL);
+
+        return *this;
+    }
+
+public:
+    // Modifiers
+
+    /**
+    * @brief Adds an element to the back of the queue.
+    * @note Pushing into a full fixed-capacity queue results in undefined behavior;
+    *       use try_push_back() when the queue may be full.
+    * @tparam UType Type of the element to be added.
+    * @param data The element to be added.
+    */
+    template <class UType>
+    constexpr void push_back(UType &&data)
+        requires std::constructible_from<Type, UType>
+    {
+        this->emplace_back(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Constructs an element in-place at the back of the queue.
+    * @details A full growable ring doubles its capacity. The new element is constructed
+    *          before the old ones are moved, so arguments referring into the queue stay valid.
+    * @tparam ARGS Types of the arguments to construct the element.
+    * @param args Arguments to construct the element.
+    */
+    template <class... ARGS>
+    constexpr void emplace_back(ARGS &&...args)
+        requires std::constructible_from<Type, ARGS...>
+    {
+        if (this->m_buffer == nullptr)
+        {
+            this->m_buffer   = traits::allocate(this->m_alloc, this->__M_next_capacity());
+            this->m_capacity = this->__M_next_capacity();
+        }
+
+        if (this->m_size == this->m_capacity)
+        {
+            if constexpr (is_fixed)
+            {
+                assert(this->m_size != Capacity);
+            }
+            else
+            {
+                this->__M_grow(std::forward<ARGS>(args)...);
+                return;
+            }
+        }
+
+        traits::construct(this->m_alloc, std::to_address(this->__M_slot(this->m_size)),
+                          std::forward<ARGS>(args)...);
+        this->m_size = this->m_size + 1UL;
+    }
+
+    /**
+    * @brief Constructs an element at the back of the queue unless it is full.
+    * @details A growable queue is never full, so this only fails for a fixed capacity.
+    * @tparam ARGS Types of the arguments to construct the element.
+    * @param args Arguments to construct the element.
+    * @return True if the element was added.
+    */
+    template <class... ARGS>
+    constexpr auto try_emplace_back(ARGS &&...args) -> bool
+        requires std::constructible_from<Type, ARGS...>
+    {
+        if constexpr (is_fixed)
+        {
+            if (this->m_size == Capacity)
+            {
+                return false;
+            }
+        }
+
+        this->emplace_back(std::forward<ARGS>(args)...);
+        return true;
+    }
+
+    /**
+    * @brief Adds an element to the back of the queue unless it is full.
+    * @tparam UType Type of the element to be added.
+    * @param data The element to be added.
+    * @return True if the element was added.
+    */
+    template <class UType>
+    constexpr auto try_push_back(UType &&data) -> bool
+        requires std::constructible_from<Type, UType>
+    {
+        return this->try_emplace_back(std::forward<UType>(data));
+    }
+
+    /**
+    * @brief Removes the first element from the queue.
+    * @note Calling this method on an empty queue results in undefined behavior.
+    */
+    constexpr void pop_front()
+    {
+        assert(not this->empty());
+
+        traits::destroy(this->m_alloc, std::to_address(this->__M_slot(0UL)));
+
+        this->m_head = (this->m_head + 1UL) & (this->m_capacity - 1UL);
+        this->m_size = this->m_size - 1UL;
+    }
+
+    /**
+    * @brief Removes all elements from the queue, keeping the buffer.
+    */
+    constexpr void clear() noexcept
+    {
+        if constexpr (not std::is_trivially_destructible_v<Type>)
+        {
+            for (size_type index = 0UL; index != this->m_size; ++index)
+            {
+                traits::destroy(this->m_alloc, std::to_address(this->__M_slot(index)));
+            }
+        }
+
+        this->m_head = 0UL;
+        this->m_size = 0UL;
+    }
+
+    /**
+    * @brief Ensures room for at least `count` elements without reallocation.
+    * @details A fixed ring always reserves exactly Capacity elements.
+    * @param count The requested number of elements.
+    */
+    constexpr void reserve(size_type count)
+    {
+        if constexpr (is_fixed)
+        {
+            assert(count <= Capacity);
+
+            if (this->m_buffer == nullptr)
+            {
+                this->m_buffer   = traits::allocate(this->m_alloc, Capacity);
+                this->m_capacity = Capacity;
+            }
+        }
+        else
+        {
+            if (count > this->m_capacity)
+            {
+                this->__M_relocate(std::bit_ceil(count));
+            }
+        }
+    }
+
+public:
+    // Element Access
+
+    /**
+    * @brief Returns an optional reference to the first element.
+    * @return Optional reference to the first element.
+    */
+    constexpr auto front() noexcept -> std::optional<std::reference_wrapper<Type>>
+    {
+        if (this->empty()) {
+            return std::nullopt;
+        }
+        return std::optional{std::ref(this->__M_at(0UL))};
+    }
+
+    /**
+    * @brief Returns a const optional reference to the first element.
+    * @return Const optional reference to the first element.
+    */
+    constexpr auto front() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (this->empty()) {
+            return std::nullopt;
+        }
+        return std::optional{std::cref(this->__M_at(0UL))};
+    }
+
+    /**
+    * @brief Returns an optional reference to the last element.
+    * @return Optional reference to the last element.
+    */
+    constexpr auto back() noexcept -> std::optional<std::reference_wrapper<Type>>
+    {
+        if (this->empty()) {
+            return std::nullopt;
+        }
+        return std::optional{std::ref(this->__M_at(this->m_size - 1UL))};
+    }
+
+    /**
+    * @brief Returns a const optional reference to the last element.
+    * @return Const optional reference to the last element.
+    */
+    constexpr auto back() const noexcept -> std::optional<std::reference_wrapper<const Type>>
+    {
+        if (this->empty()) {
+            return std::nullopt;
+        }
+        return std::optional{std::cref(this->__M_at(this->m_size - 1UL))};
+    }
+
+    /**
+    * @brief Visits every element, from the front to the back.
+    * @param visitor The callable invoked with each element.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    constexpr void for_each(Visitor visitor) const
+    {
+        for (size_type index = 0UL; index != this->m_size; ++index)
+            std::invoke(visitor, std::as_const(*this->__M_slot(index)));
+    }
+
+public:
+    // Capacity
+
+    /**
+     * @brief Checks if the queue is empty.
+     * @return True if the queue is empty, otherwise false.
+     */
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return (this->m_size == 0UL); }
+
+    /**
+     * @brief Checks if the queue cannot take another element without reallocating.
+     * @return True if the queue is full, otherwise false.
+     */
+    [[nodiscard]] constexpr auto full() const noexcept -> bool { return (this->m_size == this->capacity()); }
+
+    /**
+    * @brief Returns the size of the queue.
+    * @return Size of the queue.
+    */
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type { return this->m_size; }
+
+    /**
+    * @brief Returns the number of elements the current buffer can hold.
+    * @return Capacity of the queue; Capacity itself for a fixed ring.
+    */
+    [[nodiscard]] constexpr auto capacity() const noexcept -> size_type
+    {
+        if constexpr (is_fixed) {
+            return Capacity;
+        }
+        else {
+            return this->m_capacity;
+        }
+    }
+
+    /**
+    * @brief Returns a copy of the allocator associated with the queue.
+    * @return The allocator, rebound back to the value type.
+    */
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+public:
+    // Friend Function
+
+    /**
+    * @brief Swaps the contents of two queues.
+    * @param lhs The first queue.
+    * @param rhs The second queue.
+    */
+    friend constexpr void swap(ring_queue &lhs, ring_queue &rhs)
+                noexcept(std::disjunction<typename traits::propagate_on_container_swap,
+                                            typename traits::is_always_equal>{})
+    {
+        if constexpr (typename traits::propagate_on_container_swap{}) {
+            std::swap(lhs.m_alloc, rhs.m_alloc);
+        }
+
+        std::swap(lhs.m_buffer, rhs.m_buffer);
+        std::swap(lhs.m_capacity, rhs.m_capacity);
+        std::swap(lhs.m_head, rhs.m_head);
+        std::swap(lhs.m_size, rhs.m_size);
+    }
+
+public:
+    // Destructor
+
+    /**
+    * @brief Destroys the queue, deallocating the buffer.
+    */
+    constexpr ~ring_queue() { this->__M_release(); }
+
+private:
+    // Helper functions
+
+    /**
+    * @brief Returns the slot holding the element `index` positions after the front.
+    */
+    [[nodiscard]] constexpr auto __M_slot(size_type index) const noexcept -> Type *
+    {
+        return this->m_buffer + ((this->m_head + index) & (this->m_capacity - 1UL));
+    }
+
+    [[nodiscard]] constexpr auto __M_at(size_type index) noexcept -> Type & { return *this->__M_slot(index); }
+
+    [[nodiscard]] constexpr auto __M_at(size_type index) const noexcept -> const Type & { return *this->__M_slot(index); }
+
+    /**
+    * @brief Returns the capacity of the next buffer to be allocated.
+    */
+    [[nodiscard]] constexpr auto __M_next_capacity() const noexcept -> size_type
+    {
+        if constexpr (is_fixed) {
+            return Capacity;
+        }
+        else {
+            return (this->m_capacity == 0UL) ? initial_capacity : (this->m_capacity * 2UL);
+        }
+    }
+
+    /**
+    * @brief Moves the elements, in order, into a new buffer of `capacity` slots.
+    * @details Elements are moved when that cannot throw and copied otherwise, so a
+    *          throwing copy leaves the queue untouched.
+    */
+    constexpr void __M_relocate(size_type capacity)
+    {
+        auto buffer = traits::allocate(this->m_alloc, capacity);
+        size_type count = 0UL;
+
+        try {
+            for (; count != this->m_size; ++count)
+            {
+                traits::construct(this->m_alloc, std::to_address(buffer + count),
+                                  std::move_if_noexcept(this->__M_at(count)));
+            }
+        }
+        catch (...) {
+            for (; count; --count) {
+                traits::destroy(this->m_alloc, std::to_address(buffer + count - 1UL));
+            }
+            traits::deallocate(this->m_alloc, buffer, capacity);
+            throw;
+        }
+
+        auto size = this->m_size;
+
+        this->__M_release();
+
+        this->m_buffer   = buffer;
+        this->m_capacity = capacity;
+        this->m_size     = size;
+    }
+
+    /**
+    * @brief Doubles the capacity of a full ring and appends a new element.
+    * @tparam ARGS Types of the arguments to construct the element.
+    * @param args Arguments to construct the new element.
+    */
+    template <class... ARGS>
+    constexpr void __M_grow(ARGS &&...args)
+    {
+        auto capacity = this->__M_next_capacity();
+        auto buffer = traits::allocate(this->m_alloc, capacity);
+
+        try {
+            traits::construct(this->m_alloc, std::to_address(buffer + this->m_size), std::forward<ARGS>(args)...);
+        }
+        catch (...) {
+            traits::deallocate(this->m_alloc, buffer, capacity);
+            throw;
+        }
+
+        size_type count = 0UL;
+
+        try {
+            for (; count != this->m_size; ++count)
+            {
+                traits::construct(this->m_alloc, std::to_address(buffer + count),
+                                  std::move_if_noexcept(this->__M_at(count)));
+            }
+        }
+        catch (...) {
+            for (; count; --count) {
+                traits::destroy(this->m_alloc, std::to_address(buffer + count - 1UL));
+            }
+            traits::destroy(this->m_alloc, std::to_address(buffer + this->m_size));
+            traits::deallocate(this->m_alloc, buffer, capacity);
+            throw;
+        }
+
+        auto size = this->m_size;
+
+        this->__M_release();
+
+        this->m_buffer   = buffer;
+        this->m_capacity = capacity;
+        this->m_size     = size + 1UL;
+    }
+
+    /**
+    * @brief Copies the elements of `outer` into a buffer just large enough for them.
+    */
+    constexpr void __M_copy_from(const ring_queue &outer)
+    {
+        if (outer.empty())
+            return;
+
+        this->reserve(outer.m_size);
+
+        try {
+            for (size_type index = 0UL; index != outer.m_size; ++index)
+            {
+                this->emplace_back(outer.__M_at(index));
+            }
+        }
+        catch (...) {
+            this->__M_release();
+            throw;
+        }
+    }
+
+    /**
+    * @brief Destroys every element and gives the buffer back to the allocator.
+    */
+    constexpr void __M_release() noexcept
+    {
+        this->clear();
+
+        if (this->m_buffer != nullptr)
+        {
+            traits::deallocate(this->m_alloc, this->m_buffer, this->m_capacity);
+        }
+
+        this->m_buffer   = nullptr;
+        this->m_capacity = 0UL;
+    }
+
+private:
+    // Member variables
+    Type*     m_buffer{nullptr};  // Element storage of m_capacity slots
+    size_type m_capacity{0UL};    // Number of slots, a power of two
+    size_type m_head{0UL};        // Slot of the front element
+    size_type m_size{0UL};        // Number of elements
+    [[no_unique_address]] allocator_t m_alloc{};
+};
+
+// Deduction guides
+
+/**
+* @brief Deduction guide for ring_queue from range.
+* @tparam range_t Type of the range.
+*/
+template <class range_t>
+ring_queue(details::from_range_t, range_t &&) -> ring_queue<std::ranges::range_value_t<range_t>>;
+
+/**
+* @brief Deduction guide for ring_queue from iterators and sentinels.
+* @tparam Iterator Type of the iterator.
+* @tparam Sentinel Type of the sentinel.
+*/
+template <class Iterator, class Sentinel>
+ring_queue(Iterator, Sentinel) -> ring_queue<std::iter_value_t<Iterator>>;
+
+#endif
@@ -0,0 +1,637 @@
+#ifndef __SERIALIZATION_HXX__
+#define __SERIALIZATION_HXX__
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "b_tree.h"
+#include "bs_tree.h"
+#include "chunked_stack.h"
+#include "details.h"
+#include "forward_list.h"
+#include "list.h"
+#include "persistent_forward_list.h"
+#include "persistent_stack.h"
+#include "queue.h"
+#include "ring_queue.h"
+#include "stack.h"
+
+
+
+// Binary archives of the containers
+//
+// An archive is a 64-byte header followed by the raw elements:
+//
+//   offset  size  field
+//        0     4  magic "DSAR"
+//        4     2  format version (archive_version)
+//        6     2  layout (archive_layout)
+//        8     4  sizeof(Type)
+//       12     4  alignof(Type)
+//       16     8  element count
+//       24    40  reserved, zero
+//
+// Every field, and every arithmetic element, is little-endian. Sequences are stored in
+// iteration order (stacks from the top down); binary_search_tree is stored in level order
+// (the Eytzinger layout of its sorted elements), which binary_search_tree_view searches in
+// place. The elements start 64 bytes in, so a mapped archive keeps them cache-line aligned.
+
+/**
+* @brief How the elements of an archive are laid out.
+*/
+enum class archive_layout : std::uint16_t
+{
+    sequence    = 1, // In iteration order
+    level_order = 2  // A complete binary search tree, root first, children of i at 2i+1 and 2i+2
+};
+
+// Namespace containing helpers shared by every container
+namespace details
+{
+    inline constexpr std::array<std::byte, 4UL> archive_magic{std::byte{'D'}, std::byte{'S'}, std::byte{'A'},
+                                                              std::byte{'R'}};
+
+    inline constexpr std::uint16_t archive_version = 1U;
+
+    inline constexpr std::size_t archive_header_size = 64UL;
+
+    /**
+    * @brief Concept satisfied by element types archived as raw bytes.
+    * @details Non-arithmetic types are copied as they are laid out in memory, which is
+    *          little-endian only on little-endian hosts.
+    * @tparam Type The element type to be checked.
+    */
+    template <class Type>
+    concept archive_element = std::is_trivially_copyable_v<Type> &&
+                              ((std::endian::native == std::endian::little) || std::is_arithmetic_v<Type>);
+
+    /**
+    * @brief The decoded header of an archive.
+    */
+    struct archive_header final
+    {
+        archive_layout m_layout{archive_layout::sequence};
+        std::uint32_t m_element_size{0U};
+        std::uint32_t m_element_align{0U};
+        std::uint64_t m_count{0UL};
+    };
+
+    template <std::unsigned_integral Word>
+    constexpr void store_little(std::byte *out, Word value) noexcept
+    {
+        for (std::size_t index = 0UL; index != sizeof(Word); ++index)
+            out[index] = static_cast<std::byte>((value >> (8UL * index)) & 0xFFU);
+    }
+
+    template <std::unsigned_integral Word>
+    [[nodiscard]] constexpr auto load_little(const std::byte *in) noexcept -> Word
+    {
+        Word value{0U};
+
+        for (std::size_t index = 0UL; index != sizeof(Word); ++index)
+            value = static_cast<Word>(value | (static_cast<Word>(in[index]) << (8UL * index)));
+
+        return value;
+    }
+
+    template <class Type>
+    [[nodiscard]] constexpr auto encode_header(archive_layout layout, std::uint64_t count) noexcept
+        -> std::array<std::byte, archive_header_size>
+    {
+        std::array<std::byte, archive_header_size> bytes{};
+
+        std::ranges::copy(archive_magic, bytes.begin());
+
+        store_little(bytes.data() + 4UL, archive_version);
+        store_little(bytes.data() + 6UL, static_cast<std::uint16_t>(layout));
+        store_little(bytes.data() + 8UL, static_cast<std::uint32_t>(sizeof(Type)));
+        store_little(bytes.data() + 12UL, static_cast<std::uint32_t>(alignof(Type)));
+        store_little(bytes.data() + 16UL, count);
+
+        return bytes;
+    }
+
+    /**
+    * @brief Decodes a header written for `Type`.
+    * @return std::optional<archive_header> The header, or std::nullopt if the bytes are not
+    *         an archive of this format version holding elements of Type's size.
+    */
+    template <class Type>
+    [[nodiscard]] constexpr auto decode_header(std::span<const std::byte, archive_header_size> bytes) noexcept
+        -> std::optional<archive_header>
+    {
+        if (not std::ranges::equal(bytes.first(4UL), archive_magic))
+            return std::nullopt;
+
+        if (load_little<std::uint16_t>(bytes.data() + 4UL) != archive_version)
+            return std::nullopt;
+
+        archive_header header{};
+
+        header.m_layout = static_cast<archive_layout>(load_little<std::uint16_t>(bytes.data() + 6UL));
+        header.m_element_size = load_little<std::uint32_t>(bytes.data() + 8UL);
+        header.m_element_align = load_little<std::uint32_t>(bytes.data() + 12UL);
+        header.m_count = load_little<std::uint64_t>(bytes.data() + 16UL);
+
+        if ((header.m_element_size != sizeof(Type)) || (header.m_element_align != alignof(Type)))
+            return std::nullopt;
+
+        return header;
+    }
+
+    // Reverses the bytes of an arithmetic element on big-endian hosts
+    template <class Type>
+    constexpr void to_little(Type &value) noexcept
+    {
+        if constexpr ((std::endian::native != std::endian::little) && (sizeof(Type) > 1UL))
+        {
+            auto bytes = std::bit_cast<std::array<std::byte, sizeof(Type)>>(value);
+
+            std::ranges::reverse(bytes);
+
+            value = std::bit_cast<Type>(bytes);
+        }
+    }
+
+    /**
+    * @brief Writes elements through a staging buffer, so the stream sees few large writes.
+    */
+    template <class Type>
+    struct archive_writer final
+    {
+    public:
+        explicit archive_writer(std::ostream &os) : m_os{os} { this->m_buffer.reserve(archive_chunk); }
+
+        void put(const Type &value)
+        {
+            this->m_buffer.push_back(value);
+            to_little(this->m_buffer.back());
+
+            if (this->m_buffer.size() == archive_chunk)
+                this->flush();
+        }
+
+        void flush()
+        {
+            this->m_os.write(reinterpret_cast<const char *>(this->m_buffer.data()),
+                             static_cast<std::streamsize>(this->m_buffer.size() * sizeof(Type)));
+            this->m_buffer.clear();
+        }
+
+    private:
+        // Elements per write
+        static constexpr std::size_t archive_chunk = (64UL * 1024UL + sizeof(Type) - 1UL) / sizeof(Type);
+
+        std::ostream &m_os;
+        std::vector<Type> m_buffer{};
+    };
+
+    /**
+    * @brief Uninitialized, suitably aligned storage for the elements of an archive.
+    * @details Reading the bytes of a trivially copyable type into it creates the elements.
+    */
+    template <class Type>
+    struct archive_buffer final
+    {
+    public:
+        explicit archive_buffer(std::size_t count) : m_data{std::allocator<Type>{}.allocate(count)}, m_count{count} {}
+
+        archive_buffer(archive_buffer &&outer) noexcept
+            : m_data{std::exchange(outer.m_data, nullptr)}, m_count{std::exchange(outer.m_count, 0UL)}
+        {
+        }
+
+        archive_buffer &operator=(archive_buffer &&) = delete;
+
+        ~archive_buffer()
+        {
+            if (this->m_data != nullptr)
+                std::allocator<Type>{}.deallocate(this->m_data, this->m_count);
+        }
+
+        [[nodiscard]] auto bytes() noexcept -> char * { return reinterpret_cast<char *>(this->m_data); }
+
+        [[nodiscard]] auto elements() const noexcept -> std::span<const Type> { return {this->m_data, this->m_count}; }
+
+        // Converts the elements from little-endian, in place
+        void from_little() noexcept
+        {
+            if constexpr ((std::endian::native != std::endian::little) && (sizeof(Type) > 1UL))
+            {
+                for (std::size_t index = 0UL; index != this->m_count; ++index)
+                    to_little(this->m_data[index]);
+            }
+        }
+
+    private:
+        Type *m_data;
+        std::size_t m_count;
+    };
+
+    /**
+    * @brief Reads the header and the elements of an archive of the expected layout.
+    * @details When the stream is seekable, the element count is checked against the bytes
+    *          it has left before anything is allocated.
+    */
+    template <class Type>
+    [[nodiscard]] auto read_archive(std::istream &is, archive_layout layout) -> std::optional<archive_buffer<Type>>
+    {
+        std::array<std::byte, archive_header_size> bytes{};
+
+        if (not is.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+            return std::nullopt;
+
+        auto header = decode_header<Type>(bytes);
+
+        if (not header.has_value() || (header->m_layout != layout))
+            return std::nullopt;
+
+        if (header->m_count > (std::numeric_limits<std::size_t>::max() / sizeof(Type)))
+            return std::nullopt;
+
+        const auto payload = static_cast<std::size_t>(header->m_count) * sizeof(Type);
+
+        if (auto here = is.tellg(); here != std::streampos(-1))
+        {
+            is.seekg(0, std::ios::end);
+
+            auto available = static_cast<std::size_t>(is.tellg() - here);
+
+            is.seekg(here);
+
+            if (available < payload)
+                return std::nullopt;
+        }
+
+        std::optional<archive_buffer<Type>> buffer{std::in_place, static_cast<std::size_t>(header->m_count)};
+
+        if (not is.read(buffer->bytes(), static_cast<std::streamsize>(payload)))
+            return std::nullopt;
+
+        buffer->from_little();
+
+        return buffer;
+    }
+
+    /**
+    * @brief The first position, in sorted order, of a level-order layout of `count` elements.
+    * @details Positions are 1-based (the root is 1, the children of i are 2i and 2i+1);
+    *          0 is past the end.
+    */
+    [[nodiscard]] constexpr auto level_order_first(std::size_t count) noexcept -> std::size_t
+    {
+        if (count == 0UL)
+            return 0UL;
+
+        std::size_t position = 1UL;
+
+        while ((2UL * position) <= count)
+            position = 2UL * position;
+
+        return position;
+    }
+
+    /**
+    * @brief The position following `position` in sorted order: the leftmost node of its
+    *        right subtree, or the first ancestor it is left of.
+    */
+    [[nodiscard]] constexpr auto level_order_next(std::size_t position, std::size_t count) noexcept -> std::size_t
+    {
+        if ((2UL * position + 1UL) <= count)
+        {
+            position = 2UL * position + 1UL;
+
+            while ((2UL * position) <= count)
+                position = 2UL * position;
+
+            return position;
+        }
+
+        while ((position & 1UL) != 0UL)
+            position = position >> 1U;
+
+        return position >> 1U;
+    }
+
+    /**
+    * @brief Iterates a level-order layout in sorted order, by position arithmetic.
+    */
+    template <class Type>
+    struct level_order_iterator final
+    {
+    public:
+        using value_type = Type;
+
+        using reference = const Type &;
+        using pointer   = const Type *;
+
+        using difference_type = std::ptrdiff_t;
+
+        using iterator_category = std::forward_iterator_tag;
+        using iterator_concept  = std::forward_iterator_tag;
+
+    public:
+        constexpr level_order_iterator() noexcept = default;
+
+        constexpr level_order_iterator(std::span<const Type> levels, std::size_t position) noexcept
+            : m_levels{levels}, m_position{position}
+        {
+        }
+
+    public:
+        constexpr auto operator*() const noexcept -> reference { return this->m_levels[this->m_position - 1UL]; }
+
+        constexpr auto operator->() const noexcept -> pointer { return std::addressof(**this); }
+
+        constexpr auto operator++() noexcept -> level_order_iterator &
+        {
+            this->m_position = level_order_next(this->m_position, this->m_levels.size());
+            return *this;
+        }
+
+        constexpr auto operator++(int) noexcept -> level_order_iterator
+        {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        friend constexpr auto operator==(const level_order_iterator &lhs, const level_order_iterator &rhs) noexcept
+            -> bool
+        {
+            return (lhs.m_position == rhs.m_position);
+        }
+
+    private:
+        std::span<const Type> m_levels{}; // The elements, root first
+        std::size_t m_position{0UL};      // 1-based position of the current element, 0 past the end
+    };
+
+    // Stacks are archived from the top down and rebuilt by pushing from the bottom up
+    template <class Container>
+    inline constexpr bool is_lifo_container = false;
+
+    template <class Type, class Allocator, std::size_t InlineCapacity, class Stats>
+    inline constexpr bool is_lifo_container<stack<Type, Allocator, InlineCapacity, Stats>> = true;
+
+    template <class Type, class Allocator, std::size_t ChunkSize>
+    inline constexpr bool is_lifo_container<chunked_stack<Type, Allocator, ChunkSize>> = true;
+
+    template <class Container>
+    inline constexpr bool is_search_tree = false;
+
+    template <class Type, class Allocator, class Balance, class Compare, class Augment, class Stats>
+    inline constexpr bool is_search_tree<binary_search_tree<Type, Allocator, Balance, Compare, Augment, Stats>> = true;
+
+    template <class Container>
+    inline constexpr bool is_persistent_stack = false;
+
+    template <class Type, class Allocator>
+    inline constexpr bool is_persistent_stack<persistent_stack<Type, Allocator>> = true;
+
+    /**
+    * @brief Visits the elements of a sequence in archive order: its own for_each where it
+    *        has one (the containers without iterators), its iterators otherwise.
+    */
+    template <class Container, class Visitor>
+    void for_each_element(const Container &container, Visitor &&visitor)
+    {
+        if constexpr (requires { container.for_each(visitor); })
+        {
+            container.for_each(visitor);
+        }
+        else
+        {
+            for (const auto &element : container)
+                visitor(element);
+        }
+    }
+}
+
+
+/**
+* @brief Concept satisfied by the containers that binary archives support.
+* @tparam Container The container type to be checked.
+*/
+template <class Container>
+concept archivable = details::archive_element<typename Container::value_type> && requires {
+    typename Container::allocator_type;
+};
+
+
+/**
+* @brief Writes `container` to `os` as a binary archive.
+* @details Sequences are written while they are walked, through a 64KiB staging buffer. A
+*          binary_search_tree is first laid out in level order, which needs one copy of
+*          its elements in memory.
+* @param container The container to be written.
+* @param os The binary output stream.
+* @return bool Whether every byte was written.
+*/
+template <class Container>
+    requires archivable<Container>
+auto serialize(const Container &container, std::ostream &os) -> bool
+{
+    using value_type = typename Container::value_type;
+
+    constexpr auto layout = details::is_search_tree<Container> ? archive_layout::level_order : archive_layout::sequence;
+
+    const auto header = details::encode_header<value_type>(layout, container.size());
+
+    os.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    if constexpr (details::is_search_tree<Container>)
+    {
+        // Each element goes to its level-order slot as the in-order walk reaches it
+        const auto count = container.size();
+
+        details::archive_buffer<value_type> levels{count};
+
+        auto slots = const_cast<value_type *>(levels.elements().data());
+        auto position = details::level_order_first(count);
+
+        for_each_inorder(container, [&](const value_type &value) {
+            std::memcpy(static_cast<void *>(slots + (position - 1UL)), std::addressof(value), sizeof(value_type));
+            details::to_little(slots[position - 1UL]);
+
+            position = details::level_order_next(position, count);
+        });
+
+        os.write(levels.bytes(), static_cast<std::streamsize>(count * sizeof(value_type)));
+    }
+    else
+    {
+        details::archive_writer<value_type> writer{os};
+
+        details::for_each_element(container, [&](const value_type &value) { writer.put(value); });
+
+        writer.flush();
+    }
+
+    return static_cast<bool>(os);
+}
+
+
+/**
+* @brief Reads a container written by serialize().
+* @details The elements are read in one pass into a temporary buffer, then handed to the
+*          container's range constructor: a binary_search_tree is rebuilt balanced in O(n)
+*          through its sorted_range constructor, without comparisons.
+* @tparam Container The type of the container to be read.
+* @param is The binary input stream, positioned at the archive header.
+* @param alloc The allocator of the new container.
+* @return std::optional<Container> The container, or std::nullopt if the stream does not
+*         hold a complete archive of this format version, layout and element type.
+*/
+template <class Container>
+    requires archivable<Container>
+auto deserialize(std::istream &is, const typename Container::allocator_type &alloc = {}) -> std::optional<Container>
+{
+    using value_type = typename Container::value_type;
+
+    constexpr auto layout = details::is_search_tree<Container> ? archive_layout::level_order : archive_layout::sequence;
+
+    auto buffer = details::read_archive<value_type>(is, layout);
+
+    if (not buffer.has_value())
+        return std::nullopt;
+
+    const auto elements = buffer->elements();
+
+    if constexpr (details::is_search_tree<Container>)
+    {
+        details::level_order_iterator<value_type> first{elements, details::level_order_first(elements.size())};
+        details::level_order_iterator<value_type> last{elements, 0UL};
+
+        return std::optional<Container>{std::in_place, sorted_range, first, last, alloc};
+    }
+    else if constexpr (details::is_persistent_stack<Container>)
+    {
+        Container result{alloc};
+
+        for (auto position = elements.rbegin(); position != elements.rend(); ++position)
+            result = result.push(*position);
+
+        return std::optional<Container>{std::move(result)};
+    }
+    else if constexpr (details::is_lifo_container<Container>)
+    {
+        return std::optional<Container>{std::in_place, details::from_range, elements | std::views::reverse, alloc};
+    }
+    else
+    {
+        return std::optional<Container>{std::in_place, details::from_range, elements, alloc};
+    }
+}
+
+
+#if __has_include(<sys/mman.h>)
+
+/**
+* @brief A read-only memory mapping of a whole file.
+* @details Pages are loaded on first access, so opening a large archive costs no I/O;
+*          binary_search_tree_view then searches it in place.
+*/
+struct mapped_file final
+{
+public:
+    /**
+    * @brief Maps the file at `path`.
+    * @return std::optional<mapped_file> The mapping, or std::nullopt if the file cannot be
+    *         opened or mapped.
+    */
+    [[nodiscard]] static auto open(const char *path) noexcept -> std::optional<mapped_file>
+    {
+        const int descriptor = ::open(path, O_RDONLY | O_CLOEXEC);
+
+        if (descriptor < 0)
+            return std::nullopt;
+
+        struct stat status{};
+
+        std::optional<mapped_file> result{};
+
+        if ((::fstat(descriptor, &status) == 0) && (status.st_size > 0))
+        {
+            const auto length = static_cast<std::size_t>(status.st_size);
+
+            if (auto address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0); address != MAP_FAILED)
+                result = mapped_file{address, length};
+        }
+
+        ::close(descriptor);
+
+        return result;
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    mapped_file(mapped_file &&outer) noexcept
+        : m_address{std::exchange(outer.m_address, nullptr)}, m_length{std::exchange(outer.m_length, 0UL)}
+    {
+    }
+
+    mapped_file &operator=(mapped_file &&rhs) noexcept
+    {
+        if (this != std::addressof(rhs))
+        {
+            this->__M_unmap();
+
+            this->m_address = std::exchange(rhs.m_address, nullptr);
+            this->m_length = std::exchange(rhs.m_length, 0UL);
+        }
+        return *this;
+    }
+
+    ~mapped_file() { this->__M_unmap(); }
+
+public:
+    /**
+    * @brief The bytes of the file.
+    */
+    [[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte>
+    {
+        return {static_cast<const std::byte *>(this->m_address), this->m_length};
+    }
+
+private:
+    mapped_file(void *address, std::size_t length) noexcept : m_address{address}, m_length{length} {}
+
+    void __M_unmap() noexcept
+    {
+        if (this->m_address != nullptr)
+            ::munmap(this->m_address, this->m_length);
+    }
+
+private:
+    void *m_address{nullptr};
+    std::size_t m_length{0UL};
+};
+
+#endif
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef __SMALL_BUFFER_HXX__
+#define __SMALL_BUFFER_HXX__
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+
+
+// Namespace containing helpers shared by every container
+namespace details
+{
+    /**
+    * @brief Inline storage for the first few nodes of a node-based container.
+    * @details Embedded in the container object, it hands out up to Capacity node slots
+    *          before the container falls back to its allocator, so small containers keep
+    *          their nodes next to their own fields and never reach the heap. Freed slots
+    *          are recycled through an intrusive free list, like the blocks of node_pool.
+    *          The buffer only provides raw storage; the container constructs and destroys.
+    * @tparam Node The node type of the container.
+    * @tparam Capacity The number of node slots kept inline.
+    */
+    template <class Node, std::size_t Capacity>
+    struct small_buffer final
+    {
+    public:
+        using size_type = std::size_t;
+
+    public:
+        /**
+        * @brief Default constructor. Every slot is free.
+        */
+        constexpr small_buffer() noexcept {}
+
+        // The slots hold nodes linked by address: they cannot follow a copy or a move
+        small_buffer(const small_buffer &) = delete;
+        small_buffer &operator=(const small_buffer &) = delete;
+
+    public:
+        /**
+        * @brief Hands out one free slot, preferring recycled slots over untouched ones.
+        * @return Node* Uninitialized storage for a node, or nullptr when every slot is in use.
+        */
+        [[nodiscard]] auto allocate() noexcept -> Node *
+        {
+            Slot *slot = nullptr;
+
+            if (this->m_free != nullptr)
+            {
+                slot = this->m_free;
+                this->m_free = slot->m_next;
+            }
+            else if (this->m_bump != Capacity)
+            {
+                slot = this->m_slots + this->m_bump++;
+            }
+            else
+            {
+                return nullptr;
+            }
+
+            this->m_used = this->m_used + 1UL;
+
+            return reinterpret_cast<Node *>(slot->m_storage);
+        }
+
+        /**
+        * @brief Returns a slot handed out by allocate(); the node must already be destroyed.
+        * @param node The storage to be recycled.
+        */
+        void deallocate(Node *node) noexcept
+        {
+            auto slot = reinterpret_cast<Slot *>(node);
+
+            slot->m_next = this->m_free;
+            this->m_free = slot;
+
+            this->m_used = this->m_used - 1UL;
+        }
+
+        /**
+        * @brief Whether `node` lives in this buffer (rather than on the heap).
+        */
+        [[nodiscard]] auto owns(const Node *node) const noexcept -> bool
+        {
+            const void *address = node;
+
+            return std::greater_equal<const void *>{}(address, this->m_slots) &&
+                   std::less<const void *>{}(address, this->m_slots + Capacity);
+        }
+
+        /**
+        * @brief The number of slots currently handed out.
+        */
+        [[nodiscard]] constexpr auto in_use() const noexcept -> size_type { return this->m_used; }
+
+        /**
+        * @brief Marks every slot free at once, for containers dropping their nodes in O(1).
+        */
+        constexpr void reset() noexcept
+        {
+            this->m_free = nullptr;
+            this->m_bump = 0UL;
+            this->m_used = 0UL;
+        }
+
+    private:
+        // A slot: node storage while in use, a free-list link otherwise
+        union Slot
+        {
+            Slot *m_next;
+            alignas(Node) std::byte m_storage[sizeof(Node)];
+        };
+
+    private:
+        Slot m_slots[Capacity];   // The inline node slots
+        Slot *m_free{nullptr};    // Recycled slots
+        size_type m_bump{0UL};    // Slots [m_bump, Capacity) have never been handed out
+        size_type m_used{0UL};    // Slots currently handed out
+    };
+
+    /**
+    * @brief Without inline slots every node comes from the allocator; the buffer takes no space.
+    */
+    template <class Node>
+    struct small_buffer<Node, 0UL> final
+    {
+    public:
+        using size_type = std::size_t;
+
+    public:
+        [[nodiscard]] constexpr auto allocate() noexcept -> Node * { return nullptr; }
+
+        constexpr void deallocate(Node *) noexcept {}
+
+        [[nodiscard]] constexpr auto owns(const Node *) const noexcept -> bool { return false; }
+
+        [[nodiscard]] constexpr auto in_use() const noexcept -> size_type { return 0UL; }
+
+        constexpr void reset() noexcept {}
+    };
+}
+
+#endif
@@ -1,16 +1,31 @@
 #ifndef __STACK_HXX__
 #define __STACK_HXX__
 
+#include <concepts>
+#include <functional>
+#include <memory>
 #include <ranges>
 #include <utility>
 
+#include "container_stats.h"
+#include "details.h"
+#include "small_buffer.h"
+
 
 
 /**
 * @brief A stack data structure implemented using a singly linked list.
+* @details With InlineCapacity > 0 the first nodes live in a buffer inside the stack object
+*          and only the overflow goes to the allocator: a stack that never holds more than
+*          InlineCapacity elements never allocates. Moving such a stack moves its inline
+*          elements one by one, hence the nothrow-move requirement on Type.
 * @tparam Type The type of elements stored in the stack.
+* @tparam Allocator The allocator used for the nodes, rebound to the node type.
+* @tparam InlineCapacity The number of nodes kept inside the stack object.
+* @tparam Stats Whether the stack counts its work for stats() (no_stats or operation_stats).
 */
-template <class Type>
+template <class Type, class Allocator = std::allocator<Type>, std::size_t InlineCapacity = 0UL, class Stats = no_stats>
+    requires((InlineCapacity == 0UL) || std::is_nothrow_move_constructible_v<Type>)
 struct stack final
 {
 
@@ -20,12 +35,13 @@ private:
 
 private:
     // Type aliases for allocator and allocator traits
-    using allocator_type = std::allocator<Node>;
-    using traits         = std::allocator_traits<allocator_type>;
+    using allocator_t = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using traits      = std::allocator_traits<allocator_t>;
 
 public:
     // Type aliases for readability and standard conformance
-    using value_type = Type;
+    using value_type     = Type;
+    using allocator_type = Allocator;
 
     using reference       = Type &;
     using const_reference = const Type &;
@@ -44,15 +60,23 @@ public:
     */
     constexpr stack() noexcept = default;
 
+    /**
+    * @brief Constructs an empty stack using the given allocator.
+    * @param alloc The allocator used for all node allocations.
+    */
+    explicit constexpr stack(const Allocator &alloc) noexcept
+        : m_alloc{alloc}
+    {
+    }
+
     /**
     * @brief Move constructor for stack.
     * @param outer The stack to be moved from.
     */
-    constexpr stack(stack &&outer) noexcept(std::is_nothrow_move_constructible_v<allocator_type>)
+    constexpr stack(stack &&outer) noexcept(std::is_nothrow_move_constructible_v<allocator_t>)
         : m_alloc{std::move(outer.m_alloc)}
     {
-        this->m_head = std::exchange(outer.m_head, nullptr);
-        this->m_size = std::exchange(outer.m_size, 0UL);
+        this->__M_steal(outer);
     }
 
     /**
@@ -60,7 +84,7 @@ public:
     * @param outer The stack to be copied from.
     */
     constexpr stack(const stack &outer)
-        : m_alloc{traits::select_on_copy_construction(outer.m_alloc)}
+        : m_alloc{traits::select_on_container_copy_construction(outer.m_alloc)}
     {
         this->m_head = this->__M_clone(outer.m_head);
         this->m_size = outer.m_size;
@@ -72,15 +96,16 @@ public:
     * @tparam Sentinel The type of sentinel.
     * @param begin The beginning iterator of the range.
     * @param end The ending sentinel of the range.
+    * @param alloc The allocator used for all node allocations.
     */
     template <typename Iterator, typename Sentinel>
         requires std::conjunction<
             std::bool_constant<std::input_iterator<Iterator>>,
             std::bool_constant<std::sentinel_for<Sentinel, Iterator>>,
-            std::bool_constant<std::constructible_from<Type, std::iter_value_t<Iterator>>
+            std::bool_constant<std::constructible_from<Type, std::iter_value_t<Iterator>>>
         >::value
-    constexpr stack(Iterator begin, Sentinel end)
-        : stack{}
+    constexpr stack(Iterator begin, Sentinel end, const Allocator &alloc = Allocator())
+        : stack(alloc)
     {
         while (begin != end)
         {
@@ -92,9 +117,10 @@ public:
     /**
     * @brief Initializer list constructor.
     * @param list The initializer list of elements.
+    * @param alloc The allocator used for all node allocations.
     */
-    constexpr stack(std::initializer_list<Type> list)
-        : stack{std::ranges::begin(list), std::ranges::end(list)}
+    constexpr stack(std::initializer_list<Type> list, const Allocator &alloc = Allocator())
+        : stack(std::ranges::begin(list), std::ranges::end(list), alloc)
     {
     }
 
@@ -103,14 +129,15 @@ public:
     * @tparam range_t The type of range.
     * @param from_range_t A tag type to identify the range constructor.
     * @param range The range of elements.
+    * @param alloc The allocator used for all node allocations.
     */
     template <typename range_t>
         requires std::conjunction<
             std::bool_constant<std::ranges::range<range_t>>,
-            std::bool_constant<std::constructible_from<Type, std::ranges::range_value_t<range_t>>
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_value_t<range_t>>>
         >::value
-    constexpr stack(std::from_range_t, range_t &&range)
-        : stack{std::ranges::begin(range), std::ranges::end(range)}
+    constexpr stack(details::from_range_t, range_t &&range, const Allocator &alloc = Allocator())
+        : stack(std::ranges::begin(range), std::ranges::end(range), alloc)
     {
     }
 
@@ -183,6 +210,29 @@ public:
         this->m_size = this->m_size + 1UL;
     }
 
+    /**
+    * @brief Push every element of a range, in order: the last one ends up on top.
+    * @details When the allocator is monotonic and the size of the range is known, the
+    *          nodes of the whole batch come from a single allocation.
+    * @tparam range_t The type of the range.
+    * @param range The range of elements to be pushed.
+    */
+    template <typename range_t>
+        requires std::conjunction<
+            std::bool_constant<std::ranges::input_range<range_t>>,
+            std::bool_constant<std::constructible_from<Type, std::ranges::range_reference_t<range_t>>>
+        >::value
+    constexpr void push_range(range_t &&range)
+    {
+        auto batch = this->__M_reserve_batch(details::size_hint(range));
+
+        for (auto &&data : range)
+        {
+            this->m_head = this->__M_create_batched(batch, std::forward<decltype(data)>(data), this->m_head);
+            this->m_size = this->m_size + 1UL;
+        }
+    }
+
 public:
     /**
     * @brief Pop the top element from the stack.
@@ -193,18 +243,69 @@ public:
         {
             this->m_head = this->m_head->m_next;
 
-            traits::destroy(this->m_alloc, std::to_address(target));
-            traits::deallocate(this->m_alloc, std::to_address(target), 1UL);
+            this->__M_destroy_node(target);
 
             this->m_size = this->m_size - 1UL;
         }
     }
 
+    /**
+    * @brief Pop up to `count` elements, moving each one to `out`, top first.
+    * @details The popped nodes are detached as one chain once every element is moved out,
+    *          then destroyed in a single pass; with a monotonic allocator and a trivially
+    *          destructible Type the chain is simply dropped.
+    * @tparam _iterator The type of the output iterator.
+    * @param out The destination of the popped elements.
+    * @param count The maximum number of elements to pop.
+    * @return _iterator The output iterator past the last element written.
+    */
+    template <typename _iterator> requires std::output_iterator<_iterator, Type &&>
+    constexpr auto pop_n(_iterator out, size_type count) -> _iterator
+    {
+        count = (count < this->m_size) ? count : this->m_size;
+
+        if (count == 0UL)
+            return out;
+
+        auto last = this->m_head;
+
+        for (auto remaining = count;; last = last->m_next)
+        {
+            *out = std::move(last->m_data);
+            ++out;
+
+            if (--remaining == 0UL)
+                break;
+        }
+
+        auto first = std::exchange(this->m_head, last->m_next);
+
+        last->m_next = nullptr;
+        this->m_size = this->m_size - count;
+
+        if constexpr (not (details::trivially_releasable<allocator_t, Type> && (InlineCapacity == 0UL)))
+        {
+            while (first != nullptr)
+                this->__M_destroy_node(std::exchange(first, first->m_next));
+        }
+        return out;
+    }
+
     /**
     * @brief Clear all elements from the stack.
+    * @details With a monotonic allocator and a trivially destructible Type the nodes
+    *          are dropped in O(1); their memory is reclaimed when the arena is released.
     */
     constexpr void clear()
     {
+        if constexpr (details::trivially_releasable<allocator_t, Type>)
+        {
+            this->m_head = nullptr;
+            this->m_size = 0UL;
+            this->m_buffer.reset();
+            return;
+        }
+
         while (this->m_head != nullptr)
             this->pop();
     }
@@ -215,7 +316,7 @@ public:
     * @return Optional containing the top element if the stack is not empty, otherwise std::nullopt.
     */
     [[nodiscard]]
-    constexpr auto top() const noexcept -> std::optional<const std::reference_type<Type>>
+    constexpr auto top() const noexcept -> std::optional<std::reference_wrapper<const Type>>
     {
         if (this->m_head == nullptr) {
             return std::nullopt;
@@ -228,7 +329,7 @@ public:
     * @return Optional containing the top element if the stack is not empty, otherwise std::nullopt.
     */
     [[nodiscard]]
-    constexpr auto top() noexcept -> std::optional<std::reference_type<Type>>
+    constexpr auto top() noexcept -> std::optional<std::reference_wrapper<Type>>
     {
         if (this->m_head == nullptr) {
             return std::nullopt;
@@ -236,6 +337,21 @@ public:
         return std::optional{std::ref(this->m_head->m_data)};
     }
 
+    /**
+    * @brief Visits every element, from the top down.
+    * @param visitor The callable invoked with each element.
+    */
+    template <class Visitor>
+        requires std::invocable<Visitor &, const Type &>
+    constexpr void for_each(Visitor visitor) const
+    {
+        for (auto current = this->m_head; current != nullptr; current = current->m_next)
+        {
+            details::prefetch(current->m_next);
+            std::invoke(visitor, std::as_const(current->m_data));
+        }
+    }
+
 public:
     /**
     * @brief Check if the stack is empty.
@@ -252,6 +368,36 @@ public:
     */
     [[nodiscard]] constexpr auto size() const noexcept -> size_type { return this->m_size; }
 
+    /**
+    * @brief Get a copy of the allocator associated with the stack.
+    * @return The allocator, rebound back to the value type.
+    */
+    [[nodiscard]] constexpr auto get_allocator() const noexcept -> allocator_type
+    {
+        return allocator_type(this->m_alloc);
+    }
+
+    /**
+    * @brief Get the work counted since construction or the last reset_stats().
+    * @details Allocations count only the nodes that overflow the inline buffer; elements
+    *          assignment writes over existing nodes count as reuses.
+    * @return The counters, with the bytes of the heap nodes currently held.
+    */
+    [[nodiscard]] auto stats() const noexcept -> container_stats
+        requires details::stats_recorder<Stats>::enabled
+    {
+        return this->m_stats.snapshot((this->m_size - this->m_buffer.in_use()) * sizeof(Node));
+    }
+
+    /**
+    * @brief Zero the counters behind stats().
+    */
+    void reset_stats() noexcept
+        requires details::stats_recorder<Stats>::enabled
+    {
+        this->m_stats.reset();
+    }
+
 public:
     /**
     * @brief Swap the contents of two stacks.
@@ -266,8 +412,17 @@ public:
             std::swap(lhs.m_alloc, rhs.m_alloc);
         }
 
-        std::swap(lhs.m_head, rhs.m_head);
-        std::swap(lhs.m_size, rhs.m_size);
+        if constexpr (InlineCapacity == 0UL) {
+            std::swap(lhs.m_head, rhs.m_head);
+            std::swap(lhs.m_size, rhs.m_size);
+        }
+        else {
+            stack temp{allocator_type(lhs.m_alloc)};
+
+            temp.__M_steal(lhs);
+            lhs.__M_steal(rhs);
+            rhs.__M_steal(temp);
+        }
     }
 
 public:
@@ -286,18 +441,131 @@ private:
     template <class... ARGS>
     constexpr Node *__M_create_node(ARGS &&...args)
     {
-        auto node = traits::allocate(this->m_alloc, 1UL);
+        auto node = this->__M_allocate_node();
 
         try {
             traits::construct(this->m_alloc, std::to_address(node), std::forward<ARGS>(args)...);
         }
         catch (...) {
-            traits::deallocate(this->m_alloc, std::to_address(node), 1UL);
+            this->__M_deallocate_node(node);
             throw;
         }
         return node;
     }
 
+    /**
+    * @brief Helper method to reserve one block for the nodes of a batch.
+    * @details Only monotonic allocators qualify, and only without inline storage, which
+    *          the batch would otherwise bypass.
+    * @param count The number of nodes in the batch, 0 when unknown.
+    * @return The reserved batch, empty when nodes are to be allocated one by one.
+    */
+    constexpr auto __M_reserve_batch(size_type count) -> details::node_batch<Node>
+    {
+        if constexpr (details::monotonic_allocator<allocator_t> && (InlineCapacity == 0UL))
+        {
+            if (count > 1UL)
+            {
+                auto block = std::to_address(traits::allocate(this->m_alloc, count));
+                this->m_stats.allocated();
+                return {block, block + count};
+            }
+        }
+        return {};
+    }
+
+    /**
+    * @brief Helper method to create a node in the next slot of a batch, or on its own.
+    * @details A slot whose construction throws stays unused; the arena reclaims it.
+    * @param batch The batch to take the node storage from.
+    * @param args The arguments for constructing the node.
+    * @return Pointer to the newly created node.
+    */
+    template <class... ARGS>
+    constexpr Node *__M_create_batched(details::node_batch<Node> &batch, ARGS &&...args)
+    {
+        if (auto node = batch.take())
+        {
+            traits::construct(this->m_alloc, node, std::forward<ARGS>(args)...);
+            return node;
+        }
+        return this->__M_create_node(std::forward<ARGS>(args)...);
+    }
+
+    /**
+    * @brief Helper method to obtain storage for one node, from the inline buffer while it lasts.
+    * @return Pointer to uninitialized node storage.
+    */
+    constexpr Node *__M_allocate_node()
+    {
+        if (auto node = this->m_buffer.allocate()) {
+            return node;
+        }
+        auto node = std::to_address(traits::allocate(this->m_alloc, 1UL));
+        this->m_stats.allocated();
+        return node;
+    }
+
+    /**
+    * @brief Helper method to give node storage back to where it came from.
+    * @param node The storage of an already destroyed node.
+    */
+    constexpr void __M_deallocate_node(Node *node) noexcept
+    {
+        if (this->m_buffer.owns(node)) {
+            this->m_buffer.deallocate(node);
+        }
+        else {
+            traits::deallocate(this->m_alloc, node, 1UL);
+            this->m_stats.deallocated();
+        }
+    }
+
+    /**
+    * @brief Helper method to destroy a node and release its storage.
+    * @param node The node to be destroyed.
+    */
+    constexpr void __M_destroy_node(Node *node) noexcept
+    {
+        traits::destroy(this->m_alloc, std::to_address(node));
+        this->__M_deallocate_node(node);
+    }
+
+    /**
+    * @brief Helper method taking over the elements of `outer`, leaving it empty.
+    * @details Heap nodes change hands as they are; nodes in the inline buffer of `outer`
+    *          are moved into the (empty) buffer of this stack, which always has room for them.
+    * @param outer The stack to take the elements from.
+    */
+    constexpr void __M_steal(stack &outer) noexcept
+    {
+        this->m_head = std::exchange(outer.m_head, nullptr);
+        this->m_size = std::exchange(outer.m_size, 0UL);
+
+        if constexpr (InlineCapacity != 0UL)
+        {
+            Node **link = std::addressof(this->m_head);
+
+            for (auto remaining = outer.m_buffer.in_use(); remaining != 0UL; link = std::addressof((*link)->m_next))
+            {
+                auto node = *link;
+
+                if (not outer.m_buffer.owns(node))
+                    continue;
+
+                auto slot = this->m_buffer.allocate();
+
+                traits::construct(this->m_alloc, slot, std::move(node->m_data), node->m_next);
+                *link = slot;
+
+                traits::destroy(outer.m_alloc, node);
+                outer.m_buffer.deallocate(node);
+
+                remaining = remaining - 1UL;
+            }
+        }
+    }
+
     /**
     * @brief Helper method to clone a node and its subsequent nodes.
     * @param source The source node to be cloned.
@@ -319,6 +587,8 @@ private:
 
         while (source != nullptr)
         {
+            details::prefetch(source->m_next);
+
             node = this->__M_create_node(source->m_data);
 
             cursor->m_next = node;
@@ -355,6 +625,7 @@ private:
         for (auto count = std::min(this->m_size, size); count; count--)
         {
             cursor->m_data = source->m_data;
+            this->m_stats.reused();
 
             temp   = cursor;
             cursor = cursor->m_next;
@@ -369,8 +640,7 @@ private:
             {
                 temp = cursor;
                 cursor = cursor->m_next;
-                traits::destroy(this->m_alloc, std::to_address(temp));
-                traits::deallocate(this->m_alloc, std::to_address(temp), 1UL);
+                this->__M_destroy_node(temp);
             }
             return;
         }
@@ -426,9 +696,12 @@ private:
     constexpr void __M_move_assign(stack &outer, std::true_type)
     {
         this->clear();
-        this->m_alloc = std::move(outer.m_alloc);
-        this->m_head = std::exchange(outer.m_head, nullptr);
-        this->m_size = std::exchange(outer.m_size, 0L);
+
+        // Equal but non-propagating allocators (std::pmr) are kept: they cannot be assigned
+        if constexpr (typename traits::propagate_on_container_move_assignment{})
+            this->m_alloc = std::move(outer.m_alloc);
+
+        this->__M_steal(outer);
     }
 
     /**
@@ -444,8 +717,25 @@ private:
         }
         else
         {
-            this->m_head = std::exchange(outer.m_head, nullptr);
-            this->m_size = std::exchange(outer.m_size, 0L);
+            // The nodes of `outer` must go back to its own allocator: move the elements
+            this->clear();
+
+            Node *tail = nullptr;
+
+            for (auto source = outer.m_head; source != nullptr; source = source->m_next)
+            {
+                auto node = this->__M_create_node(std::move(source->m_data));
+
+                if (tail != nullptr)
+                    tail->m_next = node;
+                else
+                    this->m_head = node;
+
+                tail = node;
+                this->m_size = this->m_size + 1UL;
+            }
+
+            outer.clear();
         }
     }
 
@@ -457,7 +747,13 @@ private:
     std::size_t m_size{0UL};
 
     //  The allocator object
-    [[no_unique_address]] allocator_type m_alloc{};
+    [[no_unique_address]] allocator_t m_alloc{};
+
+    //  Inline storage for the first InlineCapacity nodes
+    [[no_unique_address]] details::small_buffer<Node, InlineCapacity> m_buffer{};
+
+    //  The counters behind stats()
+    [[no_unique_address]] details::stats_recorder<Stats> m_stats{};
 };
 
 
@@ -468,7 +764,7 @@ private:
 * @tparam range_t Type of the range.
 */
 template <typename range_t>
-stack(std::from_range_t, range_t &&) -> stack<std::ranges::range_value_t<range_t>>;
+stack(details::from_range_t, range_t &&) -> stack<std::ranges::range_value_t<range_t>>;
 
 /**
 * @brief Deduction guide for stack from iterators and sentinels.
@@ -485,9 +781,11 @@ stack(iterator, sentinel) -> stack<std::iter_value_t<iterator>>;
 /**
 * @brief Nested struct representing a node in the stack.
 * @tparam Type The type of elements stored in the node.
+* @tparam Allocator The allocator type of the owning stack.
 */
-template <class Type>
-struct stack<Type>::Node final
+template <class Type, class Allocator, std::size_t InlineCapacity, class Stats>
+    requires((InlineCapacity == 0UL) || std::is_nothrow_move_constructible_v<Type>)
+struct stack<Type, Allocator, InlineCapacity, Stats>::Node final
 {
 
 public: